@@ -0,0 +1,242 @@
+/**
+ * @file        amp.c
+ * @author      Danius Kalvaitis (danius.kalvaitis@gmail.com)
+ * @brief       TPA3220 amplifier control and fault supervisor.
+ * @version     0.1
+ * @date        2026-10-17
+ *
+ * @copyright   Copyright (c) Danius Kalvaitis 2026 All rights reserved
+ *
+ */
+
+#include "amp.h"
+
+#include "app_scheduler.h"
+#include "app_timer.h"
+#include "boards.h"
+#include "nrf_gpio.h"
+#include "nrfx_gpiote.h"
+#include "sdk_common.h"
+
+#define NRF_LOG_MODULE_NAME amp
+#include "nrf_log.h"
+NRF_LOG_MODULE_REGISTER();
+
+APP_TIMER_DEF(m_recovery_timer);
+
+/*
+ * TPA3220 datasheet, "Device Reset" and "Power-Up Sequence": a RESET low pulse clears latched faults, the required
+ * pulse is far below the 1 ms resolution used here. After RESET is released the device ramps its outputs and a fault
+ * that is still present latches FAULT low again, so FAULT is polled until it has stayed high for a full ramp instead
+ * of being sampled once after a fixed delay.
+ */
+#define AMP_RESET_PULSE_TICKS    APP_TIMER_TICKS(1)   /**< RESET held low to clear a latched fault. */
+#define AMP_STARTUP_POLL_TICKS   APP_TIMER_TICKS(10)  /**< FAULT poll interval after RESET release. */
+#define AMP_STARTUP_STABLE_POLLS 5                    /**< FAULT high for this many polls in a row means started. */
+#define AMP_STARTUP_POLLS_MAX    20                   /**< Give up on this reset after 200 ms. */
+#define AMP_RETRY_TICKS          APP_TIMER_TICKS(500) /**< Wait before another reset if the fault did not clear. */
+#define AMP_RECOVERY_RETRIES_MAX 5
+
+typedef enum
+{
+    AMP_STATE_RUNNING,
+    AMP_STATE_RESET,    /**< RESET pin is held low. */
+    AMP_STATE_STARTING, /**< RESET released, waiting for the amplifier to start. */
+    AMP_STATE_WAITING,  /**< Fault did not clear, waiting before the next reset. */
+    AMP_STATE_FAILED
+} amp_state_t;
+
+static amp_evt_handler_t m_evt_handler = NULL;
+static amp_state_t       m_state;
+static bool              m_mute_requested;
+static uint8_t           m_retries;
+static uint8_t           m_startup_polls;
+static uint8_t           m_startup_stable_polls;
+static uint32_t          m_fault_start; /**< RTC counter value when the fault was detected. */
+static uint32_t          m_fault_count;
+static uint32_t          m_recovery_ms_max;
+
+static void amp_evt_send(amp_evt_type_t type)
+{
+    amp_evt_t evt = {.type = type};
+
+    m_evt_handler(&evt);
+}
+
+static void amp_mute_pin_set(bool mute)
+{
+    if (mute)
+    {
+        nrf_gpio_pin_clear(DK_BSP_TPA3220_MUTE);
+    } else
+    {
+        nrf_gpio_pin_set(DK_BSP_TPA3220_MUTE);
+    }
+}
+
+static bool amp_fault_active(void) { return nrf_gpio_pin_read(DK_BSP_TPA3220_FAULT) == 0; }
+
+static uint32_t amp_fault_elapsed_ms(void)
+{
+    uint32_t ticks = app_timer_cnt_diff_compute(app_timer_cnt_get(), m_fault_start);
+
+    return (uint32_t)(((uint64_t)ticks * 1000) / APP_TIMER_CLOCK_FREQ);
+}
+
+static void amp_timer_start(amp_state_t state, uint32_t ticks)
+{
+    ret_code_t err_code = app_timer_start(m_recovery_timer, ticks, NULL);
+
+    if (err_code != NRF_SUCCESS)
+    {
+        NRF_LOG_ERROR("Could not start amplifier recovery timer %u", err_code);
+        m_state = AMP_STATE_FAILED;
+        amp_evt_send(AMP_EVT_TYPE_RECOVERY_FAILED);
+        return;
+    }
+
+    m_state = state;
+}
+
+static void amp_reset_start(void)
+{
+    nrf_gpio_pin_clear(DK_BSP_TPA3220_RST);
+    amp_timer_start(AMP_STATE_RESET, AMP_RESET_PULSE_TICKS);
+}
+
+static void amp_recovery_timer_handler(void *p_context)
+{
+    uint32_t recovery_ms;
+
+    switch (m_state)
+    {
+        case AMP_STATE_RESET:
+            nrf_gpio_pin_set(DK_BSP_TPA3220_RST);
+            m_startup_polls        = 0;
+            m_startup_stable_polls = 0;
+            amp_timer_start(AMP_STATE_STARTING, AMP_STARTUP_POLL_TICKS);
+            break;
+        case AMP_STATE_STARTING:
+            m_startup_polls++;
+            m_startup_stable_polls = amp_fault_active() ? 0 : (m_startup_stable_polls + 1);
+
+            if ((m_startup_stable_polls < AMP_STARTUP_STABLE_POLLS) && (m_startup_polls < AMP_STARTUP_POLLS_MAX))
+            {
+                amp_timer_start(AMP_STATE_STARTING, AMP_STARTUP_POLL_TICKS);
+            } else if (m_startup_stable_polls >= AMP_STARTUP_STABLE_POLLS)
+            {
+                recovery_ms       = amp_fault_elapsed_ms();
+                m_recovery_ms_max = MAX(m_recovery_ms_max, recovery_ms);
+                m_state           = AMP_STATE_RUNNING;
+
+                NRF_LOG_INFO("Amplifier recovered in %u ms", recovery_ms);
+
+                amp_mute_pin_set(m_mute_requested);
+
+                amp_evt_t evt = {.type = AMP_EVT_TYPE_RECOVERED, .params.recovery_ms = recovery_ms};
+                m_evt_handler(&evt);
+            } else if (m_retries < AMP_RECOVERY_RETRIES_MAX)
+            {
+                m_retries++;
+                amp_timer_start(AMP_STATE_WAITING, AMP_RETRY_TICKS);
+            } else
+            {
+                NRF_LOG_ERROR("Amplifier fault did not clear");
+                nrf_gpio_pin_clear(DK_BSP_TPA3220_RST);
+                m_state = AMP_STATE_FAILED;
+                amp_evt_send(AMP_EVT_TYPE_RECOVERY_FAILED);
+            }
+            break;
+        case AMP_STATE_WAITING:
+            amp_reset_start();
+            break;
+        default:
+            break;
+    }
+}
+
+static void amp_fault_sched_handler(void *p_event_data, uint16_t event_size)
+{
+    if ((m_state != AMP_STATE_RUNNING) || !amp_fault_active())
+    {
+        return;
+    }
+
+    m_fault_count++;
+    m_fault_start = app_timer_cnt_get();
+    m_retries     = 0;
+
+    NRF_LOG_WARNING("Amplifier fault %u", m_fault_count);
+
+    amp_mute_pin_set(true);
+    amp_reset_start();
+    amp_evt_send(AMP_EVT_TYPE_FAULT);
+}
+
+static void amp_fault_pin_handler(nrfx_gpiote_pin_t pin, nrf_gpiote_polarity_t action)
+{
+    UNUSED_RETURN_VALUE(app_sched_event_put(NULL, 0, amp_fault_sched_handler));
+}
+
+static void amp_otw_clip_pin_handler(nrfx_gpiote_pin_t pin, nrf_gpiote_polarity_t action)
+{
+    amp_evt_t evt = {.type = AMP_EVT_TYPE_CLIP, .params.clipping = (nrf_gpio_pin_read(pin) == 0)}; // Active low
+
+    m_evt_handler(&evt);
+}
+
+ret_code_t amp_init(amp_evt_handler_t evt_handler)
+{
+    ret_code_t              err_code;
+    nrfx_gpiote_in_config_t fault_config    = NRFX_GPIOTE_CONFIG_IN_SENSE_HITOLO(false);
+    nrfx_gpiote_in_config_t otw_clip_config = NRFX_GPIOTE_CONFIG_IN_SENSE_TOGGLE(false);
+
+    VERIFY_PARAM_NOT_NULL(evt_handler);
+
+    m_evt_handler    = evt_handler;
+    m_state          = AMP_STATE_RUNNING;
+    m_mute_requested = true;
+
+    nrf_gpio_cfg_output(DK_BSP_TPA3220_RST);
+    nrf_gpio_pin_clear(DK_BSP_TPA3220_RST);
+    nrf_gpio_cfg(DK_BSP_TPA3220_MUTE,
+                 NRF_GPIO_PIN_DIR_OUTPUT,
+                 NRF_GPIO_PIN_INPUT_DISCONNECT,
+                 NRF_GPIO_PIN_NOPULL,
+                 NRF_GPIO_PIN_S0D1,
+                 NRF_GPIO_PIN_NOSENSE);
+    amp_mute_pin_set(true);
+    nrf_gpio_cfg_output(DK_BSP_TPA3220_HEAD);
+    nrf_gpio_pin_clear(DK_BSP_TPA3220_HEAD);
+
+    err_code = app_timer_create(&m_recovery_timer, APP_TIMER_MODE_SINGLE_SHOT, amp_recovery_timer_handler);
+    VERIFY_SUCCESS(err_code);
+
+    err_code = nrfx_gpiote_in_init(DK_BSP_TPA3220_FAULT, &fault_config, amp_fault_pin_handler);
+    VERIFY_SUCCESS(err_code);
+
+    err_code = nrfx_gpiote_in_init(DK_BSP_TPA3220_OTW_CLIP, &otw_clip_config, amp_otw_clip_pin_handler);
+    VERIFY_SUCCESS(err_code);
+
+    nrf_gpio_pin_set(DK_BSP_TPA3220_RST);
+
+    nrfx_gpiote_in_event_enable(DK_BSP_TPA3220_FAULT, true);
+    nrfx_gpiote_in_event_enable(DK_BSP_TPA3220_OTW_CLIP, true);
+
+    return NRF_SUCCESS;
+}
+
+void amp_mute(bool mute)
+{
+    m_mute_requested = mute;
+
+    if (m_state == AMP_STATE_RUNNING)
+    {
+        amp_mute_pin_set(mute);
+    }
+}
+
+void amp_debug(void)
+{
+    NRF_LOG_INFO("Amplifier faults %u, max recovery %u ms", m_fault_count, m_recovery_ms_max);
+}
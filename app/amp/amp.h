@@ -0,0 +1,57 @@
+/**
+ * @file        amp.h
+ * @author      Danius Kalvaitis (danius.kalvaitis@gmail.com)
+ * @brief       TPA3220 amplifier control and fault supervisor.
+ * @version     0.1
+ * @date        2026-10-17
+ *
+ * @copyright   Copyright (c) Danius Kalvaitis 2026 All rights reserved
+ *
+ */
+
+#ifndef AMP_H
+#define AMP_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "sdk_errors.h"
+
+typedef enum
+{
+    AMP_EVT_TYPE_CLIP,            /**< OTW/CLIP pin changed. Raised from interrupt context. */
+    AMP_EVT_TYPE_FAULT,           /**< Amplifier latched a fault, recovery has started. */
+    AMP_EVT_TYPE_RECOVERED,       /**< Amplifier is running again after a fault. */
+    AMP_EVT_TYPE_RECOVERY_FAILED  /**< Fault did not clear, amplifier stays in reset. */
+} amp_evt_type_t;
+
+typedef struct
+{
+    amp_evt_type_t type;
+    union
+    {
+        bool     clipping;    /**< @ref AMP_EVT_TYPE_CLIP. */
+        uint32_t recovery_ms; /**< @ref AMP_EVT_TYPE_RECOVERED. */
+    } params;
+} amp_evt_t;
+
+typedef void (*amp_evt_handler_t)(amp_evt_t const *p_evt);
+
+/**
+ * @brief Configure amplifier pins, release it from reset and start watching FAULT and OTW/CLIP pins.
+ *
+ * GPIOTE driver, app timer and scheduler have to be initialized before.
+ */
+ret_code_t amp_init(amp_evt_handler_t evt_handler);
+
+/**
+ * @brief Mute or unmute amplifier. Amplifier stays muted while recovering from a fault.
+ */
+void amp_mute(bool mute);
+
+/**
+ * @brief Log fault statistics.
+ */
+void amp_debug(void);
+
+#endif // AMP_H
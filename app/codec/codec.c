@@ -11,20 +11,66 @@
 
 #include "codec.h"
 
+#include "app_scheduler.h"
 #include "app_timer.h"
 #include "boards.h"
 #include "codec_buffer.h"
+#include "codec_convert.h"
+#include "codec_dsp.h"
+#include "codec_eq.h"
 #include "codec_hal.h"
-#include "nrf_delay.h"
+#include "codec_limiter.h"
+#include "codec_ramp.h"
+#include "codec_resampler.h"
+#include "nrf_section.h"
 #include "nrfx_i2s.h"
+#include "profile.h"
+#include "ram_power.h"
+#include "telemetry.h"
 
 #define NRF_LOG_MODULE_NAME codec
 #include "nrf_log.h"
 #include "nrf_log_ctrl.h"
 NRF_LOG_MODULE_REGISTER();
 
+#include "codec_rt.h" // Must stay the last include, poisons blocking calls
+
 #define CODEC_DEBUG_INTERVAL APP_TIMER_TICKS(1000)
 
+/**
+ * @brief Compensate USB and I2S clock drift by steering the host with the USB asynchronous feedback endpoint
+ */
+#ifndef CODEC_FEEDBACK_ENABLED
+#if defined(CODEC_RESAMPLER_ENABLED) && CODEC_RESAMPLER_ENABLED
+#define CODEC_FEEDBACK_ENABLED 0
+#else
+#define CODEC_FEEDBACK_ENABLED 1
+#endif
+#endif
+
+/**
+ * @brief Compensate USB and I2S clock drift by resampling received data, for hosts that ignore the feedback
+ */
+#ifndef CODEC_RESAMPLER_ENABLED
+#define CODEC_RESAMPLER_ENABLED (!CODEC_FEEDBACK_ENABLED)
+#endif
+
+// Both would integrate the same fill level error and fight over it
+#if CODEC_FEEDBACK_ENABLED && CODEC_RESAMPLER_ENABLED
+#error "Enable either the USB feedback or the resampler, not both"
+#endif
+
+#define CODEC_FRAME_SIZE              CODEC_CONVERT_FRAME_SIZE
+#define CODEC_RESAMPLER_TARGET_FRAMES CODEC_BUFFER_FILL_TARGET_FRAMES /**< Same level the USB feedback would hold. */
+
+#if CODEC_RESAMPLER_ENABLED
+STATIC_ASSERT((CODEC_RESAMPLER_IN_FRAMES_MAX * CODEC_CONVERT_FRAME_SIZE_MAX) + CODEC_FRAME_SIZE <=
+                  CODEC_BUFFER_RX_SIZE_MAX,
+              "Codec buffer can not fit resampled USB packet");
+#endif
+
+NRF_SECTION_DEF(codec_ring, uint32_t); // Codec ring placed by the linker in its own RAM section
+
 // static int16_t warmup_data[32] = { 0 };
 
 // static int16_t test_data[2][64] =
@@ -164,12 +210,69 @@ NRF_LOG_MODULE_REGISTER();
 
 // };
 
-static codec_event_handler_t m_event_handler = NULL;
-static bool                  m_streaming_audio;
-static bool                  m_i2s_warmup = false;
+static codec_event_handler_t  m_event_handler = NULL;
+static bool                   m_streaming_audio;
+static bool                   m_i2s_warmup = false;
+static uint32_t              *mp_rx_buffer = NULL;
+static bool                   m_muted;
+static bool                   m_output_hold;
+static codec_mode_t           m_pending_mode = CODEC_MODE_OFF; /**< Mode to switch to once the fade out finishes. */
+static codec_format_t         m_format       = CODEC_FORMAT_S16_STEREO; /**< Format of the next USB stream. */
+static codec_convert_t const *mp_convert     = NULL; /**< Converter of the running stream, NULL between streams. */
+static uint32_t               m_sample_rate  = CODEC_SAMPLE_RATE_DEFAULT;
+static volatile bool          m_ring_powered = true; /**< RX buffers are only handed out while the ring has power. */
+
+static bool codec_fade_in_allowed(void) { return !m_muted && !m_output_hold && (m_pending_mode == CODEC_MODE_OFF); }
+
+/**
+ * @brief Assert hardware mute or switch codec mode once audio has faded out.
+ */
+static void codec_ramp_done_handler(void *p_event_data, uint16_t event_size)
+{
+    ret_code_t   err_code;
+    codec_mode_t mode = m_pending_mode;
+
+    if (!codec_ramp_is_silent())
+    {
+        return;
+    }
+
+    if (m_muted)
+    {
+        err_code = codec_hal_mute(true);
+
+        if (err_code != NRF_SUCCESS)
+        {
+            NRF_LOG_ERROR("Could not mute codec %u", err_code);
+        }
+    }
+
+    if (mode != CODEC_MODE_OFF)
+    {
+        m_pending_mode = CODEC_MODE_OFF;
+
+        err_code = codec_hal_mode_set(mode);
+
+        if (err_code != NRF_SUCCESS)
+        {
+            NRF_LOG_ERROR("Could not set codec mode %u", err_code);
+        }
+    }
+}
+
+static void codec_tx_block_process(uint32_t *p_block)
+{
+    if (codec_ramp_process(p_block, CODEC_BUFFER_SIZE_WORDS))
+    {
+        UNUSED_RETURN_VALUE(app_sched_event_put(NULL, 0, codec_ramp_done_handler));
+    }
+}
 
 static void i2s_data_handler(nrfx_i2s_buffers_t const *p_released, uint32_t status)
 {
+    uint32_t start = profile_timestamp();
+
+    PROFILE_SCOPE(PROFILE_PROBE_I2S_HANDLER);
     VERIFY_PARAM_NOT_NULL_VOID(p_released);
     ret_code_t err_code;
 
@@ -187,7 +290,12 @@ static void i2s_data_handler(nrfx_i2s_buffers_t const *p_released, uint32_t stat
             {
                 m_event_handler(CODEC_EVT_TYPE_AUDIO_STREAM_STOPPED);
             }
+            telemetry_trace(TELEMETRY_TRACE_STREAM_STOP, 0);
             codec_buffer_reset();
+            codec_resampler_reset();
+            codec_limiter_reset();
+            codec_ramp_reset(true);
+            UNUSED_RETURN_VALUE(app_sched_event_put(NULL, 0, codec_ramp_done_handler)); // Finish pending mute or mode
         }
 
         m_streaming_audio = false;
@@ -201,6 +309,7 @@ static void i2s_data_handler(nrfx_i2s_buffers_t const *p_released, uint32_t stat
             m_streaming_audio = true;
             m_event_handler(CODEC_EVT_TYPE_AUDIO_STREAM_STARTED);
         }
+        telemetry_trace(TELEMETRY_TRACE_STREAM_START, 0);
     }
 
     uint32_t *p_buffer = codec_buffer_get_tx();
@@ -209,8 +318,12 @@ static void i2s_data_handler(nrfx_i2s_buffers_t const *p_released, uint32_t stat
     {
         nrfx_i2s_buffers_t next_buffers = {.p_tx_buffer = p_buffer, .p_rx_buffer = NULL};
 
+        codec_tx_block_process(p_buffer);
+
         err_code = nrfx_i2s_next_buffers_set(&next_buffers);
         VERIFY_SUCCESS_VOID(err_code);
+
+        telemetry_i2s_latency(start);
     } else
     {
         // Audio buffer queue empty, stop
@@ -229,6 +342,13 @@ static ret_code_t codec_start_audio_stream(void)
         return NRF_ERROR_NOT_FOUND;
     }
 
+    codec_limiter_sample_rate_set(m_sample_rate);
+
+    // Fade in from silence unless muted
+    codec_ramp_reset(true);
+    codec_ramp_start(codec_fade_in_allowed());
+    codec_tx_block_process(p_tx_buffer);
+
     nrfx_i2s_buffers_t initial_buffers = {.p_tx_buffer = p_tx_buffer, .p_rx_buffer = NULL};
 
     return nrfx_i2s_start(&initial_buffers, CODEC_BUFFER_SIZE_WORDS, 0);
@@ -301,9 +421,21 @@ ret_code_t codec_init(dk_twi_mngr_t const *p_dk_twi_mngr, codec_event_handler_t
     m_event_handler   = event_handler;
     m_streaming_audio = false;
 
-    err_code = codec_buffer_init(codec_buffer_event_handler);
+    codec_dsp_init();
+
+    err_code = codec_eq_init();
+    VERIFY_SUCCESS(err_code);
+
+    err_code = codec_limiter_init();
+    VERIFY_SUCCESS(err_code);
+
+    err_code = codec_buffer_init(codec_buffer_event_handler, codec_dsp_process);
     VERIFY_SUCCESS(err_code);
 
+    codec_resampler_reset();
+    codec_ramp_sample_rate_set(CODEC_SAMPLE_RATE_DEFAULT);
+    codec_ramp_reset(true);
+
     err_code = i2s_init();
     VERIFY_SUCCESS(err_code);
 
@@ -315,17 +447,241 @@ ret_code_t codec_init(dk_twi_mngr_t const *p_dk_twi_mngr, codec_event_handler_t
     return NRF_SUCCESS;
 }
 
-ret_code_t codec_set_mode(codec_mode_t mode) { return codec_hal_mode_set(mode); }
+ret_code_t codec_set_mode(codec_mode_t mode)
+{
+    if (m_streaming_audio && !codec_ramp_is_silent())
+    {
+        // Switch once audio has faded out
+        m_pending_mode = mode;
+        codec_ramp_start(false);
+        return NRF_SUCCESS;
+    }
+
+    m_pending_mode = CODEC_MODE_OFF;
+
+    return codec_hal_mode_set(mode);
+}
+
+ret_code_t codec_mute(bool mute)
+{
+    ret_code_t err_code;
+
+    m_muted = mute;
+
+    if (mute)
+    {
+        if (m_streaming_audio)
+        {
+            // Hardware mute is asserted once audio has faded out
+            codec_ramp_start(false);
+            return NRF_SUCCESS;
+        }
+
+        codec_ramp_reset(true);
+
+        return codec_hal_mute(true);
+    }
+
+    err_code = codec_hal_mute(false);
+    VERIFY_SUCCESS(err_code);
+
+    if (codec_fade_in_allowed())
+    {
+        codec_ramp_start(true);
+    }
+
+    return NRF_SUCCESS;
+}
+
+ret_code_t codec_set_sample_rate(uint32_t sample_rate)
+{
+    ret_code_t err_code;
+
+    err_code = codec_hal_clock_set(sample_rate);
+    VERIFY_SUCCESS(err_code);
+
+    m_sample_rate = sample_rate;
+
+    codec_buffer_sample_rate_set(sample_rate);
+    codec_ramp_sample_rate_set(sample_rate);
+
+    err_code = codec_eq_sample_rate_set(sample_rate);
+    VERIFY_SUCCESS(err_code);
+
+    return NRF_SUCCESS;
+}
+
+ret_code_t codec_set_volume(int16_t volume) { return codec_hal_volume_set(volume); }
+
+void codec_clip_set(bool clipping) { codec_limiter_clip_set(clipping); }
+
+void codec_output_hold(bool hold)
+{
+    m_output_hold = hold;
+
+    if (hold)
+    {
+        codec_ramp_start(false);
+    } else if (codec_fade_in_allowed())
+    {
+        codec_ramp_start(true);
+    }
+}
+
+ret_code_t codec_set_format(codec_format_t format)
+{
+    if (codec_convert_get(format) == NULL)
+    {
+        return NRF_ERROR_NOT_SUPPORTED;
+    }
 
-ret_code_t codec_mute(bool mute) { return codec_hal_mute(mute); }
+    m_format = format;
 
-void *codec_get_rx_buffer(size_t size) { return codec_buffer_get_rx(size); }
+    return NRF_SUCCESS;
+}
 
-ret_code_t codec_release_rx_buffer(size_t size) { return codec_buffer_release_rx(size); }
+ret_code_t codec_ring_power_set(bool on)
+{
+    ret_code_t err_code;
 
-ret_code_t codec_release_unfinished_rx_buffer(void) { return codec_buffer_release_rx_unfinished(); }
+    if (on == m_ring_powered)
+    {
+        return NRF_SUCCESS;
+    }
 
-void codec_debug(void) { codec_hal_debug(); }
+    if (m_streaming_audio)
+    {
+        return NRF_ERROR_BUSY;
+    }
+
+    if (!on)
+    {
+        m_ring_powered = false; // Stop handing out RX buffers before the RAM goes away
+    }
+
+    err_code = ram_power_set(NRF_SECTION_START_ADDR(codec_ring), NRF_SECTION_LENGTH(codec_ring), on);
+    VERIFY_SUCCESS(err_code);
+
+    if (on)
+    {
+        // Ring contents were lost, start over from an empty ring
+        err_code = codec_buffer_init(codec_buffer_event_handler, codec_dsp_process);
+        VERIFY_SUCCESS(err_code);
+
+        codec_buffer_sample_rate_set(m_sample_rate);
+        codec_resampler_reset();
+
+        mp_convert     = NULL;
+        mp_rx_buffer   = NULL;
+        m_ring_powered = true;
+    }
+
+    return NRF_SUCCESS;
+}
+
+void *codec_get_rx_buffer(size_t size)
+{
+    size_t reserve;
+
+    if (!m_ring_powered)
+    {
+        return NULL;
+    }
+
+    if (mp_convert == NULL)
+    {
+        mp_convert = codec_convert_get(m_format); // Latched for the whole stream, no lookup per packet
+    }
+
+    // Converted frames may take more room than the packet
+    reserve = MAX(size, (size / mp_convert->frame_size) * CODEC_FRAME_SIZE);
+
+#if CODEC_RESAMPLER_ENABLED
+    reserve += CODEC_FRAME_SIZE; // Room for one extra resampled frame
+#endif
+
+    mp_rx_buffer = codec_buffer_get_rx(reserve);
+
+    return mp_rx_buffer;
+}
+
+ret_code_t codec_release_rx_buffer(size_t size)
+{
+    size_t frames;
+
+    if ((mp_rx_buffer == NULL) || (mp_convert == NULL))
+    {
+        return NRF_ERROR_INVALID_STATE;
+    }
+
+    // Stream resumed before I2S has stopped, fade back in. Once per resume, not per packet
+    if (codec_ramp_is_fading_out() && codec_fade_in_allowed())
+    {
+        codec_ramp_start(true);
+    }
+
+    frames = size / mp_convert->frame_size;
+
+    if (mp_convert->handler != NULL)
+    {
+        mp_convert->handler(mp_rx_buffer, frames);
+    }
+
+#if CODEC_RESAMPLER_ENABLED
+    if (m_streaming_audio)
+    {
+        codec_resampler_fill_update(codec_buffer_fill_get() / CODEC_FRAME_SIZE, CODEC_RESAMPLER_TARGET_FRAMES);
+    }
+
+    if (codec_resampler_process(mp_rx_buffer, frames, mp_rx_buffer, frames + 1, &frames) != NRF_SUCCESS)
+    {
+        telemetry_count(TELEMETRY_COUNTER_RESAMPLER_BYPASS); // Played as received rather than dropped
+    }
+#endif
+
+    return codec_buffer_release_rx(frames * CODEC_FRAME_SIZE);
+}
+
+void codec_cancel_rx_buffer(void)
+{
+    mp_rx_buffer = NULL;
+    codec_buffer_cancel_rx();
+}
+
+ret_code_t codec_release_unfinished_rx_buffer(void)
+{
+    // USB stream has stopped, fade out whatever is still queued
+    codec_ramp_start(false);
+    mp_convert = NULL;
+
+    return codec_buffer_release_rx_unfinished();
+}
+
+uint32_t codec_feedback_get(void)
+{
+#if CODEC_FEEDBACK_ENABLED
+    return codec_buffer_feedback_get();
+#else
+    return (m_sample_rate << 14) / 1000; // Nominal, the resampler takes up the drift
+#endif
+}
+
+void codec_debug(void)
+{
+    codec_buffer_stats_t stats;
+
+    codec_buffer_stats_get(&stats);
+
+    NRF_LOG_INFO("Queue %u/%u, ring max %u",
+                 stats.queue_utilization,
+                 stats.max_queue_utilization,
+                 stats.max_ring_utilization);
+    NRF_LOG_INFO("Underruns %u, overruns %u", stats.underruns, stats.overruns);
+
+    codec_dsp_debug();
+    codec_limiter_debug();
+    codec_hal_debug();
+}
 
 /*
 digital mode has 2 sampling frequency modes
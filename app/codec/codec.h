@@ -13,6 +13,7 @@
 #define CODEC_H
 
 #include "codec_common.h"
+#include "codec_convert.h"
 #include "dk_twi_mngr.h"
 
 typedef void (*codec_event_handler_t)(codec_evt_type_t event_type);
@@ -23,12 +24,51 @@ ret_code_t codec_set_mode(codec_mode_t mode);
 
 ret_code_t codec_mute(bool mute);
 
+/**
+ * @brief Set audio stream sample rate. Supported rates are 44.1 kHz and 48 kHz.
+ */
+ret_code_t codec_set_sample_rate(uint32_t sample_rate);
+
+/**
+ * @brief Set playback volume in 1/256 dB units, 0 dB to -63.5 dB.
+ */
+ret_code_t codec_set_volume(int16_t volume);
+
+/**
+ * @brief Report amplifier clip or over temperature warning state to the limiter. Safe to call from interrupt context.
+ */
+void codec_clip_set(bool clipping);
+
+/**
+ * @brief Fade audio out and keep it silent without changing mute state or stopping the stream.
+ */
+void codec_output_hold(bool hold);
+
+/**
+ * @brief Set sample format of received audio. Takes effect when the next USB stream starts.
+ */
+ret_code_t codec_set_format(codec_format_t format);
+
+/**
+ * @brief Power the audio ring RAM on or off. The ring is emptied when power comes back.
+ *
+ * @retval NRF_ERROR_BUSY Audio is still playing from the ring.
+ */
+ret_code_t codec_ring_power_set(bool on);
+
 void *codec_get_rx_buffer(size_t size);
 
 ret_code_t codec_release_rx_buffer(size_t size);
 
+void codec_cancel_rx_buffer(void);
+
 ret_code_t codec_release_unfinished_rx_buffer(void);
 
+/**
+ * @brief Get USB asynchronous feedback, samples per frame in 10.14 format that keep the buffer at its fill target.
+ */
+uint32_t codec_feedback_get(void);
+
 void codec_debug(void);
 
 #endif // CODEC_H
@@ -11,241 +11,286 @@
 
 #include "codec_buffer.h"
 
-#include "nrf_balloc.h"
-#include "nrf_queue.h"
+#include "app_util_platform.h"
+#include "codec_common.h"
+#include "profile.h"
+#include "sdk_common.h"
+#include "telemetry.h"
 
 #define NRF_LOG_MODULE_NAME codec_buffer
 #include "nrf_log.h"
 NRF_LOG_MODULE_REGISTER();
 
-#define CODEC_BUFFER_SIZE         CODEC_BUFFER_SIZE_WORDS * sizeof(uint32_t)
+#include "codec_rt.h" // Must stay the last include, poisons blocking calls
 
-#define CODEC_POOL_ELEMENT_SIZE   CODEC_BUFFER_SIZE + 192
-#define CODEC_QUEUE_SIZE          14
+#define CODEC_BUFFER_SIZE         (CODEC_BUFFER_SIZE_WORDS * sizeof(uint32_t))
+
+#define CODEC_QUEUE_SIZE          6 /**< Host is paced by feedback, only jitter around the fill target is buffered. */
 #define CODEC_POPPED_QUEUE_SIZE   2
-#define CODEC_POOL_SIZE           CODEC_QUEUE_SIZE + CODEC_POPPED_QUEUE_SIZE
-#define CODEC_QUEUE_WATERMARK_LOW 4
+#define CODEC_QUEUE_WATERMARK_LOW CODEC_BUFFER_WATERMARK
 
-typedef struct
-{
-    uint8_t *p_buffer;
-    size_t   size;        /**< Size of the buffer. Amount of bytes already written to it. */
-    uint16_t write_index; /**< Write index. Index of the next byte to write to the buffer. */
-} codec_buffer_t;
+#define CODEC_RING_BLOCKS         (CODEC_QUEUE_SIZE + CODEC_POPPED_QUEUE_SIZE)
+#define CODEC_RING_SIZE           (CODEC_RING_BLOCKS * CODEC_BUFFER_SIZE)
+#define CODEC_RING_MASK           (CODEC_RING_SIZE - 1)
+#define CODEC_RING_SLACK_SIZE     CODEC_BUFFER_RX_SIZE_MAX /**< Room for one RX transfer running past the ring end. */
+#define CODEC_RING_POPPED_SIZE    (CODEC_POPPED_QUEUE_SIZE * CODEC_BUFFER_SIZE)
 
-typedef uint32_t *codec_buffer_pointer_t;
+#define CODEC_FRAME_SIZE          sizeof(uint32_t) /**< One stereo 16 bit frame. */
+#define CODEC_FEEDBACK_GAIN       16               /**< Correction per frame of fill level error. */
+#define CODEC_FILL_TARGET         (CODEC_BUFFER_FILL_TARGET_FRAMES * CODEC_FRAME_SIZE)
 
-NRF_BALLOC_DEF(m_codec_pool, CODEC_POOL_ELEMENT_SIZE, CODEC_POOL_SIZE);
-NRF_QUEUE_DEF(codec_buffer_pointer_t, m_codec_queue, CODEC_POOL_SIZE, NRF_QUEUE_MODE_NO_OVERFLOW);
-NRF_QUEUE_DEF(codec_buffer_pointer_t, m_popped_buffer_queue, CODEC_POPPED_QUEUE_SIZE, NRF_QUEUE_MODE_NO_OVERFLOW);
+STATIC_ASSERT(IS_POWER_OF_TWO(CODEC_RING_SIZE), "Codec ring size must be a power of two");
+STATIC_ASSERT((CODEC_RING_SLACK_SIZE % sizeof(uint32_t)) == 0, "Codec ring slack must be word aligned");
+STATIC_ASSERT(CODEC_BUFFER_WATERMARK < CODEC_QUEUE_SIZE, "Fill target must leave headroom in the queue");
+
+/**
+ * @brief Audio ring buffer.
+ *
+ * USB transfers are written straight into the ring and I2S reads whole blocks out of it. A transfer that starts close
+ * to the ring end is allowed to run into the slack area, its tail is folded back to the ring start on release.
+ *
+ * Lives in its own word aligned .codec_ring section so EasyDMA can read it and its size and place show in the map
+ * file. The section is not zeroed at startup, blocks are always written before I2S reads them.
+ */
+static uint32_t m_codec_ring[(CODEC_RING_SIZE + CODEC_RING_SLACK_SIZE) / sizeof(uint32_t)]
+    __attribute__((section(".codec_ring"), aligned(4)));
+
+/*
+ * Free running byte indexes. Ring position is index & CODEC_RING_MASK.
+ *
+ * The ring is a single producer, single consumer queue. Every index has exactly one writer, so no critical sections
+ * are needed: the writer fills or drains the ring data first and publishes the index after a memory barrier, the
+ * reader loads the index and issues a barrier before touching the data it covers.
+ */
+static volatile uint32_t m_wr_index;   /**< Next byte to hand out to USB. Owned by the RX side. */
+static volatile uint32_t m_rx_index;   /**< Bytes received so far. Owned by the RX side. */
+static volatile uint32_t m_tx_index;   /**< Start of the next block to hand out to I2S. Owned by the TX side. */
+static volatile uint32_t m_free_index; /**< Bytes before this index can be overwritten. Owned by the TX side. */
 
-static codec_buffer_t               m_wr_buffer, m_rxd_buffer;
 static codec_buffer_event_handler_t m_event_handler = NULL;
-static size_t                       m_queue_utilization;
+static codec_buffer_block_handler_t m_block_handler = NULL;
+static codec_buffer_stats_t         m_stats;
+static int32_t                      m_feedback_nominal; /**< Samples per 1 ms frame in 10.14 format. */
+
+static uint8_t *codec_ring_ptr(uint32_t index) { return &((uint8_t *)m_codec_ring)[index & CODEC_RING_MASK]; }
 
-static void codec_buffer_alloc(codec_buffer_t *p_codec_buffer)
+static size_t codec_buffer_queue_utilization_get(void) { return (m_rx_index - m_tx_index) / CODEC_BUFFER_SIZE; }
+
+/**
+ * @brief Publish a new RX index. Ring data up to rx_index must already be written.
+ */
+static void codec_buffer_rx_publish(uint32_t rx_index)
+{
+    __DMB();
+    m_rx_index = rx_index;
+    m_wr_index = rx_index; // Return whatever was reserved but not used
+}
+
+/**
+ * @brief Pass blocks completed by moving the RX index to rx_index_new to the block handler.
+ */
+static void codec_buffer_blocks_complete(uint32_t rx_index_new)
 {
-    p_codec_buffer->size        = 0;
-    p_codec_buffer->write_index = 0;
+    uint32_t block_index = m_rx_index - (m_rx_index % CODEC_BUFFER_SIZE);
+
+    if (m_block_handler == NULL)
+    {
+        return;
+    }
 
-    p_codec_buffer->p_buffer = nrf_balloc_alloc(&m_codec_pool);
+    while (block_index + CODEC_BUFFER_SIZE <= rx_index_new)
+    {
+        m_block_handler((uint32_t *)codec_ring_ptr(block_index), CODEC_BUFFER_SIZE_WORDS);
+        block_index += CODEC_BUFFER_SIZE;
+    }
 }
 
-ret_code_t codec_buffer_init(codec_buffer_event_handler_t event_handler)
+ret_code_t codec_buffer_init(codec_buffer_event_handler_t event_handler, codec_buffer_block_handler_t block_handler)
 {
     VERIFY_PARAM_NOT_NULL(event_handler);
 
     m_event_handler = event_handler;
+    m_block_handler = block_handler;
 
-    memset(&m_wr_buffer, 0, sizeof(m_wr_buffer));
-    memset(&m_rxd_buffer, 0, sizeof(m_rxd_buffer));
+    m_wr_index   = 0;
+    m_rx_index   = 0;
+    m_tx_index   = 0;
+    m_free_index = 0;
 
-    m_queue_utilization = 0;
+    memset(&m_stats, 0, sizeof(m_stats));
 
-    return nrf_balloc_init(&m_codec_pool);
+    codec_buffer_sample_rate_set(CODEC_SAMPLE_RATE_DEFAULT);
+
+    return NRF_SUCCESS;
 }
 
 void *codec_buffer_get_rx(size_t size)
 {
-    uint16_t wr_index;
+    PROFILE_SCOPE(PROFILE_PROBE_BUFFER_GET_RX);
 
-    if (m_wr_buffer.p_buffer == NULL)
-    {
-        codec_buffer_alloc(&m_wr_buffer);
+    uint32_t wr_index   = m_wr_index;
+    uint32_t free_index = m_free_index;
+    size_t   ring_usage = wr_index - free_index + size;
 
-        if (m_wr_buffer.p_buffer == NULL)
-        {
-            NRF_LOG_WARNING("Codec buffer pool overflow");
-            return NULL;
-        }
-
-        m_rxd_buffer = m_wr_buffer;
+    if (size > CODEC_RING_SLACK_SIZE)
+    {
+        NRF_LOG_WARNING("RX transfer too big %u", size);
+        return NULL;
     }
 
-    if (m_wr_buffer.write_index >= CODEC_BUFFER_SIZE)
+    if (ring_usage > CODEC_RING_SIZE)
     {
-        wr_index = m_wr_buffer.write_index - CODEC_BUFFER_SIZE;
-        codec_buffer_alloc(&m_wr_buffer);
-        m_wr_buffer.write_index = wr_index;
+        m_stats.overruns++;
+        telemetry_count(TELEMETRY_COUNTER_OVERRUN);
+        NRF_LOG_WARNING("Codec buffer ring overflow");
+        return NULL;
+    }
 
-        if (m_wr_buffer.p_buffer == NULL)
-        {
-            NRF_LOG_WARNING("Codec buffer pool overflow2");
-            return NULL;
-        }
+    if (ring_usage > m_stats.max_ring_utilization)
+    {
+        m_stats.max_ring_utilization = ring_usage;
     }
 
-    wr_index = m_wr_buffer.write_index;
-    m_wr_buffer.write_index += size;
-    return &m_wr_buffer.p_buffer[wr_index];
+    __DMB(); // I2S must be done with the blocks before free_index before they are overwritten
+    m_wr_index = wr_index + size;
+
+    return codec_ring_ptr(wr_index);
 }
 
 ret_code_t codec_buffer_release_rx(size_t size)
 {
-    ret_code_t err_code;
+    PROFILE_SCOPE(PROFILE_PROBE_BUFFER_RELEASE_RX);
 
-    m_rxd_buffer.size += size;
+    uint32_t rx_index  = m_rx_index;
+    uint32_t rx_offset = rx_index & CODEC_RING_MASK;
+    uint32_t tx_index;
+    size_t   queue_utilization_prev;
+    size_t   queue_utilization;
 
-    if (m_rxd_buffer.size >= CODEC_BUFFER_SIZE) // We filled the buffer! Time to copy its overflow to the next block and
-                                                // push buffer pointer to FIFO
+    if (rx_offset + size > CODEC_RING_SIZE) // Transfer ran into the slack area, fold its tail back to the ring start
     {
-        size_t copy_size, queue_utilization;
-
-        codec_buffer_t previous_buffer = m_rxd_buffer;
-
-        copy_size = previous_buffer.size - CODEC_BUFFER_SIZE;
-
-        if (m_rxd_buffer.p_buffer == m_wr_buffer.p_buffer)
-        {
-            codec_buffer_alloc(&m_rxd_buffer);
-
-            if (m_rxd_buffer.p_buffer == NULL)
-            {
-                return NRF_ERROR_NO_MEM;
-            }
-
-            m_rxd_buffer.write_index = copy_size;
-            m_wr_buffer              = m_rxd_buffer;
-        } else
-        {
-            m_rxd_buffer = m_wr_buffer;
-        }
-
-        memcpy(m_rxd_buffer.p_buffer, &previous_buffer.p_buffer[CODEC_BUFFER_SIZE], copy_size);
-        m_rxd_buffer.size = copy_size;
+        memcpy(m_codec_ring, (uint8_t *)m_codec_ring + CODEC_RING_SIZE, rx_offset + size - CODEC_RING_SIZE);
+    }
 
-        err_code = nrf_queue_push(&m_codec_queue, (uint32_t **)&previous_buffer.p_buffer);
-        VERIFY_SUCCESS(err_code);
+    codec_buffer_blocks_complete(rx_index + size);
+    codec_buffer_rx_publish(rx_index + size);
 
-        queue_utilization = nrf_queue_utilization_get(&m_codec_queue);
+    // Both levels are taken against the same TX index, the crossing is still detected if TX resets the ring meanwhile
+    tx_index               = m_tx_index;
+    queue_utilization_prev = (rx_index - tx_index) / CODEC_BUFFER_SIZE;
+    queue_utilization      = (rx_index + size - tx_index) / CODEC_BUFFER_SIZE;
 
-        if (queue_utilization >= CODEC_QUEUE_WATERMARK_LOW && m_queue_utilization < CODEC_QUEUE_WATERMARK_LOW)
+    if (queue_utilization >= CODEC_QUEUE_WATERMARK_LOW && queue_utilization_prev < CODEC_QUEUE_WATERMARK_LOW)
+    {
+        if (m_event_handler != NULL)
         {
-            if (m_event_handler != NULL)
-            {
-                m_event_handler(CODEC_BUFFER_EVENT_TYPE_LOW_WATERMARK_CROSSED_UP);
-            }
+            m_event_handler(CODEC_BUFFER_EVENT_TYPE_LOW_WATERMARK_CROSSED_UP);
         }
+    }
 
-        m_queue_utilization = queue_utilization;
+    if (queue_utilization > m_stats.max_queue_utilization)
+    {
+        m_stats.max_queue_utilization = queue_utilization;
     }
 
     return NRF_SUCCESS;
 }
 
+void codec_buffer_cancel_rx(void) { m_wr_index = m_rx_index; }
+
 ret_code_t codec_buffer_release_rx_unfinished(void)
 {
-    ret_code_t err_code;
-    size_t     zero_data_size = CODEC_BUFFER_SIZE - m_rxd_buffer.size;
-    memset(&m_rxd_buffer.p_buffer[m_rxd_buffer.size], 0, zero_data_size);
-
-    err_code = nrf_queue_push(&m_codec_queue, (uint32_t **)&m_rxd_buffer.p_buffer);
+    uint32_t rx_index   = m_rx_index;
+    size_t   block_fill = rx_index % CODEC_BUFFER_SIZE;
+    size_t   zero_size  = CODEC_BUFFER_SIZE - block_fill;
 
-    if (m_wr_buffer.p_buffer != m_rxd_buffer.p_buffer)
+    if (block_fill == 0)
     {
-        nrf_balloc_free(&m_codec_pool, (void *)m_wr_buffer.p_buffer);
+        m_wr_index = rx_index;
+        return NRF_SUCCESS;
     }
 
-    memset(&m_wr_buffer, 0, sizeof(m_wr_buffer));
-    memset(&m_rxd_buffer, 0, sizeof(m_rxd_buffer));
+    memset(codec_ring_ptr(rx_index), 0, zero_size);
+    codec_buffer_blocks_complete(rx_index + zero_size);
+    codec_buffer_rx_publish(rx_index + zero_size);
 
-    return err_code;
+    return NRF_SUCCESS;
 }
 
 uint32_t *codec_buffer_get_tx(void)
 {
-    ret_code_t err_code;
-    uint32_t  *p_buffer;
+    uint32_t *p_buffer;
+    uint32_t  tx_index = m_tx_index;
+    size_t    queue_depth;
 
-    err_code = nrf_queue_pop(&m_codec_queue, (uint32_t **)&p_buffer);
-    if (err_code != NRF_SUCCESS)
+    if ((m_rx_index - tx_index) < CODEC_BUFFER_SIZE)
     {
-        NRF_LOG_INFO("Queue empty");
+        m_stats.underruns++;
+        telemetry_count(TELEMETRY_COUNTER_UNDERRUN);
+        telemetry_trace(TELEMETRY_TRACE_I2S_UNDERRUN, 0);
         return NULL;
     }
 
-    size_t size = nrf_queue_utilization_get(&m_popped_buffer_queue);
-    if (size >= CODEC_POPPED_QUEUE_SIZE)
-    {
-        uint32_t *p_released_buffer;
-        err_code = nrf_queue_pop(&m_popped_buffer_queue, (uint32_t **)&p_released_buffer);
+    __DMB(); // Block data was written before the RX index covering it was published
 
-        if (err_code == NRF_SUCCESS)
-        {
-            nrf_balloc_free(&m_codec_pool, (void *)p_released_buffer);
-        }
-    }
+    p_buffer = (uint32_t *)codec_ring_ptr(tx_index);
+    tx_index += CODEC_BUFFER_SIZE;
 
-    err_code = nrf_queue_push(&m_popped_buffer_queue, (uint32_t **)&p_buffer);
+    m_tx_index = tx_index;
 
-    if (err_code != NRF_SUCCESS)
+    if (tx_index - m_free_index > CODEC_RING_POPPED_SIZE) // Oldest popped block is no longer used by I2S
     {
-        NRF_LOG_ERROR("Internal error");
+        m_free_index = tx_index - CODEC_RING_POPPED_SIZE;
     }
 
+    queue_depth = (m_rx_index - tx_index) / CODEC_BUFFER_SIZE;
+    telemetry_queue_depth(queue_depth);
+    telemetry_trace(TELEMETRY_TRACE_I2S_BLOCK, (uint16_t)queue_depth);
+
     return p_buffer;
 }
 
 void codec_buffer_reset(void)
 {
-    uint32_t *p_buffer;
+    uint32_t rx_index = m_rx_index;
 
-    while (nrf_queue_pop(&m_popped_buffer_queue, (uint32_t **)&p_buffer) == NRF_SUCCESS)
-    {
-        nrf_balloc_free(&m_codec_pool, (void *)p_buffer);
-    }
+    // Only the TX side indexes are touched, queued blocks are dropped by catching up with RX. An unfinished block stays
+    // in place and keeps filling.
+    m_tx_index   = rx_index - (rx_index % CODEC_BUFFER_SIZE);
+    m_free_index = m_tx_index;
 
-    while (nrf_queue_pop(&m_codec_queue, (uint32_t **)&p_buffer) == NRF_SUCCESS)
-    {
-        nrf_balloc_free(&m_codec_pool, (void *)p_buffer);
-    }
+    NRF_LOG_INFO("Max queue utilization %u", m_stats.max_queue_utilization);
+    NRF_LOG_INFO("Max ring utilization %u", m_stats.max_ring_utilization);
+    NRF_LOG_INFO("Underruns %u, overruns %u", m_stats.underruns, m_stats.overruns);
 
-    if (m_wr_buffer.p_buffer == m_rxd_buffer.p_buffer)
-    {
-        if (m_wr_buffer.p_buffer != NULL)
-        {
-            nrf_balloc_free(&m_codec_pool, m_wr_buffer.p_buffer);
-        }
-    } else
-    {
-        if (m_wr_buffer.p_buffer != NULL)
-        {
-            nrf_balloc_free(&m_codec_pool, m_wr_buffer.p_buffer);
-        }
+    memset(&m_stats, 0, sizeof(m_stats));
+}
 
-        if (m_rxd_buffer.p_buffer != NULL)
-        {
-            nrf_balloc_free(&m_codec_pool, m_rxd_buffer.p_buffer);
-        }
-    }
+void codec_buffer_stats_get(codec_buffer_stats_t *p_stats)
+{
+    VERIFY_PARAM_NOT_NULL_VOID(p_stats);
+
+    *p_stats                   = m_stats;
+    p_stats->queue_utilization = codec_buffer_queue_utilization_get();
+}
 
-    memset(&m_wr_buffer, 0, sizeof(m_wr_buffer));
-    memset(&m_rxd_buffer, 0, sizeof(m_rxd_buffer));
+size_t codec_buffer_fill_get(void) { return m_rx_index - m_tx_index; }
 
-    NRF_LOG_INFO("Max queue utilization %u", nrf_queue_max_utilization_get(&m_codec_queue));
-    NRF_LOG_INFO("Max pool utilization %u", nrf_balloc_max_utilization_get(&m_codec_pool));
+uint32_t codec_buffer_feedback_get(void)
+{
+    int32_t fill_error = ((int32_t)codec_buffer_fill_get() - (int32_t)CODEC_FILL_TARGET) / (int32_t)CODEC_FRAME_SIZE;
+    int32_t correction = fill_error * CODEC_FEEDBACK_GAIN;
+    int32_t limit      = m_feedback_nominal / 200; // Keep correction within 0.5 %
 
-    nrf_queue_max_utilization_reset(&m_codec_queue);
+    if (correction > limit)
+    {
+        correction = limit;
+    } else if (correction < -limit)
+    {
+        correction = -limit;
+    }
 
-    m_queue_utilization = 0;
+    return m_feedback_nominal - correction;
 }
+
+void codec_buffer_sample_rate_set(uint32_t sample_rate) { m_feedback_nominal = (sample_rate << 14) / 1000; }
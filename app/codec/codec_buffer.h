@@ -13,21 +13,71 @@
 
 #include "sdk_errors.h"
 
-#define CODEC_BUFFER_SIZE_WORDS 256
+/**
+ * @brief Low latency streaming profile. Uses 4 times smaller I2S blocks and starts playback with fewer blocks queued.
+ */
+#ifndef CODEC_BUFFER_LOW_LATENCY
+#define CODEC_BUFFER_LOW_LATENCY 0
+#endif
+
+#if CODEC_BUFFER_LOW_LATENCY
+#define CODEC_BUFFER_SIZE_WORDS 64 /**< I2S block size. 1.45 ms at 44.1 kHz. */
+#define CODEC_BUFFER_WATERMARK  3  /**< Blocks queued before playback starts. */
+#else
+#define CODEC_BUFFER_SIZE_WORDS 256 /**< I2S block size. 5.8 ms at 44.1 kHz. */
+#define CODEC_BUFFER_WATERMARK  4   /**< Blocks queued before playback starts. */
+#endif
+
+#define CODEC_BUFFER_RX_SIZE_MAX 396 /**< Biggest @ref codec_buffer_get_rx request, 32 bit packet + resampled frame. */
+
+/**
+ * @brief Fill level held by the USB feedback or the resampler, whichever is built in.
+ */
+#define CODEC_BUFFER_FILL_TARGET_FRAMES (CODEC_BUFFER_WATERMARK * CODEC_BUFFER_SIZE_WORDS)
 
 typedef enum
 {
     CODEC_BUFFER_EVENT_TYPE_LOW_WATERMARK_CROSSED_UP
 } codec_buffer_event_type_t;
 
+typedef struct
+{
+    uint32_t underruns;             /**< TX block requests that found no complete block. */
+    uint32_t overruns;              /**< RX buffer requests rejected because the ring was full. */
+    size_t   queue_utilization;     /**< Complete blocks waiting for I2S. */
+    size_t   max_queue_utilization; /**< Maximum complete blocks waiting for I2S since last reset. */
+    size_t   max_ring_utilization;  /**< Maximum bytes held in the ring since last reset. */
+} codec_buffer_stats_t;
+
 typedef void (*codec_buffer_event_handler_t)(codec_buffer_event_type_t event_type);
 
-ret_code_t codec_buffer_init(codec_buffer_event_handler_t event_handler);
+/**
+ * @brief Handler called with every completed block before it becomes available to I2S. Runs in RX release context.
+ */
+typedef void (*codec_buffer_block_handler_t)(uint32_t *p_block, size_t words);
+
+/**
+ * @brief Initialize codec buffer.
+ *
+ * @param[in] event_handler Buffer event handler.
+ * @param[in] block_handler Completed block handler. May be NULL.
+ */
+ret_code_t codec_buffer_init(codec_buffer_event_handler_t event_handler, codec_buffer_block_handler_t block_handler);
 
 void *codec_buffer_get_rx(size_t size);
 
+/**
+ * @brief Release received data obtained with @ref codec_buffer_get_rx.
+ *
+ * @param[in] size Bytes written to the buffer. May be less than requested, the rest of the reservation is returned.
+ */
 ret_code_t codec_buffer_release_rx(size_t size);
 
+/**
+ * @brief Return a reservation obtained with @ref codec_buffer_get_rx that will never be written.
+ */
+void codec_buffer_cancel_rx(void);
+
 ret_code_t codec_buffer_release_rx_unfinished(void);
 
 uint32_t *codec_buffer_get_tx(void);
@@ -37,4 +87,30 @@ uint32_t *codec_buffer_get_tx(void);
  */
 ret_code_t codec_buffer_release_tx(void);
 
+/**
+ * @brief Drop all queued blocks. Must be called from the TX side, the RX side may keep writing meanwhile.
+ */
 void codec_buffer_reset(void);
+
+/**
+ * @brief Get audio path statistics. Counters are cleared by @ref codec_buffer_reset.
+ */
+void codec_buffer_stats_get(codec_buffer_stats_t *p_stats);
+
+/**
+ * @brief Get amount of received bytes not yet handed out to I2S.
+ */
+size_t codec_buffer_fill_get(void);
+
+/**
+ * @brief Get USB asynchronous feedback value.
+ *
+ * @return Samples per USB frame in 10.14 fixed point format, trimmed so that the buffer fill level is pulled back
+ *         towards @ref CODEC_BUFFER_FILL_TARGET_FRAMES.
+ */
+uint32_t codec_buffer_feedback_get(void);
+
+/**
+ * @brief Set sample rate used for feedback calculation.
+ */
+void codec_buffer_sample_rate_set(uint32_t sample_rate);
@@ -12,6 +12,8 @@
 #ifndef CODEC_COMMON_H
 #define CODEC_COMMON_H
 
+#define CODEC_SAMPLE_RATE_DEFAULT 44100
+
 typedef enum
 {
     CODEC_MODE_OFF,
@@ -21,8 +23,10 @@ typedef enum
 
 typedef enum
 {
+    CODEC_EVT_TYPE_READY, /**< Out of reset and configured for bypass. */
     CODEC_EVT_TYPE_BYPASS_MODE_READY,
     CODEC_EVT_TYPE_I2S_MODE_READY,
+    CODEC_EVT_TYPE_MODE_TIMEOUT,
     CODEC_EVT_TYPE_AUDIO_STREAM_STARTED,
     CODEC_EVT_TYPE_AUDIO_STREAM_STOPPED
 } codec_evt_type_t;
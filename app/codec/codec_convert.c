@@ -0,0 +1,108 @@
+/**
+ * @file        codec_convert.c
+ * @author      Danius Kalvaitis (danius.kalvaitis@gmail.com)
+ * @brief       Conversion of received sample formats to the 16 bit stereo frames used by the audio path.
+ * @version     0.1
+ * @date        2026-10-17
+ *
+ * @copyright   Copyright (c) Danius Kalvaitis 2026 All rights reserved
+ *
+ */
+
+#include "codec_convert.h"
+
+#include "nrf.h"
+#include "sdk_common.h"
+
+#include "codec_rt.h" // Must stay the last include, poisons blocking calls
+
+/**
+ * @brief Swap channels. Rotating the frame by 16 swaps both halves.
+ */
+static void convert_s16_stereo_swapped(void *p_data, size_t frames)
+{
+    uint32_t *p_frames = p_data;
+
+    for (size_t i = 0; i < frames; i++)
+    {
+        p_frames[i] = __ROR(p_frames[i], 16);
+    }
+}
+
+/**
+ * @brief Duplicate mono samples. Output is twice the input, so frames are written from the end backwards.
+ */
+static void convert_s16_mono(void *p_data, size_t frames)
+{
+    uint16_t const *p_in  = p_data;
+    uint32_t       *p_out = p_data;
+    size_t          i     = frames;
+
+    if (i & 1)
+    {
+        i--;
+        p_out[i] = __PKHBT(p_in[i], p_in[i], 16);
+    }
+
+    while (i > 0) // One word holds two samples
+    {
+        uint32_t samples;
+
+        i -= 2;
+        samples = *(uint32_t const *)&p_in[i];
+
+        p_out[i + 1] = __PKHTB(samples, samples, 16);
+        p_out[i]     = __PKHBT(samples, samples, 16);
+    }
+}
+
+/**
+ * @brief Keep the upper 16 bits of 3 byte samples. Output is smaller than input, frames are written front to back.
+ */
+static void convert_s24_stereo(void *p_data, size_t frames)
+{
+    uint8_t const *p_in  = p_data;
+    uint32_t      *p_out = p_data;
+
+    for (size_t i = 0; i < frames; i++, p_in += 6)
+    {
+        uint32_t left  = __UNALIGNED_UINT32_READ(p_in);     // Left sample in bits 23..0
+        uint32_t right = __UNALIGNED_UINT32_READ(p_in + 2); // Right sample in bits 31..8
+
+        p_out[i] = __PKHBT(left >> 8, right, 0);
+    }
+}
+
+/**
+ * @brief Keep the upper halves of 4 byte samples. Output is half the input, frames are written front to back.
+ */
+static void convert_s32_stereo(void *p_data, size_t frames)
+{
+    uint32_t const *p_in  = p_data;
+    uint32_t       *p_out = p_data;
+
+    for (size_t i = 0; i < frames; i++, p_in += 2)
+    {
+        p_out[i] = __PKHTB(p_in[1], p_in[0], 16);
+    }
+}
+
+static codec_convert_t const m_converters[CODEC_FORMAT_COUNT] = {
+  [CODEC_FORMAT_S16_STEREO]         = {.handler = NULL, .frame_size = 4},
+  [CODEC_FORMAT_S16_STEREO_SWAPPED] = {.handler = convert_s16_stereo_swapped, .frame_size = 4},
+  [CODEC_FORMAT_S16_MONO]           = {.handler = convert_s16_mono, .frame_size = 2},
+  [CODEC_FORMAT_S24_STEREO]         = {.handler = convert_s24_stereo, .frame_size = 6},
+  [CODEC_FORMAT_S32_STEREO]         = {.handler = convert_s32_stereo, .frame_size = 8},
+};
+
+STATIC_ASSERT(CODEC_CONVERT_FRAME_SIZE_MAX == 8, "Update biggest input frame size when adding formats");
+
+codec_convert_t const *codec_convert_get(codec_format_t format)
+{
+    if (format >= CODEC_FORMAT_COUNT)
+    {
+        return NULL;
+    }
+
+    return &m_converters[format];
+}
@@ -0,0 +1,49 @@
+/**
+ * @file        codec_convert.h
+ * @author      Danius Kalvaitis (danius.kalvaitis@gmail.com)
+ * @brief       Conversion of received sample formats to the 16 bit stereo frames used by the audio path.
+ * @version     0.1
+ * @date        2026-10-17
+ *
+ * @copyright   Copyright (c) Danius Kalvaitis 2026 All rights reserved
+ *
+ */
+
+#ifndef CODEC_CONVERT_H
+#define CODEC_CONVERT_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+#define CODEC_CONVERT_FRAME_SIZE     sizeof(uint32_t) /**< Output frame, left sample in the low half. */
+#define CODEC_CONVERT_FRAME_SIZE_MAX 8                /**< Biggest input frame, 32 bit stereo. */
+
+typedef enum
+{
+    CODEC_FORMAT_S16_STEREO,         /**< Native format, no conversion. */
+    CODEC_FORMAT_S16_STEREO_SWAPPED, /**< Right channel first. */
+    CODEC_FORMAT_S16_MONO,           /**< Duplicated to both channels. */
+    CODEC_FORMAT_S24_STEREO,         /**< 3 byte samples, truncated to 16 bits. */
+    CODEC_FORMAT_S32_STEREO,         /**< 4 byte samples, truncated to 16 bits. */
+    CODEC_FORMAT_COUNT
+} codec_format_t;
+
+/**
+ * @brief Convert frames in place. Output may be bigger than input, the buffer must fit both.
+ */
+typedef void (*codec_convert_handler_t)(void *p_data, size_t frames);
+
+typedef struct
+{
+    codec_convert_handler_t handler;    /**< NULL when no conversion is needed. */
+    uint8_t                 frame_size; /**< Input frame size in bytes. */
+} codec_convert_t;
+
+/**
+ * @brief Get converter for a format. Look it up once when the stream starts, not per packet.
+ *
+ * @return Converter or NULL if format is not supported.
+ */
+codec_convert_t const *codec_convert_get(codec_format_t format);
+
+#endif // CODEC_CONVERT_H
@@ -0,0 +1,88 @@
+/**
+ * @file        codec_dsp.c
+ * @author      Danius Kalvaitis (danius.kalvaitis@gmail.com)
+ * @brief       Block based audio processing chain run on received audio before it is played.
+ * @version     0.1
+ * @date        2026-10-17
+ *
+ * @copyright   Copyright (c) Danius Kalvaitis 2026 All rights reserved
+ *
+ */
+
+#include "codec_dsp.h"
+
+#include "profile.h"
+#include "sdk_common.h"
+
+#define NRF_LOG_MODULE_NAME codec_dsp
+#include "nrf_log.h"
+NRF_LOG_MODULE_REGISTER();
+
+#include "codec_rt.h" // Must stay the last include, poisons blocking calls
+
+typedef struct
+{
+    uint32_t max_cycles;
+    uint32_t budget_overruns;
+} codec_dsp_stage_stats_t;
+
+static codec_dsp_stage_t const *mp_stages[CODEC_DSP_STAGES_MAX];
+static codec_dsp_stage_stats_t  m_stats[CODEC_DSP_STAGES_MAX];
+static size_t                   m_stage_count;
+
+void codec_dsp_init(void)
+{
+    m_stage_count = 0;
+    memset(m_stats, 0, sizeof(m_stats));
+}
+
+ret_code_t codec_dsp_stage_register(codec_dsp_stage_t const *p_stage)
+{
+    VERIFY_PARAM_NOT_NULL(p_stage);
+    VERIFY_PARAM_NOT_NULL(p_stage->handler);
+
+    if (m_stage_count >= CODEC_DSP_STAGES_MAX)
+    {
+        return NRF_ERROR_NO_MEM;
+    }
+
+    mp_stages[m_stage_count++] = p_stage;
+
+    return NRF_SUCCESS;
+}
+
+void codec_dsp_process(uint32_t *p_frames, size_t frames)
+{
+    for (size_t i = 0; i < m_stage_count; i++)
+    {
+        codec_dsp_stage_t const *p_stage = mp_stages[i];
+        uint32_t                 start   = profile_timestamp();
+        uint32_t                 cycles;
+
+        p_stage->handler(p_frames, frames, p_stage->p_context);
+
+        cycles = profile_timestamp() - start;
+
+        if (cycles > m_stats[i].max_cycles)
+        {
+            m_stats[i].max_cycles = cycles;
+        }
+
+        if ((p_stage->cycle_budget != 0) && (cycles > p_stage->cycle_budget))
+        {
+            m_stats[i].budget_overruns++;
+        }
+    }
+}
+
+void codec_dsp_debug(void)
+{
+    for (size_t i = 0; i < m_stage_count; i++)
+    {
+        NRF_LOG_INFO("Stage %s max %u cycles, budget %u, overruns %u",
+                     mp_stages[i]->p_name,
+                     m_stats[i].max_cycles,
+                     mp_stages[i]->cycle_budget,
+                     m_stats[i].budget_overruns);
+    }
+}
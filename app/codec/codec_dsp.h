@@ -0,0 +1,59 @@
+/**
+ * @file        codec_dsp.h
+ * @author      Danius Kalvaitis (danius.kalvaitis@gmail.com)
+ * @brief       Block based audio processing chain run on received audio before it is played.
+ * @version     0.1
+ * @date        2026-10-17
+ *
+ * @copyright   Copyright (c) Danius Kalvaitis 2026 All rights reserved
+ *
+ */
+
+#ifndef CODEC_DSP_H
+#define CODEC_DSP_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include "sdk_errors.h"
+
+#ifndef CODEC_DSP_STAGES_MAX
+#define CODEC_DSP_STAGES_MAX 8
+#endif
+
+/**
+ * @brief Stage handler. Processes a block of 16 bit stereo frames in place.
+ */
+typedef void (*codec_dsp_stage_handler_t)(uint32_t *p_frames, size_t frames, void *p_context);
+
+typedef struct
+{
+    char const               *p_name;
+    codec_dsp_stage_handler_t handler;
+    void                     *p_context;
+    uint32_t                  cycle_budget; /**< CPU cycles the stage may spend on one block. 0 disables the check. */
+} codec_dsp_stage_t;
+
+/**
+ * @brief Initialize processing chain and cycle counter.
+ */
+void codec_dsp_init(void);
+
+/**
+ * @brief Append a stage to the processing chain. Stages run in registration order.
+ *
+ * @param[in] p_stage Stage description. Must stay valid while the stage is registered.
+ */
+ret_code_t codec_dsp_stage_register(codec_dsp_stage_t const *p_stage);
+
+/**
+ * @brief Run all stages on a block.
+ */
+void codec_dsp_process(uint32_t *p_frames, size_t frames);
+
+/**
+ * @brief Log per stage cycle usage.
+ */
+void codec_dsp_debug(void);
+
+#endif // CODEC_DSP_H
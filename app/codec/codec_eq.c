@@ -0,0 +1,370 @@
+/**
+ * @file        codec_eq.c
+ * @author      Danius Kalvaitis (danius.kalvaitis@gmail.com)
+ * @brief       Parametric equalizer processing stage.
+ * @version     0.1
+ * @date        2026-10-17
+ *
+ * @copyright   Copyright (c) Danius Kalvaitis 2026 All rights reserved
+ *
+ */
+
+#include "codec_eq.h"
+
+#include <math.h>
+
+#include "arm_math.h"
+#include "codec_buffer.h"
+#include "codec_common.h"
+#include "codec_dsp.h"
+#include "codec_hal.h"
+#include "sdk_common.h"
+
+#define NRF_LOG_MODULE_NAME codec_eq
+#include "nrf_log.h"
+NRF_LOG_MODULE_REGISTER();
+
+#include "codec_rt.h" // Must stay the last include, poisons blocking calls
+
+#define EQ_POST_SHIFT     2     /**< Coefficients are stored divided by 4 to fit Q31. */
+#define EQ_HEADROOM_SHIFT 2     /**< Samples are scaled down by 12 dB so boosts do not wrap inside the filter. */
+#define EQ_CYCLE_BUDGET   40000 /**< Per block, both channels. */
+#define EQ_BIQUAD_COEFS   5
+
+#if CODEC_EQ_CODEC_OFFLOAD
+#define EQ_CODEC_BANDS CODEC_HAL_BIQUAD_COUNT
+#else
+#define EQ_CODEC_BANDS 0
+#endif
+
+#define EQ_MCU_BANDS (CODEC_EQ_BANDS - EQ_CODEC_BANDS)
+
+STATIC_ASSERT(EQ_MCU_BANDS > 0, "At least one equalizer band has to run on the MCU");
+
+/**
+ * @brief Biquad coefficients normalized to a0 = 1.
+ */
+typedef struct
+{
+    float b0;
+    float b1;
+    float b2;
+    float a1;
+    float a2;
+} eq_biquad_t;
+
+/**
+ * @brief Speaker voicing applied at init: boxiness and presence taken out, a little low end and air added back.
+ *
+ * Cuts come first so they still fit the codec biquads when the first bands are offloaded.
+ */
+static codec_eq_band_t const m_default_profile[] = {
+  {.type = CODEC_EQ_BAND_TYPE_PEAK, .frequency = 350.0f, .gain_db = -2.0f, .q = 1.0f},
+  {.type = CODEC_EQ_BAND_TYPE_PEAK, .frequency = 3000.0f, .gain_db = -1.5f, .q = 2.0f},
+  {.type = CODEC_EQ_BAND_TYPE_LOW_SHELF, .frequency = 120.0f, .gain_db = 3.0f, .q = 0.707f},
+  {.type = CODEC_EQ_BAND_TYPE_HIGH_SHELF, .frequency = 8000.0f, .gain_db = 2.0f, .q = 0.707f}};
+
+STATIC_ASSERT(ARRAY_SIZE(m_default_profile) <= CODEC_EQ_BANDS, "Default profile has more bands than configured");
+
+static codec_eq_band_t m_bands[CODEC_EQ_BANDS];
+static uint32_t        m_sample_rate;
+
+/* Two coefficient banks. Bands are recalculated into the inactive bank, which is then swapped in between blocks. */
+static q31_t            m_coefs[2][EQ_MCU_BANDS * EQ_BIQUAD_COEFS];
+static bool             m_flat[2];
+static volatile uint8_t m_bank;
+static bool             m_was_flat;
+
+static q31_t                        m_left_state[EQ_MCU_BANDS * 4];
+static q31_t                        m_right_state[EQ_MCU_BANDS * 4];
+static arm_biquad_casd_df1_inst_q31 m_left;
+static arm_biquad_casd_df1_inst_q31 m_right;
+static q31_t                        m_left_frames[CODEC_BUFFER_SIZE_WORDS];
+static q31_t                        m_right_frames[CODEC_BUFFER_SIZE_WORDS];
+
+static void eq_process(uint32_t *p_frames, size_t frames, void *p_context);
+
+static codec_dsp_stage_t const m_eq_stage = {
+  .p_name       = "eq",
+  .handler      = eq_process,
+  .p_context    = NULL,
+  .cycle_budget = EQ_CYCLE_BUDGET,
+};
+
+static bool eq_band_is_flat(codec_eq_band_t const *p_band) { return p_band->gain_db == 0.0f; }
+
+/**
+ * @brief Calculate band coefficients, see Audio EQ Cookbook by Robert Bristow-Johnson.
+ */
+static void eq_biquad_calc(codec_eq_band_t const *p_band, eq_biquad_t *p_biquad)
+{
+    float w0    = 2.0f * PI * p_band->frequency / (float)m_sample_rate;
+    float cos0  = cosf(w0);
+    float alpha = sinf(w0) / (2.0f * p_band->q);
+    float a     = powf(10.0f, p_band->gain_db / 40.0f);
+    float sqrta = 2.0f * sqrtf(a) * alpha;
+    float b0, b1, b2, a0, a1, a2;
+
+    switch (p_band->type)
+    {
+        case CODEC_EQ_BAND_TYPE_LOW_SHELF:
+            b0 = a * ((a + 1.0f) - (a - 1.0f) * cos0 + sqrta);
+            b1 = 2.0f * a * ((a - 1.0f) - (a + 1.0f) * cos0);
+            b2 = a * ((a + 1.0f) - (a - 1.0f) * cos0 - sqrta);
+            a0 = (a + 1.0f) + (a - 1.0f) * cos0 + sqrta;
+            a1 = -2.0f * ((a - 1.0f) + (a + 1.0f) * cos0);
+            a2 = (a + 1.0f) + (a - 1.0f) * cos0 - sqrta;
+            break;
+        case CODEC_EQ_BAND_TYPE_HIGH_SHELF:
+            b0 = a * ((a + 1.0f) + (a - 1.0f) * cos0 + sqrta);
+            b1 = -2.0f * a * ((a - 1.0f) + (a + 1.0f) * cos0);
+            b2 = a * ((a + 1.0f) + (a - 1.0f) * cos0 - sqrta);
+            a0 = (a + 1.0f) - (a - 1.0f) * cos0 + sqrta;
+            a1 = 2.0f * ((a - 1.0f) - (a + 1.0f) * cos0);
+            a2 = (a + 1.0f) - (a - 1.0f) * cos0 - sqrta;
+            break;
+        case CODEC_EQ_BAND_TYPE_PEAK:
+        default:
+            b0 = 1.0f + alpha * a;
+            b1 = -2.0f * cos0;
+            b2 = 1.0f - alpha * a;
+            a0 = 1.0f + alpha / a;
+            a1 = -2.0f * cos0;
+            a2 = 1.0f - alpha / a;
+            break;
+    }
+
+    p_biquad->b0 = b0 / a0;
+    p_biquad->b1 = b1 / a0;
+    p_biquad->b2 = b2 / a0;
+    p_biquad->a1 = a1 / a0;
+    p_biquad->a2 = a2 / a0;
+}
+
+static q31_t eq_coef_q31(float coef)
+{
+    float scaled = coef * (float)(1u << (31 - EQ_POST_SHIFT));
+
+    if (scaled >= 2147483647.0f)
+    {
+        return INT32_MAX;
+    } else if (scaled <= -2147483648.0f)
+    {
+        return INT32_MIN;
+    }
+
+    return (q31_t)scaled;
+}
+
+/**
+ * @brief Recalculate MCU bands into the inactive bank and swap it in.
+ */
+static void eq_bank_update(void)
+{
+    uint8_t bank = m_bank ^ 1;
+    bool    flat = true;
+
+    for (size_t i = 0; i < EQ_MCU_BANDS; i++)
+    {
+        codec_eq_band_t const *p_band  = &m_bands[EQ_CODEC_BANDS + i];
+        q31_t                 *p_coefs = &m_coefs[bank][i * EQ_BIQUAD_COEFS];
+        eq_biquad_t            biquad  = {.b0 = 1.0f};
+
+        if (!eq_band_is_flat(p_band))
+        {
+            eq_biquad_calc(p_band, &biquad);
+            flat = false;
+        }
+
+        // CMSIS DSP expects negated feedback coefficients
+        p_coefs[0] = eq_coef_q31(biquad.b0);
+        p_coefs[1] = eq_coef_q31(biquad.b1);
+        p_coefs[2] = eq_coef_q31(biquad.b2);
+        p_coefs[3] = eq_coef_q31(-biquad.a1);
+        p_coefs[4] = eq_coef_q31(-biquad.a2);
+    }
+
+    m_flat[bank] = flat;
+
+    __DMB();
+    m_bank = bank;
+}
+
+#if CODEC_EQ_CODEC_OFFLOAD
+static bool eq_codec_coef(float coef, float scale, int16_t *p_coef)
+{
+    float scaled = roundf(coef * scale);
+
+    if (scaled == 32768.0f) // Unity gain, closest the codec can get
+    {
+        scaled = (float)INT16_MAX;
+    }
+
+    if ((scaled > (float)INT16_MAX) || (scaled < (float)INT16_MIN))
+    {
+        return false;
+    }
+
+    *p_coef = (int16_t)scaled;
+
+    return true;
+}
+
+/**
+ * @brief Load offloaded bands into the codec effects biquads.
+ */
+static ret_code_t eq_codec_update(void)
+{
+    codec_hal_biquad_t biquads[CODEC_HAL_BIQUAD_COUNT];
+
+    for (size_t i = 0; i < CODEC_HAL_BIQUAD_COUNT; i++)
+    {
+        eq_biquad_t biquad = {.b0 = 1.0f};
+        bool        valid  = true;
+
+        if (!eq_band_is_flat(&m_bands[i]))
+        {
+            eq_biquad_calc(&m_bands[i], &biquad);
+        }
+
+        valid &= eq_codec_coef(biquad.b0, 32768.0f, &biquads[i].n0);
+        valid &= eq_codec_coef(biquad.b1, 16384.0f, &biquads[i].n1);
+        valid &= eq_codec_coef(biquad.b2, 32768.0f, &biquads[i].n2);
+        valid &= eq_codec_coef(-biquad.a1, 16384.0f, &biquads[i].d1);
+        valid &= eq_codec_coef(-biquad.a2, 32768.0f, &biquads[i].d2);
+
+        if (!valid)
+        {
+            NRF_LOG_WARNING("Band %u does not fit codec biquad", i);
+            return NRF_ERROR_INVALID_PARAM;
+        }
+    }
+
+    return codec_hal_biquads_set(biquads);
+}
+#endif // CODEC_EQ_CODEC_OFFLOAD
+
+static void eq_process(uint32_t *p_frames, size_t frames, void *p_context)
+{
+    uint8_t bank = m_bank;
+
+    if (m_flat[bank] || (frames > CODEC_BUFFER_SIZE_WORDS))
+    {
+        m_was_flat = true;
+        return;
+    }
+
+    if (m_was_flat) // Filter state is stale after running flat
+    {
+        memset(m_left_state, 0, sizeof(m_left_state));
+        memset(m_right_state, 0, sizeof(m_right_state));
+        m_was_flat = false;
+    }
+
+    m_left.pCoeffs  = m_coefs[bank];
+    m_right.pCoeffs = m_coefs[bank];
+
+    for (size_t i = 0; i < frames; i++)
+    {
+        m_left_frames[i]  = (q31_t)(int16_t)p_frames[i] * (1 << (16 - EQ_HEADROOM_SHIFT));
+        m_right_frames[i] = (q31_t)(int16_t)(p_frames[i] >> 16) * (1 << (16 - EQ_HEADROOM_SHIFT));
+    }
+
+    arm_biquad_cascade_df1_q31(&m_left, m_left_frames, m_left_frames, frames);
+    arm_biquad_cascade_df1_q31(&m_right, m_right_frames, m_right_frames, frames);
+
+    for (size_t i = 0; i < frames; i++)
+    {
+        int32_t left  = __SSAT(m_left_frames[i] >> (16 - EQ_HEADROOM_SHIFT), 16);
+        int32_t right = __SSAT(m_right_frames[i] >> (16 - EQ_HEADROOM_SHIFT), 16);
+
+        p_frames[i] = (uint16_t)left | ((uint32_t)(uint16_t)right << 16);
+    }
+}
+
+ret_code_t codec_eq_init(void)
+{
+    for (size_t i = 0; i < CODEC_EQ_BANDS; i++)
+    {
+        m_bands[i].type      = CODEC_EQ_BAND_TYPE_PEAK;
+        m_bands[i].frequency = 1000.0f;
+        m_bands[i].gain_db   = 0.0f;
+        m_bands[i].q         = 0.707f;
+    }
+
+    m_sample_rate = CODEC_SAMPLE_RATE_DEFAULT;
+    m_bank        = 0;
+    m_was_flat    = true;
+
+    arm_biquad_cascade_df1_init_q31(&m_left, EQ_MCU_BANDS, m_coefs[0], m_left_state, EQ_POST_SHIFT);
+    arm_biquad_cascade_df1_init_q31(&m_right, EQ_MCU_BANDS, m_coefs[0], m_right_state, EQ_POST_SHIFT);
+
+    eq_bank_update();
+
+    for (size_t i = 0; i < ARRAY_SIZE(m_default_profile); i++)
+    {
+        ret_code_t err_code = codec_eq_band_set(i, &m_default_profile[i]);
+        VERIFY_SUCCESS(err_code);
+    }
+
+    return codec_dsp_stage_register(&m_eq_stage);
+}
+
+ret_code_t codec_eq_band_set(size_t band, codec_eq_band_t const *p_band)
+{
+    VERIFY_PARAM_NOT_NULL(p_band);
+
+    if ((band >= CODEC_EQ_BANDS) || (p_band->q <= 0.0f) || (p_band->frequency <= 0.0f) ||
+        (p_band->frequency >= (float)(m_sample_rate / 2)) || (fabsf(p_band->gain_db) > CODEC_EQ_GAIN_DB_MAX))
+    {
+        return NRF_ERROR_INVALID_PARAM;
+    }
+
+#if CODEC_EQ_CODEC_OFFLOAD
+    if (band < EQ_CODEC_BANDS)
+    {
+        codec_eq_band_t band_prev = m_bands[band];
+        ret_code_t      err_code;
+
+        m_bands[band] = *p_band;
+        err_code      = eq_codec_update();
+
+        if (err_code == NRF_ERROR_INVALID_STATE) // Codec not ready yet, written with the sample rate at stream start
+        {
+            err_code = NRF_SUCCESS;
+        }
+
+        if (err_code != NRF_SUCCESS)
+        {
+            m_bands[band] = band_prev;
+        }
+
+        return err_code;
+    }
+#endif
+
+    m_bands[band] = *p_band;
+
+    eq_bank_update();
+
+    return NRF_SUCCESS;
+}
+
+ret_code_t codec_eq_sample_rate_set(uint32_t sample_rate)
+{
+    m_sample_rate = sample_rate;
+
+    eq_bank_update();
+
+#if CODEC_EQ_CODEC_OFFLOAD
+    for (size_t i = 0; i < EQ_CODEC_BANDS; i++)
+    {
+        if (!eq_band_is_flat(&m_bands[i]))
+        {
+            return eq_codec_update();
+        }
+    }
+#endif
+
+    return NRF_SUCCESS;
+}
@@ -0,0 +1,67 @@
+/**
+ * @file        codec_eq.h
+ * @author      Danius Kalvaitis (danius.kalvaitis@gmail.com)
+ * @brief       Parametric equalizer processing stage.
+ * @version     0.1
+ * @date        2026-10-17
+ *
+ * @copyright   Copyright (c) Danius Kalvaitis 2026 All rights reserved
+ *
+ */
+
+#ifndef CODEC_EQ_H
+#define CODEC_EQ_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include "sdk_errors.h"
+
+#ifndef CODEC_EQ_BANDS
+#define CODEC_EQ_BANDS 4
+#endif
+
+/**
+ * @brief Run the first two bands on the codec digital effects biquads instead of the MCU
+ *
+ * Codec coefficients are limited to 16 bits, so offloaded bands only allow cuts and gentle boosts.
+ */
+#ifndef CODEC_EQ_CODEC_OFFLOAD
+#define CODEC_EQ_CODEC_OFFLOAD 0
+#endif
+
+#define CODEC_EQ_GAIN_DB_MAX 12.0f
+
+typedef enum
+{
+    CODEC_EQ_BAND_TYPE_PEAK,
+    CODEC_EQ_BAND_TYPE_LOW_SHELF,
+    CODEC_EQ_BAND_TYPE_HIGH_SHELF
+} codec_eq_band_type_t;
+
+typedef struct
+{
+    codec_eq_band_type_t type;
+    float                frequency; /**< Centre or corner frequency in Hz. */
+    float                gain_db;   /**< Band gain, 0 dB disables the band. */
+    float                q;
+} codec_eq_band_t;
+
+/**
+ * @brief Initialize equalizer with the default speaker profile and register it as a processing stage.
+ */
+ret_code_t codec_eq_init(void);
+
+/**
+ * @brief Configure an equalizer band.
+ *
+ * Coefficients are calculated in the caller context and take effect from the next processed block.
+ */
+ret_code_t codec_eq_band_set(size_t band, codec_eq_band_t const *p_band);
+
+/**
+ * @brief Recalculate coefficients for a new sample rate.
+ */
+ret_code_t codec_eq_sample_rate_set(uint32_t sample_rate);
+
+#endif // CODEC_EQ_H
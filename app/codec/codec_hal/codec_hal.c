@@ -11,10 +11,12 @@
 
 #include "codec_hal.h"
 
+#include "app_error.h"
+#include "app_scheduler.h"
 #include "app_timer.h"
 #include "boards.h"
-#include "nrf_delay.h"
 #include "nrf_gpio.h"
+#include "nrfx_i2s.h"
 #include "tlv320aic3106.h"
 
 #define NRF_LOG_MODULE_NAME codec_hal
@@ -22,32 +24,432 @@
 NRF_LOG_MODULE_REGISTER();
 
 APP_TIMER_DEF(m_config_timer);
+APP_TIMER_DEF(m_reset_timer);
+
+#define CODEC_RESET_TICKS            APP_TIMER_TICKS(100) /**< Reset hold time, the rest of boot carries on meanwhile. */
+#define CODEC_READY_POLL_MIN         APP_TIMER_TICKS(2)   /**< First power status poll after a mode switch. */
+#define CODEC_READY_POLL_MAX         APP_TIMER_TICKS(64)  /**< Poll interval is doubled up to this value. */
+#define CODEC_READY_TIMEOUT_MS       1000
+#define CODEC_LATENCY_BUCKETS        10 /**< Bucket n counts latencies below 2^(n + 1) ms, the last one collects the rest. */
+
+#define CODEC_REG_PLL_PROG_A         3  /**< PLL enable, Q and P. Followed by J, D MSB and D LSB registers. */
+#define CODEC_REG_PLL_PROG_A_EN      0x80
+#define CODEC_REG_PLL_PROG_A_Q_2     0x10
+#define CODEC_REG_PLL_PROG_A_P_1     0x01
+#define CODEC_REG_PLL_PROG_A_QP_MASK 0x7F
+#define CODEC_REG_PLL_PROG_B         4
+#define CODEC_REG_PLL_PROG_C         5
+#define CODEC_REG_PLL_PROG_D         6
+#define CODEC_REG_DIG_FILTER         12
+#define CODEC_REG_DIG_FILTER_LEFT_FX 0x08 /**< Left DAC digital effects enable. */
+#define CODEC_REG_DIG_FILTER_RGHT_FX 0x02 /**< Right DAC digital effects enable. */
+#define CODEC_REG_DAC_PWR            37
+#define CODEC_REG_DAC_PWR_LEFT       0x80
+#define CODEC_REG_DAC_PWR_RIGHT      0x40
+#define CODEC_REG_LEFT_DAC_VOL       43
+#define CODEC_REG_RIGHT_DAC_VOL      44
+#define CODEC_REG_DAC_VOL_MUTE       0x80
+#define CODEC_REG_DAC_VOL_GAIN_MASK  0x7F /**< Attenuation in 0.5 dB steps, 0 dB to -63.5 dB. */
+#define CODEC_REG_LEFT_LOP_LVL       86
+#define CODEC_REG_RIGHT_LOP_LVL      93
+#define CODEC_REG_LOP_LVL_NOT_MUTED  0x08
+#define CODEC_REG_LOP_LVL_PWR_EN     0x01
+
+#define CODEC_REG_PAGE_SELECT        0
+#define CODEC_PAGE_0                 0
+#define CODEC_PAGE_1                 1
+#define CODEC_REG_LEFT_EFFECTS       1  /**< Page 1. N0 to N5, D1, D2, D4 and D5, MSB first. */
+#define CODEC_REG_RIGHT_EFFECTS      27 /**< Page 1. Same layout as the left channel. */
+#define CODEC_EFFECTS_SIZE           (CODEC_HAL_BIQUAD_COUNT * 5 * sizeof(int16_t))
+
+#define CODEC_VOLUME_STEP            128                           /**< 0.5 dB in 1/256 dB units. */
+
+#define CODEC_REG_COUNT              (CODEC_REG_RIGHT_LOP_LVL + 1) /**< Page 0 registers held in the shadow. */
+#define CODEC_REG_FLUSH_RUNS_MAX     8                             /**< Separate register runs a single flush can write. */
+#define CODEC_REG_FLUSH_SLOTS        2                             /**< Flushes that can be queued at the same time. */
+#define CODEC_REG_FLUSH_RETRIES_MAX  3                             /**< Failed flushes in a row before retries wait for the next update. */
+
+#define CODEC_I2S_MCK_FREQ_BASE      32000000
+#define CODEC_PLL_FS_DIV             2048 /**< fs = MCLK * J.D * R / (2048 * P) */
+#define CODEC_PLL_K_SCALE            10000
 
-#define CONFIG_TIMER_TIMEOUT APP_TIMER_TICKS(250)
+/**
+ * @brief PLL J.D multiplied by 10000 for a given sample rate and MCK divider, with P = R = 1.
+ */
+#define CODEC_PLL_K(rate, mck_div)                                                                                     \
+    ((((uint64_t)(rate) * CODEC_PLL_FS_DIV * CODEC_PLL_K_SCALE * (mck_div)) + (CODEC_I2S_MCK_FREQ_BASE / 2)) /         \
+     CODEC_I2S_MCK_FREQ_BASE)
+
+/**
+ * @brief Sample rate error in ppm caused by rounding J.D.
+ */
+#define CODEC_PLL_ERROR_PPM(rate, mck_div)                                                                             \
+    ((int16_t)((((int64_t)CODEC_PLL_K(rate, mck_div) * CODEC_I2S_MCK_FREQ_BASE -                                       \
+                 (int64_t)(rate) * CODEC_PLL_FS_DIV * CODEC_PLL_K_SCALE * (mck_div)) *                                 \
+                1000000) /                                                                                             \
+               ((int64_t)(rate) * CODEC_PLL_FS_DIV * CODEC_PLL_K_SCALE * (mck_div))))
+
+#define CODEC_CLOCK_CFG(rate, mck, mck_div)                                                                            \
+    {                                                                                                                  \
+        .sample_rate = (rate), .mck_setup = (mck), .j = CODEC_PLL_K(rate, mck_div) / CODEC_PLL_K_SCALE,                \
+        .d = CODEC_PLL_K(rate, mck_div) % CODEC_PLL_K_SCALE, .error_ppm = CODEC_PLL_ERROR_PPM(rate, mck_div)           \
+    }
+
+typedef struct
+{
+    uint32_t sample_rate;
+    uint32_t mck_setup; /**< I2S MCK setup the PLL configuration is calculated for. */
+    uint8_t  j;
+    uint16_t d;
+    int16_t  error_ppm;
+} codec_clock_cfg_t;
+
+/**
+ * @brief Codec PLL configurations. Only MCK frequencies between 10 MHz and 20 MHz are usable with P = 1.
+ */
+static codec_clock_cfg_t const m_clock_cfgs[] = {
+  CODEC_CLOCK_CFG(44100, NRF_I2S_MCK_32MDIV2, 2),
+  CODEC_CLOCK_CFG(48000, NRF_I2S_MCK_32MDIV2, 2),
+  CODEC_CLOCK_CFG(44100, NRF_I2S_MCK_32MDIV3, 3),
+  CODEC_CLOCK_CFG(48000, NRF_I2S_MCK_32MDIV3, 3),
+};
 
 TLV320AIC3106_DEF(m_tlv320aic3106, NULL, DK_BSP_TLV320_I2C_ADDRESS);
 
+/**
+ * @brief Register writes queued with a single TWI manager transaction.
+ *
+ * Each run of consecutive modified registers becomes one auto-increment burst, register address followed by data.
+ * Dirty bits move into the slot while the transaction is in flight and go back to the shadow if it fails.
+ */
+typedef struct
+{
+    uint8_t                   data[CODEC_REG_COUNT + CODEC_REG_FLUSH_RUNS_MAX];
+    uint8_t                   dirty[CODEC_REG_COUNT]; /**< Bits written by this flush. */
+    dk_twi_mngr_transfer_t    transfers[CODEC_REG_FLUSH_RUNS_MAX];
+    dk_twi_mngr_transaction_t transaction;
+    ret_code_t                result;
+    volatile bool             pending;
+} codec_reg_flush_t;
+
+typedef struct
+{
+    uint32_t flushes;
+    uint32_t transfers;
+    uint32_t bytes;
+} codec_reg_stats_t;
+
 static codec_mode_t            m_codec_mode;
-static codec_hal_evt_handler_t m_evt_handler = NULL;
+static codec_hal_evt_handler_t m_evt_handler   = NULL;
+static codec_mode_t            m_deferred_mode = CODEC_MODE_OFF; /**< Mode requested before the codec was ready. */
+static bool                    m_ready;                          /**< Out of reset, register file is shadowed. */
+static bool                    m_mode_switch_pending;
+static uint32_t                m_mode_switch_start; /**< RTC counter value when the mode switch was requested. */
+static uint32_t                m_ready_poll_interval;
+static uint16_t                m_latency_histogram[CODEC_LATENCY_BUCKETS];
+
+/* Page 0 register shadow. Registers kept here are only written through codec_reg_update() after init. */
+static uint8_t           m_reg_shadow[CODEC_REG_COUNT];
+static uint8_t           m_reg_read[CODEC_REG_COUNT];  /**< Register file as read after reset. */
+static uint8_t           m_reg_dirty[CODEC_REG_COUNT]; /**< Bits changed in the shadow but not written yet. */
+static volatile bool     m_reg_shadow_valid;
+static codec_reg_flush_t m_reg_flush[CODEC_REG_FLUSH_SLOTS];
+static codec_reg_stats_t m_reg_stats;
+static uint8_t           m_reg_flush_failures; /**< Failed flushes in a row. */
+
+static uint8_t const m_page_1_select[] = {CODEC_REG_PAGE_SELECT, CODEC_PAGE_1};
+static uint8_t const m_page_0_select[] = {CODEC_REG_PAGE_SELECT, CODEC_PAGE_0};
+static uint8_t       m_left_effects[1 + CODEC_EFFECTS_SIZE];
+static uint8_t       m_right_effects[1 + CODEC_EFFECTS_SIZE];
+static volatile bool m_effects_pending;
+
+/* Page 0 is selected again within the same transaction, so the page 0 shadow stays valid. */
+static dk_twi_mngr_transfer_t const m_effects_transfers[] = {
+  DK_TWI_MNGR_WRITE(DK_BSP_TLV320_I2C_ADDRESS, m_page_1_select, sizeof(m_page_1_select), 0),
+  DK_TWI_MNGR_WRITE(DK_BSP_TLV320_I2C_ADDRESS, m_left_effects, sizeof(m_left_effects), 0),
+  DK_TWI_MNGR_WRITE(DK_BSP_TLV320_I2C_ADDRESS, m_right_effects, sizeof(m_right_effects), 0),
+  DK_TWI_MNGR_WRITE(DK_BSP_TLV320_I2C_ADDRESS, m_page_0_select, sizeof(m_page_0_select), 0)};
+
+static uint8_t const m_reg_shadow_start = 0;
+
+static dk_twi_mngr_transfer_t const m_reg_shadow_read_transfers[] = {
+  DK_TWI_MNGR_WRITE(DK_BSP_TLV320_I2C_ADDRESS, &m_reg_shadow_start, sizeof(m_reg_shadow_start), DK_TWI_MNGR_NO_STOP),
+  DK_TWI_MNGR_READ(DK_BSP_TLV320_I2C_ADDRESS, m_reg_read, sizeof(m_reg_read), 0)};
 
 static void codec_pins_init(void)
 {
     nrf_gpio_cfg_output(DK_BSP_TLV320_RST);
     nrf_gpio_pin_clear(DK_BSP_TLV320_RST);
-    nrf_delay_ms(100);
-    nrf_gpio_pin_set(DK_BSP_TLV320_RST);
 }
 
-static ret_code_t codec_clk_init(void)
+static codec_clock_cfg_t const *codec_clock_cfg_get(uint32_t sample_rate)
+{
+    for (size_t i = 0; i < ARRAY_SIZE(m_clock_cfgs); i++)
+    {
+        if ((m_clock_cfgs[i].sample_rate == sample_rate) && (m_clock_cfgs[i].mck_setup == NRFX_I2S_CONFIG_MCK_SETUP))
+        {
+            return &m_clock_cfgs[i];
+        }
+    }
+
+    return NULL;
+}
+
+static ret_code_t codec_reg_flush(void);
+
+/**
+ * @brief Finish init once the register file has been read. Runs from the scheduler, same as all register updates.
+ */
+static void codec_ready_handler(void *p_event_data, uint16_t event_size)
+{
+    ret_code_t   err_code;
+    codec_mode_t mode = m_deferred_mode;
+
+    // Bits updated before the read are kept and written by the flush below
+    for (size_t i = 0; i < CODEC_REG_COUNT; i++)
+    {
+        m_reg_shadow[i] = (m_reg_read[i] & ~m_reg_dirty[i]) | (m_reg_shadow[i] & m_reg_dirty[i]);
+    }
+
+    m_reg_shadow_valid = true;
+    m_ready            = true;
+    m_deferred_mode    = CODEC_MODE_OFF;
+
+    err_code = codec_reg_flush();
+
+    if (err_code != NRF_SUCCESS)
+    {
+        NRF_LOG_ERROR("Could not flush deferred register updates %u", err_code);
+    }
+
+    m_evt_handler(CODEC_EVT_TYPE_READY);
+
+    if (mode == CODEC_MODE_BYPASS) // Already configured for bypass
+    {
+        m_evt_handler(CODEC_EVT_TYPE_BYPASS_MODE_READY);
+    } else if (mode != CODEC_MODE_OFF)
+    {
+        err_code = codec_hal_mode_set(mode);
+
+        if (err_code != NRF_SUCCESS)
+        {
+            NRF_LOG_ERROR("Could not set deferred codec mode %u", err_code);
+        }
+    }
+}
+
+static void codec_reg_shadow_read_callback(ret_code_t result, void *p_user_data)
 {
     ret_code_t err_code;
 
+    if (result != NRF_SUCCESS)
+    {
+        NRF_LOG_ERROR("Register shadow read failed %u", result);
+        return;
+    }
+
+    err_code = app_sched_event_put(NULL, 0, codec_ready_handler);
+    APP_ERROR_CHECK(err_code);
+}
+
+/**
+ * @brief Read the whole page 0 register file into the shadow with one auto-increment read.
+ */
+static ret_code_t codec_reg_shadow_read(void)
+{
+    static dk_twi_mngr_transaction_t const transaction = {
+      .callback            = codec_reg_shadow_read_callback,
+      .p_user_data         = NULL,
+      .p_transfers         = m_reg_shadow_read_transfers,
+      .number_of_transfers = ARRAY_SIZE(m_reg_shadow_read_transfers),
+      .p_required_twi_cfg  = NULL};
+
+    m_reg_shadow_valid = false;
+
+    return dk_twi_mngr_schedule(m_tlv320aic3106.p_dk_twi_mngr_instance, &transaction);
+}
+
+/**
+ * @brief Update bits of a shadowed register. Nothing is sent until codec_reg_flush() is called.
+ */
+static void codec_reg_update(uint8_t reg, uint8_t mask, uint8_t value)
+{
+    uint8_t reg_value = (m_reg_shadow[reg] & ~mask) | (value & mask);
+
+    if ((reg_value != m_reg_shadow[reg]) || !m_reg_shadow_valid)
+    {
+        m_reg_shadow[reg] = reg_value;
+        m_reg_dirty[reg] |= mask;
+    }
+}
+
+/**
+ * @brief Hand the bits of a flush that did not make it to the codec back to the shadow.
+ */
+static void codec_reg_flush_restore(codec_reg_flush_t *p_flush)
+{
+    for (size_t i = 0; i < CODEC_REG_COUNT; i++)
+    {
+        m_reg_dirty[i] |= p_flush->dirty[i];
+    }
+}
+
+/**
+ * @brief Flush completion, runs from the scheduler so the dirty bits are only touched from one context.
+ */
+static void codec_reg_flush_done_handler(void *p_event_data, uint16_t event_size)
+{
+    ret_code_t         err_code;
+    codec_reg_flush_t *p_flush = *(codec_reg_flush_t **)p_event_data;
+
+    if (p_flush->result != NRF_SUCCESS)
+    {
+        NRF_LOG_ERROR("Register flush failed %u", p_flush->result);
+
+        codec_reg_flush_restore(p_flush);
+        m_reg_flush_failures++;
+    } else
+    {
+        m_reg_flush_failures = 0;
+    }
+
+    p_flush->pending = false;
+
+    if (m_reg_flush_failures >= CODEC_REG_FLUSH_RETRIES_MAX)
+    {
+        return; // Left dirty, the next register update tries again
+    }
+
+    // Updates made while both slots were in flight
+    err_code = codec_reg_flush();
+
+    if (err_code != NRF_SUCCESS)
+    {
+        NRF_LOG_ERROR("Could not flush register updates %u", err_code);
+    }
+}
+
+static void codec_reg_flush_callback(ret_code_t result, void *p_user_data)
+{
+    ret_code_t         err_code;
+    codec_reg_flush_t *p_flush = (codec_reg_flush_t *)p_user_data;
+
+    p_flush->result = result;
+
+    err_code = app_sched_event_put(&p_flush, sizeof(p_flush), codec_reg_flush_done_handler);
+    APP_ERROR_CHECK(err_code);
+}
+
+/**
+ * @brief Write all modified shadow registers to the codec.
+ *
+ * Consecutive modified registers are merged into auto-increment bursts and all bursts are queued as one transaction,
+ * so they are sent in order with respect to other codec transactions. With both slots in flight the bits stay dirty
+ * and are written when one of them completes.
+ */
+static ret_code_t codec_reg_flush(void)
+{
+    ret_code_t         err_code;
+    codec_reg_flush_t *p_flush   = NULL;
+    size_t             data_size = 0;
+    uint8_t            transfers = 0;
+    uint8_t            reg       = 0;
+
+    if (!m_reg_shadow_valid)
+    {
+        return NRF_SUCCESS; // Kept in the shadow, flushed once the register file has been read
+    }
+
+    for (size_t i = 0; i < ARRAY_SIZE(m_reg_flush); i++)
+    {
+        if (!m_reg_flush[i].pending)
+        {
+            p_flush = &m_reg_flush[i];
+            break;
+        }
+    }
+
+    if (p_flush == NULL)
+    {
+        return NRF_SUCCESS;
+    }
+
+    memset(p_flush->dirty, 0, sizeof(p_flush->dirty));
+
+    while (reg < CODEC_REG_COUNT)
+    {
+        uint8_t *p_run = &p_flush->data[data_size];
+        size_t   run_size;
+
+        if (!m_reg_dirty[reg])
+        {
+            reg++;
+            continue;
+        }
+
+        if (transfers == CODEC_REG_FLUSH_RUNS_MAX) // Remaining registers stay dirty for the next flush
+        {
+            break;
+        }
+
+        p_flush->data[data_size++] = reg;
+
+        while ((reg < CODEC_REG_COUNT) && m_reg_dirty[reg])
+        {
+            p_flush->data[data_size++] = m_reg_shadow[reg];
+            p_flush->dirty[reg]        = m_reg_dirty[reg];
+            m_reg_dirty[reg]           = 0;
+            reg++;
+        }
+
+        run_size = &p_flush->data[data_size] - p_run;
+
+        p_flush->transfers[transfers++] =
+          (dk_twi_mngr_transfer_t)DK_TWI_MNGR_WRITE(DK_BSP_TLV320_I2C_ADDRESS, p_run, run_size, 0);
+    }
+
+    if (transfers == 0)
+    {
+        return NRF_SUCCESS;
+    }
+
+    p_flush->transaction.callback            = codec_reg_flush_callback;
+    p_flush->transaction.p_user_data         = p_flush;
+    p_flush->transaction.p_transfers         = p_flush->transfers;
+    p_flush->transaction.number_of_transfers = transfers;
+    p_flush->transaction.p_required_twi_cfg  = NULL;
+
+    p_flush->pending = true;
+
+    err_code = dk_twi_mngr_schedule(m_tlv320aic3106.p_dk_twi_mngr_instance, &p_flush->transaction);
+
+    if (err_code != NRF_SUCCESS)
+    {
+        codec_reg_flush_restore(p_flush);
+        p_flush->pending = false;
+        return err_code;
+    }
+
+    m_reg_stats.flushes++;
+    m_reg_stats.transfers += transfers;
+    m_reg_stats.bytes += data_size;
+
+    return NRF_SUCCESS;
+}
+
+static ret_code_t codec_clk_init(void)
+{
+    ret_code_t                 err_code;
     tlv320aic3106_pll_config_t pll_config;
+    codec_clock_cfg_t const   *p_clock_cfg = codec_clock_cfg_get(CODEC_SAMPLE_RATE_DEFAULT);
+
+    VERIFY_PARAM_NOT_NULL(p_clock_cfg);
+
     memset(&pll_config, 0, sizeof(pll_config));
 
     pll_config.p = TLV320AIC3106_PLL_P_1;
-    pll_config.j = 5;
-    pll_config.d = 6448;
+    pll_config.j = p_clock_cfg->j;
+    pll_config.d = p_clock_cfg->d;
     pll_config.r = 1;
 
     err_code = tlv320aic3106_pll_init(&m_tlv320aic3106, &pll_config);
@@ -165,49 +567,90 @@ static ret_code_t codec_lop_init(void)
 static ret_code_t codec_bypass_mode_enable(bool bypass)
 {
     ret_code_t err_code;
+    uint8_t    dac_pwr = bypass ? 0 : (CODEC_REG_DAC_PWR_LEFT | CODEC_REG_DAC_PWR_RIGHT);
+    uint8_t    lop_lvl = bypass ? 0 : (CODEC_REG_LOP_LVL_NOT_MUTED | CODEC_REG_LOP_LVL_PWR_EN);
 
-    err_code = tlv320aic3106_set_left_lop_m_out_mute(&m_tlv320aic3106, true);
-    VERIFY_SUCCESS(err_code);
+    // Outputs have to be muted before the signal path changes
+    codec_reg_update(CODEC_REG_LEFT_LOP_LVL, CODEC_REG_LOP_LVL_NOT_MUTED, 0);
+    codec_reg_update(CODEC_REG_RIGHT_LOP_LVL, CODEC_REG_LOP_LVL_NOT_MUTED, 0);
 
-    err_code = tlv320aic3106_set_right_lop_m_out_mute(&m_tlv320aic3106, true);
+    err_code = codec_reg_flush();
     VERIFY_SUCCESS(err_code);
 
     err_code = tlv320aic3106_set_line1_bypass(&m_tlv320aic3106, bypass);
     VERIFY_SUCCESS(err_code);
 
-    err_code = tlv320aic3106_pll_enable(&m_tlv320aic3106, !bypass);
-    VERIFY_SUCCESS(err_code);
+    codec_reg_update(CODEC_REG_PLL_PROG_A, CODEC_REG_PLL_PROG_A_EN, bypass ? 0 : CODEC_REG_PLL_PROG_A_EN);
+    codec_reg_update(CODEC_REG_DAC_PWR, CODEC_REG_DAC_PWR_LEFT | CODEC_REG_DAC_PWR_RIGHT, dac_pwr);
+    codec_reg_update(CODEC_REG_LEFT_DAC_VOL, CODEC_REG_DAC_VOL_MUTE, bypass ? CODEC_REG_DAC_VOL_MUTE : 0);
+    codec_reg_update(CODEC_REG_RIGHT_DAC_VOL, CODEC_REG_DAC_VOL_MUTE, bypass ? CODEC_REG_DAC_VOL_MUTE : 0);
+    codec_reg_update(CODEC_REG_LEFT_LOP_LVL, CODEC_REG_LOP_LVL_NOT_MUTED | CODEC_REG_LOP_LVL_PWR_EN, lop_lvl);
+    codec_reg_update(CODEC_REG_RIGHT_LOP_LVL, CODEC_REG_LOP_LVL_NOT_MUTED | CODEC_REG_LOP_LVL_PWR_EN, lop_lvl);
 
-    err_code = tlv320aic3106_set_dac_pwr(&m_tlv320aic3106, !bypass, !bypass);
-    VERIFY_SUCCESS(err_code);
+    return codec_reg_flush();
+}
 
-    err_code = tlv320aic3106_set_dac_mute(&m_tlv320aic3106, bypass);
-    VERIFY_SUCCESS(err_code);
+static bool codec_check_bypass_ready(tlv320aic3106_module_pwr_status_t *p_module_pwr_status)
+{
+    if (p_module_pwr_status->left_dac_powered_up && p_module_pwr_status->right_dac_powered_up &&
+        p_module_pwr_status->left_lop_m_powered_up && p_module_pwr_status->right_lop_m_powered_up)
+    {
+        return false;
+    }
 
-    err_code = tlv320aic3106_set_left_lop_m_out_pwr_en(&m_tlv320aic3106, !bypass);
-    VERIFY_SUCCESS(err_code);
+    return true;
+}
 
-    err_code = tlv320aic3106_set_right_lop_m_out_pwr_en(&m_tlv320aic3106, !bypass);
-    VERIFY_SUCCESS(err_code);
+static uint32_t codec_mode_switch_elapsed_ms(void)
+{
+    uint32_t ticks = app_timer_cnt_diff_compute(app_timer_cnt_get(), m_mode_switch_start);
 
-    err_code = tlv320aic3106_set_left_lop_m_out_mute(&m_tlv320aic3106, bypass);
-    VERIFY_SUCCESS(err_code);
+    return (uint32_t)(((uint64_t)ticks * 1000) / APP_TIMER_CLOCK_FREQ);
+}
 
-    err_code = tlv320aic3106_set_right_lop_m_out_mute(&m_tlv320aic3106, bypass);
-    VERIFY_SUCCESS(err_code);
+static void codec_latency_record(uint32_t latency_ms)
+{
+    size_t bucket = 0;
 
-    return NRF_SUCCESS;
+    while ((bucket < (CODEC_LATENCY_BUCKETS - 1)) && ((latency_ms >> (bucket + 1)) != 0))
+    {
+        bucket++;
+    }
+
+    if (m_latency_histogram[bucket] < UINT16_MAX)
+    {
+        m_latency_histogram[bucket]++;
+    }
+
+    NRF_LOG_INFO("Codec mode switch took %u ms", latency_ms);
 }
 
-static bool codec_check_bypass_ready(tlv320aic3106_module_pwr_status_t *p_module_pwr_status)
+/**
+ * @brief Schedule the next power status poll, backing off exponentially, or give up once the timeout expires.
+ */
+static void codec_ready_poll_next(void)
 {
-    if (p_module_pwr_status->left_dac_powered_up && p_module_pwr_status->right_dac_powered_up &&
-        p_module_pwr_status->left_lop_m_powered_up && p_module_pwr_status->right_lop_m_powered_up)
+    ret_code_t err_code;
+
+    if (codec_mode_switch_elapsed_ms() >= CODEC_READY_TIMEOUT_MS)
     {
-        return false;
+        NRF_LOG_ERROR("Codec mode switch timed out");
+        m_mode_switch_pending = false;
+        m_evt_handler(CODEC_EVT_TYPE_MODE_TIMEOUT);
+        return;
     }
 
-    return true;
+    err_code = app_timer_start(m_config_timer, m_ready_poll_interval, NULL);
+
+    if (err_code != NRF_SUCCESS)
+    {
+        NRF_LOG_ERROR("Could not start codec config timer %u", err_code);
+        m_mode_switch_pending = false;
+        m_evt_handler(CODEC_EVT_TYPE_MODE_TIMEOUT);
+        return;
+    }
+
+    m_ready_poll_interval = MIN(m_ready_poll_interval * 2, CODEC_READY_POLL_MAX);
 }
 
 static void codec_evt_handler(tlv320aic3106_evt_t *p_evt)
@@ -216,19 +659,34 @@ static void codec_evt_handler(tlv320aic3106_evt_t *p_evt)
     {
         case TLV320AIC3106_EVT_TYPE_ERROR:
             NRF_LOG_ERROR("TLV30AIC3106 error %u", p_evt->params.err_code);
+
+            if (m_mode_switch_pending)
+            {
+                codec_ready_poll_next();
+            }
             break;
         case TLV320AIC3106_EVT_TYPE_RX_MODULE_PWR_STATUS:
             {
                 bool bypass_mode_ready = codec_check_bypass_ready(p_evt->params.p_module_pwr_status);
 
+                if (!m_mode_switch_pending)
+                {
+                    break;
+                }
+
                 if ((m_codec_mode == CODEC_MODE_BYPASS) && bypass_mode_ready)
                 {
-                    app_timer_stop(m_config_timer);
+                    m_mode_switch_pending = false;
+                    codec_latency_record(codec_mode_switch_elapsed_ms());
                     m_evt_handler(CODEC_EVT_TYPE_BYPASS_MODE_READY);
                 } else if ((m_codec_mode == CODEC_MODE_I2S) && !bypass_mode_ready)
                 {
-                    app_timer_stop(m_config_timer);
+                    m_mode_switch_pending = false;
+                    codec_latency_record(codec_mode_switch_elapsed_ms());
                     m_evt_handler(CODEC_EVT_TYPE_I2S_MODE_READY);
+                } else
+                {
+                    codec_ready_poll_next();
                 }
             }
             break;
@@ -237,24 +695,22 @@ static void codec_evt_handler(tlv320aic3106_evt_t *p_evt)
     }
 }
 
-static void codec_config_timer_handler(void *p_context) { tlv320aic3106_get_module_power_status(&m_tlv320aic3106); }
-
-ret_code_t codec_hal_init(dk_twi_mngr_t const *p_dk_twi_mngr, codec_hal_evt_handler_t evt_handler)
+static void codec_config_timer_handler(void *p_context)
 {
-    ret_code_t err_code;
+    ret_code_t err_code = tlv320aic3106_get_module_power_status(&m_tlv320aic3106);
 
-    VERIFY_PARAM_NOT_NULL(p_dk_twi_mngr);
-    VERIFY_PARAM_NOT_NULL(evt_handler);
-
-    m_tlv320aic3106.p_dk_twi_mngr_instance = p_dk_twi_mngr;
-    m_evt_handler                          = evt_handler;
-
-    m_codec_mode = CODEC_MODE_BYPASS;
-
-    codec_pins_init();
+    if (err_code != NRF_SUCCESS)
+    {
+        codec_ready_poll_next();
+    }
+}
 
-    err_code = app_timer_create(&m_config_timer, APP_TIMER_MODE_REPEATED, codec_config_timer_handler);
-    VERIFY_SUCCESS(err_code);
+/**
+ * @brief Configure the codec for bypass once it is out of reset. Register writes are queued, nothing blocks here.
+ */
+static ret_code_t codec_config(void)
+{
+    ret_code_t err_code;
 
     err_code = tlv320aic3106_init(&m_tlv320aic3106, codec_evt_handler);
     VERIFY_SUCCESS(err_code);
@@ -274,13 +730,59 @@ ret_code_t codec_hal_init(dk_twi_mngr_t const *p_dk_twi_mngr, codec_hal_evt_hand
     err_code = codec_lop_init();
     VERIFY_SUCCESS(err_code);
 
+    err_code = codec_reg_shadow_read();
+    VERIFY_SUCCESS(err_code);
+
     return NRF_SUCCESS;
 }
 
+static void codec_reset_timer_handler(void *p_context)
+{
+    ret_code_t err_code;
+
+    nrf_gpio_pin_set(DK_BSP_TLV320_RST);
+
+    err_code = codec_config();
+    APP_ERROR_CHECK(err_code);
+}
+
+ret_code_t codec_hal_init(dk_twi_mngr_t const *p_dk_twi_mngr, codec_hal_evt_handler_t evt_handler)
+{
+    ret_code_t err_code;
+
+    VERIFY_PARAM_NOT_NULL(p_dk_twi_mngr);
+    VERIFY_PARAM_NOT_NULL(evt_handler);
+
+    m_tlv320aic3106.p_dk_twi_mngr_instance = p_dk_twi_mngr;
+    m_evt_handler                          = evt_handler;
+
+    m_codec_mode       = CODEC_MODE_BYPASS;
+    m_ready            = false;
+    m_reg_shadow_valid = false;
+    m_deferred_mode    = CODEC_MODE_OFF;
+
+    codec_pins_init();
+
+    err_code = app_timer_create(&m_config_timer, APP_TIMER_MODE_SINGLE_SHOT, codec_config_timer_handler);
+    VERIFY_SUCCESS(err_code);
+
+    err_code = app_timer_create(&m_reset_timer, APP_TIMER_MODE_SINGLE_SHOT, codec_reset_timer_handler);
+    VERIFY_SUCCESS(err_code);
+
+    // Codec is configured from the timer handler, CODEC_EVT_TYPE_READY follows
+    return app_timer_start(m_reset_timer, CODEC_RESET_TICKS, NULL);
+}
+
 ret_code_t codec_hal_mode_set(codec_mode_t mode)
 {
     ret_code_t err_code;
 
+    if (!m_ready)
+    {
+        m_deferred_mode = mode; // Applied once the codec is configured
+        return NRF_SUCCESS;
+    }
+
     if (m_codec_mode == mode)
     {
         return NRF_SUCCESS;
@@ -300,9 +802,14 @@ ret_code_t codec_hal_mode_set(codec_mode_t mode)
 
     VERIFY_SUCCESS(err_code);
 
-    m_codec_mode = mode;
+    m_codec_mode          = mode;
+    m_mode_switch_pending = true;
+    m_mode_switch_start   = app_timer_cnt_get();
+    m_ready_poll_interval = CODEC_READY_POLL_MIN;
+
+    app_timer_stop(m_config_timer);
 
-    err_code = app_timer_start(m_config_timer, CONFIG_TIMER_TIMEOUT, NULL);
+    err_code = app_timer_start(m_config_timer, m_ready_poll_interval, NULL);
     VERIFY_SUCCESS(err_code);
 
     return NRF_SUCCESS;
@@ -310,15 +817,142 @@ ret_code_t codec_hal_mode_set(codec_mode_t mode)
 
 ret_code_t codec_hal_mute(bool mute)
 {
+    uint8_t lop_lvl = mute ? 0 : CODEC_REG_LOP_LVL_NOT_MUTED;
+
+    codec_reg_update(CODEC_REG_LEFT_LOP_LVL, CODEC_REG_LOP_LVL_NOT_MUTED, lop_lvl);
+    codec_reg_update(CODEC_REG_RIGHT_LOP_LVL, CODEC_REG_LOP_LVL_NOT_MUTED, lop_lvl);
+
+    return codec_reg_flush();
+}
+
+ret_code_t codec_hal_volume_set(int16_t volume)
+{
+    int32_t attenuation = (-(int32_t)volume + (CODEC_VOLUME_STEP / 2)) / CODEC_VOLUME_STEP;
+
+    attenuation = MAX(attenuation, 0);
+    attenuation = MIN(attenuation, CODEC_REG_DAC_VOL_GAIN_MASK);
+
+    // DAC volume soft-stepping smooths out the change
+    codec_reg_update(CODEC_REG_LEFT_DAC_VOL, CODEC_REG_DAC_VOL_GAIN_MASK, (uint8_t)attenuation);
+    codec_reg_update(CODEC_REG_RIGHT_DAC_VOL, CODEC_REG_DAC_VOL_GAIN_MASK, (uint8_t)attenuation);
+
+    return codec_reg_flush();
+}
+
+static void codec_effects_callback(ret_code_t result, void *p_user_data)
+{
+    m_effects_pending = false;
+
+    if (result != NRF_SUCCESS)
+    {
+        NRF_LOG_ERROR("Effects update failed %u", result);
+    }
+}
+
+static uint8_t *codec_coef_encode(int16_t coef, uint8_t *p_data)
+{
+    *p_data++ = (uint8_t)((uint16_t)coef >> 8);
+    *p_data++ = (uint8_t)coef;
+
+    return p_data;
+}
+
+ret_code_t codec_hal_biquads_set(codec_hal_biquad_t const *p_biquads)
+{
+    static dk_twi_mngr_transaction_t const transaction = {.callback            = codec_effects_callback,
+                                                          .p_user_data         = NULL,
+                                                          .p_transfers         = m_effects_transfers,
+                                                          .number_of_transfers = ARRAY_SIZE(m_effects_transfers),
+                                                          .p_required_twi_cfg  = NULL};
+
     ret_code_t err_code;
+    uint8_t   *p_data = &m_left_effects[1];
 
-    err_code = tlv320aic3106_set_left_lop_m_out_mute(&m_tlv320aic3106, mute);
-    VERIFY_SUCCESS(err_code);
+    VERIFY_PARAM_NOT_NULL(p_biquads);
+
+    if (!m_ready)
+    {
+        return NRF_ERROR_INVALID_STATE;
+    }
 
-    err_code = tlv320aic3106_set_right_lop_m_out_mute(&m_tlv320aic3106, mute);
+    if (m_effects_pending)
+    {
+        return NRF_ERROR_BUSY;
+    }
+
+    // Numerators of both biquads come first, then denominators
+    for (size_t i = 0; i < CODEC_HAL_BIQUAD_COUNT; i++)
+    {
+        p_data = codec_coef_encode(p_biquads[i].n0, p_data);
+        p_data = codec_coef_encode(p_biquads[i].n1, p_data);
+        p_data = codec_coef_encode(p_biquads[i].n2, p_data);
+    }
+
+    for (size_t i = 0; i < CODEC_HAL_BIQUAD_COUNT; i++)
+    {
+        p_data = codec_coef_encode(p_biquads[i].d1, p_data);
+        p_data = codec_coef_encode(p_biquads[i].d2, p_data);
+    }
+
+    m_left_effects[0]  = CODEC_REG_LEFT_EFFECTS;
+    m_right_effects[0] = CODEC_REG_RIGHT_EFFECTS;
+    memcpy(&m_right_effects[1], &m_left_effects[1], CODEC_EFFECTS_SIZE);
+
+    m_effects_pending = true;
+
+    err_code = dk_twi_mngr_schedule(m_tlv320aic3106.p_dk_twi_mngr_instance, &transaction);
+
+    if (err_code != NRF_SUCCESS)
+    {
+        m_effects_pending = false;
+        return err_code;
+    }
+
+    // Queued after the coefficients, so the filters are enabled with valid coefficients in place
+    codec_reg_update(CODEC_REG_DIG_FILTER,
+                     CODEC_REG_DIG_FILTER_LEFT_FX | CODEC_REG_DIG_FILTER_RGHT_FX,
+                     CODEC_REG_DIG_FILTER_LEFT_FX | CODEC_REG_DIG_FILTER_RGHT_FX);
+
+    return codec_reg_flush();
+}
+
+ret_code_t codec_hal_clock_set(uint32_t sample_rate)
+{
+    ret_code_t               err_code;
+    codec_clock_cfg_t const *p_clock_cfg = codec_clock_cfg_get(sample_rate);
+
+    if (p_clock_cfg == NULL)
+    {
+        return NRF_ERROR_NOT_SUPPORTED;
+    }
+
+    // PLL enable bit is left as is, PLL is only running in I2S mode
+    codec_reg_update(CODEC_REG_PLL_PROG_A,
+                     CODEC_REG_PLL_PROG_A_QP_MASK,
+                     CODEC_REG_PLL_PROG_A_Q_2 | CODEC_REG_PLL_PROG_A_P_1);
+    codec_reg_update(CODEC_REG_PLL_PROG_B, 0xFC, p_clock_cfg->j << 2);
+    codec_reg_update(CODEC_REG_PLL_PROG_C, 0xFF, p_clock_cfg->d >> 6);
+    codec_reg_update(CODEC_REG_PLL_PROG_D, 0xFC, (p_clock_cfg->d & 0x3F) << 2);
+
+    err_code = codec_reg_flush();
     VERIFY_SUCCESS(err_code);
 
+    NRF_LOG_INFO("Clock set to %u Hz, error %d ppm", sample_rate, p_clock_cfg->error_ppm);
+
     return NRF_SUCCESS;
 }
 
-void codec_hal_debug(void) { tlv320aic3106_debug(&m_tlv320aic3106); }
+void codec_hal_debug(void)
+{
+    NRF_LOG_INFO("Register flushes %u, bursts %u, bytes %u",
+                 m_reg_stats.flushes,
+                 m_reg_stats.transfers,
+                 m_reg_stats.bytes);
+
+    for (size_t i = 0; i < CODEC_LATENCY_BUCKETS; i++)
+    {
+        NRF_LOG_INFO("Mode switch latency < %u ms: %u", 2 << i, m_latency_histogram[i]);
+    }
+
+    tlv320aic3106_debug(&m_tlv320aic3106);
+}
@@ -15,6 +15,22 @@
 #include "codec_common.h"
 #include "dk_twi_mngr.h"
 
+#define CODEC_HAL_BIQUAD_COUNT 2 /**< Biquads in the codec digital effects block of each channel. */
+
+/**
+ * @brief Codec effects biquad coefficients in codec format.
+ *
+ * H(z) = (N0 + 2 * N1 * z^-1 + N2 * z^-2) / (32768 - 2 * D1 * z^-1 - D2 * z^-2)
+ */
+typedef struct
+{
+    int16_t n0;
+    int16_t n1;
+    int16_t n2;
+    int16_t d1;
+    int16_t d2;
+} codec_hal_biquad_t;
+
 typedef void (*codec_hal_evt_handler_t)(codec_evt_type_t event_type);
 
 ret_code_t codec_hal_init(dk_twi_mngr_t const *p_dk_twi_mngr, codec_hal_evt_handler_t evt_handler);
@@ -23,6 +39,25 @@ ret_code_t codec_hal_mode_set(codec_mode_t mode);
 
 ret_code_t codec_hal_mute(bool mute);
 
+/**
+ * @brief Set DAC digital volume.
+ *
+ * @param[in] volume Volume in 1/256 dB units, 0 dB to -63.5 dB. Rounded to 0.5 dB steps.
+ */
+ret_code_t codec_hal_volume_set(int16_t volume);
+
+/**
+ * @brief Load codec digital effects biquads for both channels and enable the effects block.
+ *
+ * @param[in] p_biquads @ref CODEC_HAL_BIQUAD_COUNT biquads.
+ */
+ret_code_t codec_hal_biquads_set(codec_hal_biquad_t const *p_biquads);
+
+/**
+ * @brief Switch codec PLL to a given sample rate with a single register burst.
+ */
+ret_code_t codec_hal_clock_set(uint32_t sample_rate);
+
 void codec_hal_debug(void);
 
 #endif // CODEC_HAL_H
@@ -0,0 +1,184 @@
+/**
+ * @file        codec_limiter.c
+ * @author      Danius Kalvaitis (danius.kalvaitis@gmail.com)
+ * @brief       Look-ahead peak limiter processing stage.
+ * @version     0.1
+ * @date        2026-10-17
+ *
+ * @copyright   Copyright (c) Danius Kalvaitis 2026 All rights reserved
+ *
+ */
+
+#include "codec_limiter.h"
+
+#include "codec_buffer.h"
+#include "codec_common.h"
+#include "codec_dsp.h"
+#include "sdk_common.h"
+
+#define NRF_LOG_MODULE_NAME codec_limiter
+#include "nrf_log.h"
+NRF_LOG_MODULE_REGISTER();
+
+#include "codec_rt.h" // Must stay the last include, poisons blocking calls
+
+#define LIMITER_GAIN_UNITY      (1 << 15) /**< Gains and thresholds are in Q15 format. */
+#define LIMITER_LOOKAHEAD_SHIFT 5
+#define LIMITER_RELEASE_SHIFT   6     /**< Gain recovers 1/64 of the remaining distance per look-ahead window. */
+#define LIMITER_THRESHOLD_MAX   29205 /**< -1 dBFS. */
+#define LIMITER_THRESHOLD_MIN   16423 /**< -6 dBFS. */
+#define LIMITER_STEP_DOWN       29205 /**< -1 dB. */
+#define LIMITER_STEP_UP         36766 /**< +1 dB. */
+#define LIMITER_TIGHTEN_DIV     10    /**< Lower threshold at most every 100 ms while amplifier warns. */
+#define LIMITER_RELAX_DIV       1     /**< Raise threshold every second without warnings. */
+#define LIMITER_CYCLE_BUDGET    20000
+
+STATIC_ASSERT(CODEC_LIMITER_LOOKAHEAD_FRAMES == (1 << LIMITER_LOOKAHEAD_SHIFT), "Look-ahead must match its shift");
+STATIC_ASSERT((CODEC_BUFFER_SIZE_WORDS % CODEC_LIMITER_LOOKAHEAD_FRAMES) == 0,
+              "Codec block must be a multiple of the look-ahead window");
+
+static uint32_t m_delay[CODEC_LIMITER_LOOKAHEAD_FRAMES]; /**< Previous window, played with a gain based on this one. */
+static int32_t  m_gain;
+static int32_t  m_required_gain; /**< Gain the delayed window needs to stay under threshold. */
+static int32_t  m_threshold;
+static uint32_t m_threshold_frames; /**< Frames since last threshold change. */
+static uint32_t m_tighten_frames;
+static uint32_t m_relax_frames;
+static uint32_t m_threshold_steps; /**< Times the threshold was lowered, reported by codec_limiter_debug(). */
+
+static volatile bool     m_clip_active;
+static volatile uint32_t m_clip_events;
+static uint32_t          m_clip_events_handled;
+
+static void limiter_process(uint32_t *p_frames, size_t frames, void *p_context);
+
+static codec_dsp_stage_t const m_limiter_stage = {
+  .p_name       = "limiter",
+  .handler      = limiter_process,
+  .p_context    = NULL,
+  .cycle_budget = LIMITER_CYCLE_BUDGET,
+};
+
+static int32_t sample_abs(int16_t sample) { return (sample < 0) ? -(int32_t)sample : sample; }
+
+static uint32_t frame_scale(uint32_t frame, int32_t gain)
+{
+    int32_t left  = ((int32_t)(int16_t)frame * gain) >> 15;
+    int32_t right = ((int32_t)(int16_t)(frame >> 16) * gain) >> 15;
+
+    return (uint16_t)left | ((uint32_t)(uint16_t)right << 16);
+}
+
+/**
+ * @brief Move threshold according to amplifier warnings.
+ */
+static void limiter_threshold_update(size_t frames)
+{
+    uint32_t clip_events = m_clip_events;
+    bool     clipping    = m_clip_active || (clip_events != m_clip_events_handled);
+
+    m_clip_events_handled = clip_events;
+    m_threshold_frames += frames;
+
+    if (clipping && (m_threshold_frames >= m_tighten_frames) && (m_threshold > LIMITER_THRESHOLD_MIN))
+    {
+        m_threshold        = MAX((m_threshold * LIMITER_STEP_DOWN) >> 15, LIMITER_THRESHOLD_MIN);
+        m_threshold_frames = 0;
+        m_threshold_steps++;
+    } else if (!clipping && (m_threshold_frames >= m_relax_frames) && (m_threshold < LIMITER_THRESHOLD_MAX))
+    {
+        m_threshold        = MIN((m_threshold * LIMITER_STEP_UP) >> 15, LIMITER_THRESHOLD_MAX);
+        m_threshold_frames = 0;
+    } else if (clipping)
+    {
+        m_threshold_frames = MIN(m_threshold_frames, m_tighten_frames);
+    }
+}
+
+/**
+ * @brief Delay each window by one window and ramp gain so that the peak of the next window is under threshold by the
+ *        time it is played.
+ */
+static void limiter_process(uint32_t *p_frames, size_t frames, void *p_context)
+{
+    limiter_threshold_update(frames);
+
+    for (size_t window = 0; window + CODEC_LIMITER_LOOKAHEAD_FRAMES <= frames; window += CODEC_LIMITER_LOOKAHEAD_FRAMES)
+    {
+        uint32_t *p_window = &p_frames[window];
+        int32_t   peak     = 0;
+        int32_t   required = LIMITER_GAIN_UNITY;
+        int32_t   gain_end;
+
+        for (size_t i = 0; i < CODEC_LIMITER_LOOKAHEAD_FRAMES; i++)
+        {
+            peak = MAX(peak, sample_abs((int16_t)p_window[i]));
+            peak = MAX(peak, sample_abs((int16_t)(p_window[i] >> 16)));
+        }
+
+        if (peak > m_threshold)
+        {
+            required = (m_threshold << 15) / peak;
+        }
+
+        gain_end = m_gain + ((LIMITER_GAIN_UNITY - m_gain) >> LIMITER_RELEASE_SHIFT);
+        gain_end = MIN(gain_end, required);
+        gain_end = MIN(gain_end, m_required_gain);
+
+        for (size_t i = 0; i < CODEC_LIMITER_LOOKAHEAD_FRAMES; i++)
+        {
+            int32_t  gain  = m_gain + (((gain_end - m_gain) * (int32_t)(i + 1)) >> LIMITER_LOOKAHEAD_SHIFT);
+            uint32_t frame = p_window[i];
+
+            p_window[i] = (gain == LIMITER_GAIN_UNITY) ? m_delay[i] : frame_scale(m_delay[i], gain);
+            m_delay[i]  = frame;
+        }
+
+        m_gain          = gain_end;
+        m_required_gain = required;
+    }
+}
+
+ret_code_t codec_limiter_init(void)
+{
+    m_threshold           = LIMITER_THRESHOLD_MAX;
+    m_threshold_frames    = 0;
+    m_clip_active         = false;
+    m_clip_events         = 0;
+    m_clip_events_handled = 0;
+    m_threshold_steps     = 0;
+
+    codec_limiter_sample_rate_set(CODEC_SAMPLE_RATE_DEFAULT);
+    codec_limiter_reset();
+
+    return codec_dsp_stage_register(&m_limiter_stage);
+}
+
+void codec_limiter_reset(void)
+{
+    memset(m_delay, 0, sizeof(m_delay));
+
+    m_gain          = LIMITER_GAIN_UNITY;
+    m_required_gain = LIMITER_GAIN_UNITY;
+}
+
+void codec_limiter_sample_rate_set(uint32_t sample_rate)
+{
+    m_tighten_frames = sample_rate / LIMITER_TIGHTEN_DIV;
+    m_relax_frames   = sample_rate / LIMITER_RELAX_DIV;
+}
+
+void codec_limiter_clip_set(bool active)
+{
+    m_clip_active = active;
+
+    if (active)
+    {
+        m_clip_events++;
+    }
+}
+
+void codec_limiter_debug(void)
+{
+    NRF_LOG_INFO("Limiter threshold %d, lowered %u times", m_threshold, m_threshold_steps);
+}
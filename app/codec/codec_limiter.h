@@ -0,0 +1,50 @@
+/**
+ * @file        codec_limiter.h
+ * @author      Danius Kalvaitis (danius.kalvaitis@gmail.com)
+ * @brief       Look-ahead peak limiter processing stage.
+ * @version     0.1
+ * @date        2026-10-17
+ *
+ * @copyright   Copyright (c) Danius Kalvaitis 2026 All rights reserved
+ *
+ */
+
+#ifndef CODEC_LIMITER_H
+#define CODEC_LIMITER_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "sdk_errors.h"
+
+#define CODEC_LIMITER_LOOKAHEAD_FRAMES 32 /**< Added latency, 0.73 ms at 44.1 kHz. */
+
+/**
+ * @brief Initialize limiter and register it as a processing stage. Should be registered last.
+ */
+ret_code_t codec_limiter_init(void);
+
+/**
+ * @brief Clear look-ahead delay line and gain.
+ */
+void codec_limiter_reset(void);
+
+/**
+ * @brief Scale threshold timing to the stream sample rate. Call before the stream starts.
+ */
+void codec_limiter_sample_rate_set(uint32_t sample_rate);
+
+/**
+ * @brief Report amplifier clip or over temperature warning state. Safe to call from interrupt context.
+ *
+ * While the warning is active or new warnings arrive the limiter threshold is lowered step by step, it is slowly
+ * raised back once warnings stop.
+ */
+void codec_limiter_clip_set(bool active);
+
+/**
+ * @brief Log threshold state. Threshold changes are not logged from the audio interrupt.
+ */
+void codec_limiter_debug(void);
+
+#endif // CODEC_LIMITER_H
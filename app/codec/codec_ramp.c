@@ -0,0 +1,82 @@
+/**
+ * @file        codec_ramp.c
+ * @author      Danius Kalvaitis (danius.kalvaitis@gmail.com)
+ * @brief       Gain ramp applied to audio blocks before they are sent to the codec.
+ * @version     0.1
+ * @date        2026-10-17
+ *
+ * @copyright   Copyright (c) Danius Kalvaitis 2026 All rights reserved
+ *
+ */
+
+#include "codec_ramp.h"
+
+#include "sdk_common.h"
+
+#include "codec_rt.h" // Must stay the last include, poisons blocking calls
+
+#define RAMP_GAIN_UNITY (1 << 15) /**< Gain is in Q15 format. */
+
+static volatile int32_t m_gain;   /**< Current gain. Owned by the block processing side. */
+static volatile int32_t m_target; /**< Gain to ramp towards. */
+static int32_t          m_step;   /**< Gain change per frame. */
+
+static uint32_t frame_scale(uint32_t frame, int32_t gain)
+{
+    int32_t left  = ((int32_t)(int16_t)frame * gain) >> 15;
+    int32_t right = ((int32_t)(int16_t)(frame >> 16) * gain) >> 15;
+
+    return (uint16_t)left | ((uint32_t)(uint16_t)right << 16);
+}
+
+void codec_ramp_sample_rate_set(uint32_t sample_rate)
+{
+    uint32_t ramp_frames = (sample_rate * CODEC_RAMP_TIME_MS) / 1000;
+
+    m_step = CEIL_DIV(RAMP_GAIN_UNITY, ramp_frames);
+}
+
+void codec_ramp_reset(bool silent)
+{
+    m_target = silent ? 0 : RAMP_GAIN_UNITY;
+    m_gain   = m_target;
+}
+
+void codec_ramp_start(bool fade_in) { m_target = fade_in ? RAMP_GAIN_UNITY : 0; }
+
+bool codec_ramp_is_silent(void) { return (m_gain == 0) && (m_target == 0); }
+
+bool codec_ramp_is_fading_out(void) { return m_target == 0; }
+
+bool codec_ramp_process(uint32_t *p_frames, size_t frames)
+{
+    int32_t gain   = m_gain;
+    int32_t target = m_target;
+
+    if (gain == target)
+    {
+        if (gain == 0)
+        {
+            memset(p_frames, 0, frames * sizeof(uint32_t));
+        }
+
+        return false;
+    }
+
+    for (size_t i = 0; i < frames; i++)
+    {
+        if (gain < target)
+        {
+            gain = MIN(gain + m_step, target);
+        } else if (gain > target)
+        {
+            gain = MAX(gain - m_step, target);
+        }
+
+        p_frames[i] = frame_scale(p_frames[i], gain);
+    }
+
+    m_gain = gain;
+
+    return gain == target;
+}
@@ -0,0 +1,61 @@
+/**
+ * @file        codec_ramp.h
+ * @author      Danius Kalvaitis (danius.kalvaitis@gmail.com)
+ * @brief       Gain ramp applied to audio blocks before they are sent to the codec.
+ * @version     0.1
+ * @date        2026-10-17
+ *
+ * @copyright   Copyright (c) Danius Kalvaitis 2026 All rights reserved
+ *
+ */
+
+#ifndef CODEC_RAMP_H
+#define CODEC_RAMP_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+/**
+ * @brief Fade in and fade out duration
+ */
+#ifndef CODEC_RAMP_TIME_MS
+#define CODEC_RAMP_TIME_MS 10
+#endif
+
+/**
+ * @brief Set sample rate used to calculate ramp step.
+ */
+void codec_ramp_sample_rate_set(uint32_t sample_rate);
+
+/**
+ * @brief Jump to unity gain or silence without a ramp.
+ */
+void codec_ramp_reset(bool silent);
+
+/**
+ * @brief Start fading towards unity gain or silence. Fade is applied by following codec_ramp_process() calls.
+ */
+void codec_ramp_start(bool fade_in);
+
+/**
+ * @brief Check if gain has reached silence.
+ */
+bool codec_ramp_is_silent(void);
+
+/**
+ * @brief Check if gain is heading for silence or has reached it.
+ */
+bool codec_ramp_is_fading_out(void);
+
+/**
+ * @brief Apply gain ramp to a block of 16 bit stereo frames in place.
+ *
+ * @param[in,out] p_frames Frames to process.
+ * @param[in]     frames   Amount of frames.
+ *
+ * @return True if a ramp has finished within this block.
+ */
+bool codec_ramp_process(uint32_t *p_frames, size_t frames);
+
+#endif // CODEC_RAMP_H
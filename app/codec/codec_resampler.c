@@ -0,0 +1,147 @@
+/**
+ * @file        codec_resampler.c
+ * @author      Danius Kalvaitis (danius.kalvaitis@gmail.com)
+ * @brief       Drift compensating resampler for received audio data.
+ * @version     0.1
+ * @date        2026-10-17
+ *
+ * @copyright   Copyright (c) Danius Kalvaitis 2026 All rights reserved
+ *
+ */
+
+#include "codec_resampler.h"
+
+#include <string.h>
+
+#include "profile.h"
+
+#define RESAMPLER_HISTORY    3 /**< Frames kept from the previous block for the cubic interpolator. */
+#define RESAMPLER_STEP_ONE   (1 << 16)
+#define RESAMPLER_STEP_LIMIT (RESAMPLER_STEP_ONE / 200) /**< Keep rate correction within 0.5 %. */
+#define RESAMPLER_KP_SHIFT   4                          /**< Proportional gain, step correction per frame of error. */
+#define RESAMPLER_KI_SHIFT   14                         /**< Integral gain. */
+#define RESAMPLER_I_LIMIT    (RESAMPLER_STEP_LIMIT << RESAMPLER_KI_SHIFT)
+
+static uint32_t m_frames[RESAMPLER_HISTORY + CODEC_RESAMPLER_IN_FRAMES_MAX];
+static int32_t  m_position; /**< Read position in m_frames. 16.16 fixed point. */
+static int32_t  m_step;     /**< Input frames per output frame. 16.16 fixed point. */
+static int32_t  m_integral;
+
+static int32_t clamp(int32_t value, int32_t limit)
+{
+    if (value > limit)
+    {
+        return limit;
+    } else if (value < -limit)
+    {
+        return -limit;
+    }
+
+    return value;
+}
+
+/**
+ * @brief Catmull-Rom interpolation between x0 and x1.
+ *
+ * @param[in] t Fractional position in Q15 format.
+ */
+static int16_t cubic_interpolate(int32_t xm1, int32_t x0, int32_t x1, int32_t x2, int32_t t)
+{
+    int32_t a = 3 * (x0 - x1) + x2 - xm1;
+    int32_t b = 2 * xm1 - 5 * x0 + 4 * x1 - x2;
+    int32_t c = x1 - xm1;
+    int32_t y;
+
+    y = (int32_t)(((int64_t)a * t) >> 15);
+    y = (int32_t)(((int64_t)(b + y) * t) >> 15);
+    y = (int32_t)(((int64_t)(c + y) * t) >> 16);
+    y += x0;
+
+    if (y > INT16_MAX)
+    {
+        return INT16_MAX;
+    } else if (y < INT16_MIN)
+    {
+        return INT16_MIN;
+    }
+
+    return (int16_t)y;
+}
+
+static uint32_t frame_interpolate(uint32_t const *p_frames, int32_t t)
+{
+    int16_t left  = cubic_interpolate((int16_t)p_frames[0],
+                                      (int16_t)p_frames[1],
+                                      (int16_t)p_frames[2],
+                                      (int16_t)p_frames[3],
+                                      t);
+    int16_t right = cubic_interpolate((int16_t)(p_frames[0] >> 16),
+                                      (int16_t)(p_frames[1] >> 16),
+                                      (int16_t)(p_frames[2] >> 16),
+                                      (int16_t)(p_frames[3] >> 16),
+                                      t);
+
+    return (uint16_t)left | ((uint32_t)(uint16_t)right << 16);
+}
+
+void codec_resampler_reset(void)
+{
+    memset(m_frames, 0, sizeof(m_frames));
+
+    m_position = RESAMPLER_STEP_ONE;
+    m_step     = RESAMPLER_STEP_ONE;
+    m_integral = 0;
+}
+
+void codec_resampler_fill_update(size_t fill_frames, size_t target_frames)
+{
+    int32_t error = (int32_t)fill_frames - (int32_t)target_frames;
+    int32_t correction;
+
+    m_integral = clamp(m_integral + error, RESAMPLER_I_LIMIT);
+    correction = (error >> RESAMPLER_KP_SHIFT) + (m_integral >> RESAMPLER_KI_SHIFT);
+
+    // Buffer filling up means input runs faster than I2S, consume input faster to produce fewer frames
+    m_step = RESAMPLER_STEP_ONE + clamp(correction, RESAMPLER_STEP_LIMIT);
+}
+
+ret_code_t codec_resampler_process(uint32_t const *p_in,
+                                   size_t          in_frames,
+                                   uint32_t       *p_out,
+                                   size_t          out_frames_max,
+                                   size_t         *p_out_frames)
+{
+    PROFILE_SCOPE(PROFILE_PROBE_RESAMPLER);
+
+    int32_t total_frames = RESAMPLER_HISTORY + (int32_t)in_frames;
+    int32_t position     = m_position;
+    size_t  out_frames   = 0;
+
+    if (in_frames > CODEC_RESAMPLER_IN_FRAMES_MAX)
+    {
+        return NRF_ERROR_INVALID_LENGTH;
+    }
+
+    memcpy(&m_frames[RESAMPLER_HISTORY], p_in, in_frames * sizeof(uint32_t));
+
+    while (((position >> 16) + 2 < total_frames) && (out_frames < out_frames_max))
+    {
+        uint32_t const *p_frames = &m_frames[(position >> 16) - 1];
+
+        p_out[out_frames++] = frame_interpolate(p_frames, (position & 0xFFFF) >> 1);
+        position += m_step;
+    }
+
+    position -= (int32_t)in_frames << 16;
+
+    if (position < RESAMPLER_STEP_ONE) // Output capacity ran out, skip the rest of the input
+    {
+        position = RESAMPLER_STEP_ONE;
+    }
+
+    memmove(m_frames, &m_frames[in_frames], RESAMPLER_HISTORY * sizeof(uint32_t));
+    m_position    = position;
+    *p_out_frames = out_frames;
+
+    return NRF_SUCCESS;
+}
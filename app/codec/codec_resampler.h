@@ -0,0 +1,54 @@
+/**
+ * @file        codec_resampler.h
+ * @author      Danius Kalvaitis (danius.kalvaitis@gmail.com)
+ * @brief       Drift compensating resampler for received audio data.
+ * @version     0.1
+ * @date        2026-10-17
+ *
+ * @copyright   Copyright (c) Danius Kalvaitis 2026 All rights reserved
+ *
+ */
+
+#ifndef CODEC_RESAMPLER_H
+#define CODEC_RESAMPLER_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include "sdk_errors.h"
+
+#define CODEC_RESAMPLER_IN_FRAMES_MAX 49 /**< Frames in the biggest 48 kHz USB packet. */
+
+/**
+ * @brief Reset resampler history and rate controller.
+ */
+void codec_resampler_reset(void);
+
+/**
+ * @brief Update rate controller with the current buffer fill level.
+ *
+ * @param[in] fill_frames   Stereo frames waiting to be played.
+ * @param[in] target_frames Fill level the controller should hold.
+ */
+void codec_resampler_fill_update(size_t fill_frames, size_t target_frames);
+
+/**
+ * @brief Resample a block of 16 bit stereo frames.
+ *
+ * @param[in]  p_in           Input frames.
+ * @param[in]  in_frames      Amount of input frames.
+ * @param[out] p_out          Output frames. May point to the input frames.
+ * @param[in]  out_frames_max Output capacity. in_frames + 1 is always enough.
+ * @param[out] p_out_frames   Amount of frames written to p_out.
+ *
+ * @retval NRF_SUCCESS              Block resampled.
+ * @retval NRF_ERROR_INVALID_LENGTH More than @ref CODEC_RESAMPLER_IN_FRAMES_MAX input frames. Nothing is written and
+ *                                  the history is kept, the caller may use the input as it is.
+ */
+ret_code_t codec_resampler_process(uint32_t const *p_in,
+                                   size_t          in_frames,
+                                   uint32_t       *p_out,
+                                   size_t          out_frames_max,
+                                   size_t         *p_out_frames);
+
+#endif // CODEC_RESAMPLER_H
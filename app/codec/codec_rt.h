@@ -0,0 +1,51 @@
+/**
+ * @file        codec_rt.h
+ * @author      Danius Kalvaitis (danius.kalvaitis@gmail.com)
+ * @brief       Interrupt priority plan and build time checks for the real-time audio path.
+ * @version     0.1
+ * @date        2026-10-17
+ *
+ * @copyright   Copyright (c) Danius Kalvaitis 2026 All rights reserved
+ *
+ * Audio is moved by two interrupts only, USBD writes received packets into the codec buffer and I2S reads blocks out
+ * of it. Both run on the same real-time tier, so they never preempt each other. Everything else runs below it:
+ *
+ * - Tier 5: I2S, USBD. Highest application priority that may still call SoftDevice functions.
+ * - Tier 6: GPIOTE, TWI, app_timer. Codec control and amplifier supervision.
+ * - Tier 7: SPI display, UART.
+ * - Thread: app_scheduler, SoftDevice events, logging.
+ *
+ * Include this header last in every source file whose code runs on the real-time tier. Blocking TWI, SPI and delay
+ * functions are poisoned for the rest of the file, any call to them fails the build.
+ */
+
+#ifndef CODEC_RT_H
+#define CODEC_RT_H
+
+#include "sdk_common.h"
+
+#if defined(USBD_ENABLED) && USBD_ENABLED
+#define CODEC_RT_USBD_IRQ_PRIORITY USBD_CONFIG_IRQ_PRIORITY // Legacy configuration overrides the nrfx one
+#else
+#define CODEC_RT_USBD_IRQ_PRIORITY NRFX_USBD_CONFIG_IRQ_PRIORITY
+#endif
+
+#if defined(GPIOTE_ENABLED) && GPIOTE_ENABLED
+#define CODEC_RT_GPIOTE_IRQ_PRIORITY GPIOTE_CONFIG_IRQ_PRIORITY
+#else
+#define CODEC_RT_GPIOTE_IRQ_PRIORITY NRFX_GPIOTE_CONFIG_IRQ_PRIORITY
+#endif
+
+#define CODEC_RT_IRQ_PRIORITY NRFX_I2S_CONFIG_IRQ_PRIORITY
+
+STATIC_ASSERT(CODEC_RT_IRQ_PRIORITY == 5, "Audio tier must be the highest priority allowed to call the SoftDevice");
+STATIC_ASSERT(CODEC_RT_USBD_IRQ_PRIORITY == CODEC_RT_IRQ_PRIORITY, "USBD and I2S must share the audio tier");
+STATIC_ASSERT(!APP_USBD_CONFIG_EVENT_QUEUE_ENABLE, "USB audio events must be handled in the USBD interrupt");
+STATIC_ASSERT(NRFX_TWI_DEFAULT_CONFIG_IRQ_PRIORITY > CODEC_RT_IRQ_PRIORITY, "TWI must run below the audio tier");
+STATIC_ASSERT(NRFX_SPI_DEFAULT_CONFIG_IRQ_PRIORITY > CODEC_RT_IRQ_PRIORITY, "SPI must run below the audio tier");
+STATIC_ASSERT(CODEC_RT_GPIOTE_IRQ_PRIORITY > CODEC_RT_IRQ_PRIORITY, "GPIOTE must run below the audio tier");
+STATIC_ASSERT(APP_TIMER_CONFIG_IRQ_PRIORITY > CODEC_RT_IRQ_PRIORITY, "Timers must run below the audio tier");
+
+#pragma GCC poison nrf_delay_ms nrf_delay_us nrfx_twi_xfer nrfx_twi_tx nrfx_twi_rx nrfx_spi_xfer dk_twi_mngr_perform
+
+#endif // CODEC_RT_H
@@ -0,0 +1,195 @@
+/**
+ * @file        profile.c
+ * @author      Danius Kalvaitis (danius.kalvaitis@gmail.com)
+ * @brief       Cycle count probes for audio hot paths.
+ * @version     0.1
+ * @date        2026-10-17
+ *
+ * @copyright   Copyright (c) Danius Kalvaitis 2026 All rights reserved
+ *
+ */
+
+#include "profile.h"
+
+void profile_cycle_counter_init(void)
+{
+#ifndef PROFILE_HOST
+    CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;
+    DWT->CYCCNT = 0;
+    DWT->CTRL |= DWT_CTRL_CYCCNTENA_Msk;
+#endif
+}
+
+#if PROFILE_ENABLED
+
+#include <string.h>
+
+#ifdef PROFILE_HOST
+#include <stdio.h>
+#define PROFILE_LOG(...) (printf(__VA_ARGS__), printf("\n"))
+#else
+#define NRF_LOG_MODULE_NAME profile
+#include "nrf_log.h"
+NRF_LOG_MODULE_REGISTER();
+#define PROFILE_LOG(...) NRF_LOG_INFO(__VA_ARGS__)
+#endif
+
+#define PROFILE_BIN_SUB_SHIFT 2 /**< 4 bins per octave. */
+#define PROFILE_BIN_SUB_COUNT (1 << PROFILE_BIN_SUB_SHIFT)
+
+typedef struct
+{
+    uint32_t count;
+    uint32_t min;
+    uint32_t max;
+    uint64_t sum;
+    uint32_t bins[PROFILE_BINS];
+} profile_probe_data_t;
+
+static char const *const m_probe_names[PROFILE_PROBE_COUNT] = {
+  [PROFILE_PROBE_I2S_HANDLER]       = "i2s_data_handler",
+  [PROFILE_PROBE_BUFFER_GET_RX]     = "codec_buffer_get_rx",
+  [PROFILE_PROBE_BUFFER_RELEASE_RX] = "codec_buffer_release_rx",
+  [PROFILE_PROBE_USB_SOF]           = "spkr_sof_ev_handler",
+  [PROFILE_PROBE_RESAMPLER]         = "codec_resampler_process",
+};
+
+static profile_probe_data_t m_probes[PROFILE_PROBE_COUNT];
+
+/**
+ * @brief Bin values below 4 directly, higher values by octave and the two bits below the leading one.
+ */
+static uint32_t profile_bin_get(uint32_t cycles)
+{
+    uint32_t msb;
+    uint32_t bin;
+
+    if (cycles < PROFILE_BIN_SUB_COUNT)
+    {
+        return cycles;
+    }
+
+    msb = 31 - __builtin_clz(cycles);
+    bin = PROFILE_BIN_SUB_COUNT * (msb - 1) + ((cycles >> (msb - PROFILE_BIN_SUB_SHIFT)) & (PROFILE_BIN_SUB_COUNT - 1));
+
+    return (bin < PROFILE_BINS) ? bin : (PROFILE_BINS - 1);
+}
+
+static uint32_t profile_bin_upper_get(uint32_t bin)
+{
+    uint32_t msb;
+    uint32_t lower;
+
+    if (bin < PROFILE_BIN_SUB_COUNT)
+    {
+        return bin;
+    }
+
+    msb   = bin / PROFILE_BIN_SUB_COUNT + 1;
+    lower = (PROFILE_BIN_SUB_COUNT + (bin % PROFILE_BIN_SUB_COUNT)) << (msb - PROFILE_BIN_SUB_SHIFT);
+
+    return lower + (1UL << (msb - PROFILE_BIN_SUB_SHIFT)) - 1;
+}
+
+void profile_init(void) { profile_reset(); }
+
+void profile_reset(void)
+{
+    memset(m_probes, 0, sizeof(m_probes));
+
+    for (size_t i = 0; i < PROFILE_PROBE_COUNT; i++)
+    {
+        m_probes[i].min = UINT32_MAX;
+    }
+}
+
+void profile_record(profile_probe_t probe, uint32_t cycles)
+{
+    profile_probe_data_t *p_data;
+
+    if (probe >= PROFILE_PROBE_COUNT)
+    {
+        return;
+    }
+
+    p_data = &m_probes[probe];
+
+    p_data->count++;
+    p_data->sum += cycles;
+    p_data->bins[profile_bin_get(cycles)]++;
+
+    if (cycles < p_data->min)
+    {
+        p_data->min = cycles;
+    }
+
+    if (cycles > p_data->max)
+    {
+        p_data->max = cycles;
+    }
+}
+
+void profile_scope_end(profile_scope_t const *p_scope)
+{
+    profile_record(p_scope->probe, profile_timestamp() - p_scope->start);
+}
+
+void profile_stats_get(profile_probe_t probe, profile_stats_t *p_stats)
+{
+    profile_probe_data_t data;
+    uint32_t             p99_count;
+    uint32_t             seen = 0;
+
+    if ((probe >= PROFILE_PROBE_COUNT) || (p_stats == NULL))
+    {
+        return;
+    }
+
+    data = m_probes[probe]; // Probes keep running, work on a copy
+    memset(p_stats, 0, sizeof(*p_stats));
+
+    if (data.count == 0)
+    {
+        return;
+    }
+
+    p_stats->count = data.count;
+    p_stats->min   = data.min;
+    p_stats->max   = data.max;
+    p_stats->avg   = (uint32_t)(data.sum / data.count);
+
+    p99_count = data.count - data.count / 100;
+
+    for (uint32_t bin = 0; bin < PROFILE_BINS; bin++)
+    {
+        seen += data.bins[bin];
+
+        if (seen >= p99_count)
+        {
+            uint32_t upper = (bin < PROFILE_BINS - 1) ? profile_bin_upper_get(bin) : UINT32_MAX; // Top bin is open
+
+            p_stats->p99 = (upper < data.max) ? upper : data.max;
+            break;
+        }
+    }
+}
+
+void profile_dump(void)
+{
+    profile_stats_t stats;
+
+    for (size_t i = 0; i < PROFILE_PROBE_COUNT; i++)
+    {
+        profile_stats_get((profile_probe_t)i, &stats);
+
+        PROFILE_LOG("%s: n %u min %u avg %u max %u p99 %u",
+                    m_probe_names[i],
+                    stats.count,
+                    stats.min,
+                    stats.avg,
+                    stats.max,
+                    stats.p99);
+    }
+}
+
+#endif // PROFILE_ENABLED
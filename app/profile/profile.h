@@ -0,0 +1,116 @@
+/**
+ * @file        profile.h
+ * @author      Danius Kalvaitis (danius.kalvaitis@gmail.com)
+ * @brief       Cycle count probes for audio hot paths.
+ * @version     0.1
+ * @date        2026-10-17
+ *
+ * @copyright   Copyright (c) Danius Kalvaitis 2026 All rights reserved
+ *
+ * Place PROFILE_SCOPE(probe) at the top of a function, the time until the function returns is recorded against the
+ * probe. On target time is taken from DWT CYCCNT. Host simulation builds define PROFILE_HOST, time is then taken from
+ * clock_gettime and scaled to PROFILE_HOST_CPU_MHZ cycles so both report the same unit.
+ *
+ * profile_timestamp() is available in all builds and is the only cycle counter source in the application. The
+ * counter is started once with profile_cycle_counter_init().
+ */
+
+#ifndef PROFILE_H
+#define PROFILE_H
+
+#include <stdint.h>
+
+#ifdef PROFILE_HOST
+#include <time.h>
+#else
+#include "nrf.h"
+#endif
+
+/**
+ * @brief Profiling is compiled in debug builds only
+ */
+#ifndef PROFILE_ENABLED
+#ifdef DEBUG
+#define PROFILE_ENABLED 1
+#else
+#define PROFILE_ENABLED 0
+#endif
+#endif
+
+#ifndef PROFILE_HOST_CPU_MHZ
+#define PROFILE_HOST_CPU_MHZ 64
+#endif
+
+#define PROFILE_BINS 64 /**< 4 bins per octave, up to 2^17 cycles. */
+
+typedef enum
+{
+    PROFILE_PROBE_I2S_HANDLER,
+    PROFILE_PROBE_BUFFER_GET_RX,
+    PROFILE_PROBE_BUFFER_RELEASE_RX,
+    PROFILE_PROBE_USB_SOF,
+    PROFILE_PROBE_RESAMPLER,
+    PROFILE_PROBE_COUNT
+} profile_probe_t;
+
+typedef struct
+{
+    uint32_t count;
+    uint32_t min;
+    uint32_t avg;
+    uint32_t max;
+    uint32_t p99; /**< Upper edge of the bin holding the 99th percentile, max if that is lower or the top bin. */
+} profile_stats_t;
+
+/**
+ * @brief Start the cycle counter. Call once at boot before anything takes timestamps.
+ */
+void profile_cycle_counter_init(void);
+
+/**
+ * @brief Current cycle count.
+ */
+static inline uint32_t profile_timestamp(void)
+{
+#ifdef PROFILE_HOST
+    struct timespec now;
+
+    clock_gettime(CLOCK_MONOTONIC, &now);
+
+    return (uint32_t)(((uint64_t)now.tv_sec * 1000000000ULL + (uint64_t)now.tv_nsec) * PROFILE_HOST_CPU_MHZ / 1000);
+#else
+    return DWT->CYCCNT;
+#endif
+}
+
+#if PROFILE_ENABLED
+
+typedef struct
+{
+    profile_probe_t probe;
+    uint32_t        start;
+} profile_scope_t;
+
+void     profile_init(void);
+void     profile_reset(void);
+void     profile_record(profile_probe_t probe, uint32_t cycles);
+void     profile_scope_end(profile_scope_t const *p_scope);
+void     profile_stats_get(profile_probe_t probe, profile_stats_t *p_stats);
+void     profile_dump(void);
+
+#define PROFILE_INIT()  profile_init()
+#define PROFILE_RESET() profile_reset()
+#define PROFILE_DUMP()  profile_dump()
+#define PROFILE_SCOPE(probe)                                                                                           \
+    profile_scope_t const profile_scope __attribute__((cleanup(profile_scope_end))) = {(probe), profile_timestamp()}
+
+#else
+
+#define PROFILE_INIT()       ((void)0)
+#define PROFILE_RESET()      ((void)0)
+#define PROFILE_DUMP()       ((void)0)
+#define PROFILE_SCOPE(probe) ((void)0)
+
+#endif // PROFILE_ENABLED
+
+#endif // PROFILE_H
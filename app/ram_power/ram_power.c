@@ -0,0 +1,116 @@
+/**
+ * @file        ram_power.c
+ * @author      Danius Kalvaitis (danius.kalvaitis@gmail.com)
+ * @brief       nRF52840 RAM section power control.
+ * @version     0.1
+ * @date        2026-10-17
+ *
+ * @copyright   Copyright (c) Danius Kalvaitis 2026 All rights reserved
+ *
+ */
+
+#include "ram_power.h"
+
+#include "nrf.h"
+#include "nrf_sdh.h"
+#include "nrf_soc.h"
+#include "sdk_common.h"
+
+#define RAM_POWER_START         0x20000000UL
+#define RAM_POWER_END           0x20040000UL
+#define RAM_POWER_SMALL_END     0x20010000UL /**< End of RAM0..RAM7. */
+#define RAM_POWER_SMALL_BLOCK   0x2000UL
+#define RAM_POWER_SMALL_SECTION 0x1000UL
+#define RAM_POWER_LARGE_BLOCK   8
+#define RAM_POWER_LARGE_SECTION 0x8000UL
+#define RAM_POWER_RETENTION_POS 16
+
+typedef struct
+{
+    uint8_t  block;
+    uint8_t  section;
+    uint32_t size;
+} ram_power_section_t;
+
+static ram_power_section_t ram_power_section_get(uint32_t address)
+{
+    ram_power_section_t section;
+    uint32_t            offset;
+
+    if (address < RAM_POWER_SMALL_END)
+    {
+        offset          = address - RAM_POWER_START;
+        section.block   = offset / RAM_POWER_SMALL_BLOCK;
+        section.section = (offset % RAM_POWER_SMALL_BLOCK) / RAM_POWER_SMALL_SECTION;
+        section.size    = RAM_POWER_SMALL_SECTION;
+    } else
+    {
+        offset          = address - RAM_POWER_SMALL_END;
+        section.block   = RAM_POWER_LARGE_BLOCK;
+        section.section = offset / RAM_POWER_LARGE_SECTION;
+        section.size    = RAM_POWER_LARGE_SECTION;
+    }
+
+    return section;
+}
+
+static ret_code_t ram_power_block_set(uint8_t block, uint32_t sections, bool on)
+{
+    uint32_t power_mask = sections;
+
+    if (!on)
+    {
+        power_mask |= sections << RAM_POWER_RETENTION_POS;
+    }
+
+#ifdef SOFTDEVICE_PRESENT
+    if (nrf_sdh_is_enabled()) // POWER registers are restricted while the SoftDevice runs
+    {
+        return on ? sd_power_ram_power_set(block, power_mask) : sd_power_ram_power_clr(block, power_mask);
+    }
+#endif
+
+    if (on)
+    {
+        NRF_POWER->RAM[block].POWERSET = power_mask;
+    } else
+    {
+        NRF_POWER->RAM[block].POWERCLR = power_mask;
+    }
+
+    return NRF_SUCCESS;
+}
+
+ret_code_t ram_power_set(void const *p_start, size_t size, bool on)
+{
+    ret_code_t err_code;
+    uint32_t   address  = (uint32_t)p_start;
+    uint32_t   end      = address + size;
+    uint8_t    block    = UINT8_MAX;
+    uint32_t   sections = 0;
+
+    if ((address < RAM_POWER_START) || (end > RAM_POWER_END) || (size == 0))
+    {
+        return NRF_ERROR_INVALID_PARAM;
+    }
+
+    // Collect sections per block, one call switches all sections of a block
+    while (address < end)
+    {
+        ram_power_section_t section = ram_power_section_get(address);
+
+        if ((section.block != block) && (sections != 0))
+        {
+            err_code = ram_power_block_set(block, sections, on);
+            VERIFY_SUCCESS(err_code);
+
+            sections = 0;
+        }
+
+        block     = section.block;
+        sections |= 1UL << section.section;
+        address   = (address - (address % section.size)) + section.size;
+    }
+
+    return ram_power_block_set(block, sections, on);
+}
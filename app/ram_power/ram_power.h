@@ -0,0 +1,29 @@
+/**
+ * @file        ram_power.h
+ * @author      Danius Kalvaitis (danius.kalvaitis@gmail.com)
+ * @brief       nRF52840 RAM section power control.
+ * @version     0.1
+ * @date        2026-10-17
+ *
+ * @copyright   Copyright (c) Danius Kalvaitis 2026 All rights reserved
+ *
+ * RAM0..RAM7 hold two 4 KB sections each, RAM8 holds six 32 KB sections. A section that is powered off loses its
+ * contents, so only ranges in a dedicated linker region should be passed here.
+ */
+
+#ifndef RAM_POWER_H
+#define RAM_POWER_H
+
+#include <stdbool.h>
+#include <stddef.h>
+
+#include "sdk_errors.h"
+
+/**
+ * @brief Power every RAM section the range touches on or off. Retention is switched off together with power.
+ *
+ * @retval NRF_ERROR_INVALID_PARAM Range is not in RAM.
+ */
+ret_code_t ram_power_set(void const *p_start, size_t size, bool on);
+
+#endif // RAM_POWER_H
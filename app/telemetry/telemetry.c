@@ -0,0 +1,215 @@
+/**
+ * @file        telemetry.c
+ * @author      Danius Kalvaitis (danius.kalvaitis@gmail.com)
+ * @brief       Audio path counters and binary event trace.
+ * @version     0.1
+ * @date        2026-10-17
+ *
+ * @copyright   Copyright (c) Danius Kalvaitis 2026 All rights reserved
+ *
+ */
+
+#include "telemetry.h"
+
+#include "SEGGER_RTT.h"
+#include "nrf.h"
+#include "nrf_atomic.h"
+#include "profile.h"
+#include "sdk_common.h"
+
+#define NRF_LOG_MODULE_NAME telemetry
+#include "nrf_log.h"
+NRF_LOG_MODULE_REGISTER();
+
+/**
+ * @brief RTT up channel trace records are streamed to. Channel 0 is used by the logger.
+ */
+#ifndef TELEMETRY_RTT_CHANNEL
+#define TELEMETRY_RTT_CHANNEL 1
+#endif
+
+#define TELEMETRY_TRACE_MASK (TELEMETRY_TRACE_SIZE - 1)
+#define TELEMETRY_RTT_BATCH  16 /**< Records sent to RTT per call. */
+#define TELEMETRY_RTT_BUFFER (TELEMETRY_RTT_BATCH * 4 * sizeof(telemetry_trace_record_t))
+
+/**
+ * @brief Sequence marker of the record written at a free running index. Never 0, which marks a record being written.
+ */
+#define TELEMETRY_TRACE_SEQ(index) ((uint8_t)(0x80 | (((index) / TELEMETRY_TRACE_SIZE) & 0x7F)))
+
+STATIC_ASSERT(IS_POWER_OF_TWO(TELEMETRY_TRACE_SIZE), "Telemetry trace size must be a power of two");
+STATIC_ASSERT(sizeof(telemetry_trace_record_t) == 8, "Telemetry trace record must stay 8 bytes");
+STATIC_ASSERT(TELEMETRY_RTT_CHANNEL < SEGGER_RTT_MAX_NUM_UP_BUFFERS, "Telemetry RTT channel is not available");
+
+static telemetry_snapshot_t     m_snapshot;
+static telemetry_trace_record_t m_trace[TELEMETRY_TRACE_SIZE];
+static nrf_atomic_u32_t         m_trace_index; /**< Next record to write. Free running. */
+static uint32_t                 m_rtt_index;   /**< Next record to send over RTT. Free running. */
+static uint8_t                  m_rtt_buffer[TELEMETRY_RTT_BUFFER];
+
+void telemetry_init(void)
+{
+    memset(&m_snapshot, 0, sizeof(m_snapshot));
+    m_snapshot.queue_depth_min = UINT16_MAX;
+
+    m_trace_index = 0;
+    m_rtt_index   = 0;
+    memset(m_trace, 0, sizeof(m_trace));
+
+    UNUSED_RETURN_VALUE(SEGGER_RTT_ConfigUpBuffer(TELEMETRY_RTT_CHANNEL,
+                                                  "Telemetry",
+                                                  m_rtt_buffer,
+                                                  sizeof(m_rtt_buffer),
+                                                  SEGGER_RTT_MODE_NO_BLOCK_SKIP));
+}
+
+void telemetry_count(telemetry_counter_t counter)
+{
+    if (counter < TELEMETRY_COUNTER_COUNT)
+    {
+        m_snapshot.counters[counter]++;
+    }
+}
+
+void telemetry_packet(size_t size)
+{
+    size_t frames    = size / sizeof(uint32_t);
+    size_t class_idx = 0;
+
+    if (frames > TELEMETRY_PACKET_CLASS_FRAMES_MIN)
+    {
+        class_idx = MIN(frames - TELEMETRY_PACKET_CLASS_FRAMES_MIN, TELEMETRY_PACKET_CLASSES - 1);
+    }
+
+    m_snapshot.packet_classes[class_idx]++;
+}
+
+void telemetry_queue_depth(size_t depth)
+{
+    if (depth < m_snapshot.queue_depth_min)
+    {
+        m_snapshot.queue_depth_min = depth;
+    }
+
+    if (depth > m_snapshot.queue_depth_max)
+    {
+        m_snapshot.queue_depth_max = depth;
+    }
+}
+
+void telemetry_i2s_latency(uint32_t start)
+{
+    uint32_t cycles = profile_timestamp() - start;
+
+    if (cycles > m_snapshot.i2s_latency_max)
+    {
+        m_snapshot.i2s_latency_max = cycles;
+    }
+}
+
+void telemetry_trace(telemetry_trace_id_t id, uint16_t arg)
+{
+    // Reserve the slot first, a higher priority writer may come in before this record is filled
+    uint32_t                  index    = nrf_atomic_u32_fetch_add(&m_trace_index, 1);
+    telemetry_trace_record_t *p_record = &m_trace[index & TELEMETRY_TRACE_MASK];
+
+    // Readers skip the record until the marker written last matches its index
+    p_record->seq = 0;
+    __DMB();
+    p_record->timestamp = profile_timestamp();
+    p_record->arg       = arg;
+    p_record->id        = (uint8_t)id;
+    __DMB();
+    p_record->seq = TELEMETRY_TRACE_SEQ(index);
+}
+
+void telemetry_snapshot_get(telemetry_snapshot_t *p_snapshot)
+{
+    VERIFY_PARAM_NOT_NULL_VOID(p_snapshot);
+
+    *p_snapshot             = m_snapshot;
+    p_snapshot->trace_count = m_trace_index;
+}
+
+size_t telemetry_trace_read(uint32_t *p_index, telemetry_trace_record_t *p_records, size_t count)
+{
+    uint32_t write_index = m_trace_index;
+    uint32_t index;
+    size_t   copied = 0;
+
+    if ((p_index == NULL) || (p_records == NULL))
+    {
+        return 0;
+    }
+
+    index = *p_index;
+
+    if (write_index - index > TELEMETRY_TRACE_SIZE) // Reader fell behind, oldest records are gone
+    {
+        index = write_index - TELEMETRY_TRACE_SIZE;
+    }
+
+    while ((index != write_index) && (copied < count))
+    {
+        telemetry_trace_record_t const *p_record = &m_trace[index & TELEMETRY_TRACE_MASK];
+        uint8_t                         seq      = TELEMETRY_TRACE_SEQ(index);
+
+        if (p_record->seq != seq) // Still being written, picked up by the next read
+        {
+            break;
+        }
+
+        __DMB();
+        p_records[copied] = *p_record;
+        __DMB();
+
+        if (p_record->seq != seq) // Overwritten while copying
+        {
+            break;
+        }
+
+        copied++;
+        index++;
+    }
+
+    *p_index = index;
+
+    return copied;
+}
+
+void telemetry_rtt_process(void)
+{
+    telemetry_trace_record_t records[TELEMETRY_RTT_BATCH];
+    uint32_t                 index = m_rtt_index;
+    size_t                   count = telemetry_trace_read(&index, records, ARRAY_SIZE(records));
+
+    if (count == 0)
+    {
+        return;
+    }
+
+    // Batch is written whole or not at all, a skipped batch is retried on the next call
+    if (SEGGER_RTT_Write(TELEMETRY_RTT_CHANNEL, records, count * sizeof(records[0])) != 0)
+    {
+        m_rtt_index = index;
+    }
+}
+
+void telemetry_debug(void)
+{
+    telemetry_snapshot_t snapshot;
+
+    telemetry_snapshot_get(&snapshot);
+
+    NRF_LOG_INFO("Underruns %u, overruns %u, pool exhausted %u, rx timeouts %u, resampler bypass %u",
+                 snapshot.counters[TELEMETRY_COUNTER_UNDERRUN],
+                 snapshot.counters[TELEMETRY_COUNTER_OVERRUN],
+                 snapshot.counters[TELEMETRY_COUNTER_POOL_EXHAUSTED],
+                 snapshot.counters[TELEMETRY_COUNTER_RX_TIMEOUT],
+                 snapshot.counters[TELEMETRY_COUNTER_RESAMPLER_BYPASS]);
+    NRF_LOG_INFO("Queue depth %u..%u, I2S latency max %u cycles",
+                 snapshot.queue_depth_min,
+                 snapshot.queue_depth_max,
+                 snapshot.i2s_latency_max);
+    NRF_LOG_HEXDUMP_INFO(snapshot.packet_classes, sizeof(snapshot.packet_classes));
+}
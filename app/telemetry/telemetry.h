@@ -0,0 +1,126 @@
+/**
+ * @file        telemetry.h
+ * @author      Danius Kalvaitis (danius.kalvaitis@gmail.com)
+ * @brief       Audio path counters and binary event trace.
+ * @version     0.1
+ * @date        2026-10-17
+ *
+ * @copyright   Copyright (c) Danius Kalvaitis 2026 All rights reserved
+ *
+ */
+
+#ifndef TELEMETRY_H
+#define TELEMETRY_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+#ifndef TELEMETRY_TRACE_SIZE
+#define TELEMETRY_TRACE_SIZE 128 /**< Trace records kept. Must be a power of two. */
+#endif
+
+#define TELEMETRY_PACKET_CLASS_FRAMES_MIN 43 /**< Smaller packets are counted in the first class. */
+#define TELEMETRY_PACKET_CLASSES          8  /**< Bigger packets are counted in the last class. */
+
+typedef enum
+{
+    TELEMETRY_COUNTER_UNDERRUN,         /**< I2S found no block to play. */
+    TELEMETRY_COUNTER_OVERRUN,          /**< Codec buffer had no room for a received packet. */
+    TELEMETRY_COUNTER_POOL_EXHAUSTED,   /**< USB packet dropped because no buffer was handed out. */
+    TELEMETRY_COUNTER_RX_TIMEOUT,       /**< USB stream stopped. */
+    TELEMETRY_COUNTER_RESAMPLER_BYPASS, /**< USB packet too big for the resampler, played without rate correction. */
+    TELEMETRY_COUNTER_COUNT
+} telemetry_counter_t;
+
+typedef enum
+{
+    TELEMETRY_TRACE_USB_RX,         /**< Arg: packet size in bytes. */
+    TELEMETRY_TRACE_USB_RX_DROP,    /**< Arg: packet size in bytes. */
+    TELEMETRY_TRACE_USB_RX_TIMEOUT, /**< Arg: unused. */
+    TELEMETRY_TRACE_I2S_BLOCK,      /**< Arg: queue depth in blocks. */
+    TELEMETRY_TRACE_I2S_UNDERRUN,   /**< Arg: unused. */
+    TELEMETRY_TRACE_STREAM_START,   /**< Arg: unused. */
+    TELEMETRY_TRACE_STREAM_STOP     /**< Arg: unused. */
+} telemetry_trace_id_t;
+
+/**
+ * @brief Trace record. Little endian, 8 bytes, streamed as is.
+ */
+typedef struct
+{
+    uint32_t timestamp; /**< Cycle count from profile_timestamp(). */
+    uint16_t arg;
+    uint8_t  id;  /**< @ref telemetry_trace_id_t. */
+    uint8_t  seq; /**< Bit 7 set once the record is complete, bits 6..0 count trace wraps. Written last. */
+} telemetry_trace_record_t;
+
+typedef struct
+{
+    uint32_t counters[TELEMETRY_COUNTER_COUNT];
+    uint32_t packet_classes[TELEMETRY_PACKET_CLASSES]; /**< Received packets per size in frames. */
+    uint16_t queue_depth_min;                          /**< Blocks left after I2S took one. */
+    uint16_t queue_depth_max;
+    uint32_t i2s_latency_max; /**< Cycles from I2S interrupt entry until the next buffer is set. */
+    uint32_t trace_count;     /**< Trace records written since init. */
+} telemetry_snapshot_t;
+
+/**
+ * @brief Reset counters and trace. The cycle counter must already run, see profile_cycle_counter_init().
+ */
+void telemetry_init(void);
+
+/**
+ * @brief Increment a counter. Must be called from the audio interrupt tier.
+ */
+void telemetry_count(telemetry_counter_t counter);
+
+/**
+ * @brief Count a received USB packet. Must be called from the audio interrupt tier.
+ */
+void telemetry_packet(size_t size);
+
+/**
+ * @brief Record codec buffer depth seen by I2S. Must be called from the audio interrupt tier.
+ */
+void telemetry_queue_depth(size_t depth);
+
+/**
+ * @brief Record I2S interrupt latency. Must be called from the audio interrupt tier.
+ *
+ * @param[in] start profile_timestamp() taken at interrupt entry.
+ */
+void telemetry_i2s_latency(uint32_t start);
+
+/**
+ * @brief Append a record to the trace. May be called from any context.
+ */
+void telemetry_trace(telemetry_trace_id_t id, uint16_t arg);
+
+/**
+ * @brief Get a copy of the counters.
+ */
+void telemetry_snapshot_get(telemetry_snapshot_t *p_snapshot);
+
+/**
+ * @brief Copy trace records written since a previous read.
+ *
+ * @param[in,out] p_index   Index of the next record to read. Moved past the records copied. Records overwritten
+ *                          since the previous read are skipped.
+ * @param[out]    p_records Destination.
+ * @param[in]     count     Destination capacity in records.
+ *
+ * @return Amount of records copied.
+ */
+size_t telemetry_trace_read(uint32_t *p_index, telemetry_trace_record_t *p_records, size_t count);
+
+/**
+ * @brief Stream new trace records to the telemetry RTT channel. Call from the main loop.
+ */
+void telemetry_rtt_process(void);
+
+/**
+ * @brief Log counters.
+ */
+void telemetry_debug(void);
+
+#endif // TELEMETRY_H
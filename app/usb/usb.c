@@ -11,33 +11,39 @@
 
 #include "usb.h"
 
-#include "app_timer.h"
 #include "app_usbd.h"
-#include "app_usbd_audio.h"
 #include "app_usbd_core.h"
 #include "app_usbd_string_desc.h"
+#include "app_util_platform.h"
 #include "nrf_drv_clock.h"
 #include "nrf_drv_usbd.h"
+#include "profile.h"
+#include "telemetry.h"
+#include "usb_audio.h"
 
 #define NRF_LOG_MODULE_NAME usb
 #include "nrf_log.h"
 NRF_LOG_MODULE_REGISTER();
 
-#define USB_RX_PACKET_SIZE 192
+#include "codec_rt.h" // Must stay the last include, poisons blocking calls
 
-#define USB_EVENT_TYPE_RX_DONE_DEF(rx_packet_size)                                                                     \
+#define USB_VOLUME_MIN (-16256) /**< -63.5 dB in 1/256 dB units. */
+#define USB_VOLUME_MAX 0
+#define USB_VOLUME_RES 128 /**< 0.5 dB. */
+
+#define USB_EVENT_TYPE_MUTE_SET_DEF(_mute)                                                                             \
     {                                                                                                                  \
-        .evt_type = USB_EVENT_TYPE_RX_DONE, .params.size = rx_packet_size                                              \
+        .evt_type = USB_EVENT_TYPE_MUTE_SET, .params.mute = _mute                                                      \
     }
 
-#define USB_EVENT_TYPE_RX_BUFFER_REQUEST_DEF(rx_packet_size)                                                           \
+#define USB_EVENT_TYPE_SAMPLE_RATE_SET_DEF(_sample_rate)                                                               \
     {                                                                                                                  \
-        .evt_type = USB_EVENT_TYPE_RX_BUFFER_REQUEST, .params.size = rx_packet_size                                    \
+        .evt_type = USB_EVENT_TYPE_SAMPLE_RATE_SET, .params.sample_rate = _sample_rate                                 \
     }
 
-#define USB_EVENT_TYPE_MUTE_SET_DEF(_mute)                                                                             \
+#define USB_EVENT_TYPE_VOLUME_SET_DEF(_volume)                                                                         \
     {                                                                                                                  \
-        .evt_type = USB_EVENT_TYPE_MUTE_SET, .params.mute = _mute                                                      \
+        .evt_type = USB_EVENT_TYPE_VOLUME_SET, .params.volume = _volume                                                \
     }
 
 #define USB_EVENT_DEF(event_type)                                                                                      \
@@ -57,158 +63,185 @@ NRF_LOG_MODULE_REGISTER();
 /**
  * @brief Audio class user event handler
  */
-static void spkr_audio_user_ev_handler(app_usbd_class_inst_t const *p_inst, app_usbd_audio_user_event_t event);
-
-/* Channels and feature controls configuration */
+static void spkr_audio_user_ev_handler(app_usbd_class_inst_t const *p_inst, usb_audio_user_event_t event);
 
 /**
- * @brief   Input terminal channel configuration
+ * @brief Sample format of each streaming alternate setting
  */
-#define SPKR_TERMINAL_CH_CONFIG()                                                                                      \
-    (APP_USBD_AUDIO_IN_TERM_CH_CONFIG_LEFT_FRONT | APP_USBD_AUDIO_IN_TERM_CH_CONFIG_RIGHT_FRONT)
+static usb_audio_format_t const m_spkr_formats[] = {
+  {.subframe_size = 2, .bit_resolution = 16},
+  {.subframe_size = 3, .bit_resolution = 24},
+  {.subframe_size = 4, .bit_resolution = 32},
+};
+
+static uint32_t const m_spkr_sample_rates[] = {44100, 48000};
 
 /**
- * @brief   Feature controls
- *
- *      general
- *      channel 0
- *      channel 1
+ * @brief Speaker Audio class instance
  */
-#define SPKR_FEATURE_CONTROLS()                                                                                        \
-    APP_USBD_U16_TO_RAW_DSC(APP_USBD_AUDIO_FEATURE_UNIT_CONTROL_MUTE),                                                 \
-      APP_USBD_U16_TO_RAW_DSC(APP_USBD_AUDIO_FEATURE_UNIT_CONTROL_MUTE),                                               \
-      APP_USBD_U16_TO_RAW_DSC(APP_USBD_AUDIO_FEATURE_UNIT_CONTROL_MUTE)
+USB_AUDIO_GLOBAL_DEF(m_app_audio_speakers,
+                     USB_AUDIO_CONFIG(0, 1),
+                     spkr_audio_user_ev_handler,
+                     m_spkr_formats,
+                     m_spkr_sample_rates);
 
 /**
- * @brief   Audio class specific format III descriptor
+ * @brief Consecutive frames without audio data after which the stream is considered stopped
  */
-APP_USBD_AUDIO_FORMAT_DESCRIPTOR(m_spkr_form_desc,
-                                 APP_USBD_AUDIO_AS_FORMAT_III_DSC(    /* Format type 3 descriptor */
-                                                                  2,  /* Number of channels */
-                                                                  2,  /* Subframe size */
-                                                                  16, /* Bit resolution */
-                                                                  1,  /* Frequency type */
-                                                                  APP_USBD_U24_TO_RAW_DSC(44100)) /* Frequency */
-);
+#ifndef USB_RX_IDLE_FRAMES
+#define USB_RX_IDLE_FRAMES 2
+#endif
 
 /**
- * @brief   Audio class input terminal descriptor
+ * @brief The size of last received block from
  */
-APP_USBD_AUDIO_INPUT_DESCRIPTOR(
-  m_spkr_inp_desc,
-  APP_USBD_AUDIO_INPUT_TERMINAL_DSC(1,                                     /* Terminal ID */
-                                    APP_USBD_AUDIO_TERMINAL_USB_STREAMING, /* Terminal type */
-                                    2,                                     /* Number of channels */
-                                    SPKR_TERMINAL_CH_CONFIG())             /* Channels config */
-);
+static size_t m_rx_packet_size;
 
 /**
- * @brief   Audio class output terminal descriptor
+ * @brief Actual speaker mute
  */
-APP_USBD_AUDIO_OUTPUT_DESCRIPTOR(
-  m_spkr_out_desc,
-  APP_USBD_AUDIO_OUTPUT_TERMINAL_DSC(3,                                   /* Terminal ID */
-                                     APP_USBD_AUDIO_TERMINAL_OUT_SPEAKER, /* Terminal type */
-                                     2)                                   /* Source ID */
-);
+static uint8_t m_mute_spkr;
 
 /**
- * @brief   Audio class feature unit descriptor
+ * @brief Actual speaker volume in 1/256 dB units
  */
-APP_USBD_AUDIO_FEATURE_DESCRIPTOR(m_spkr_fea_desc,
-                                  APP_USBD_AUDIO_FEATURE_UNIT_DSC(2,                       /* Unit ID */
-                                                                  1,                       /* Source ID */
-                                                                  SPKR_FEATURE_CONTROLS()) /* List of controls */
-);
+static int16_t m_volume_spkr = USB_VOLUME_MAX;
 
-/* Interfaces lists */
+/**
+ * @brief Actual sampling frequency
+ */
+static uint32_t m_freq_spkr = 44100;
 
 /**
- * @brief Interfaces list passed to @ref APP_USBD_AUDIO_GLOBAL_DEF
+ * @brief Audio data was received since the last stream stop
  */
-#define SPKR_INTERFACES_CONFIG() APP_USBD_AUDIO_CONFIG_OUT(0, 1)
+static bool m_rx_active;
 
 /**
- * @brief Speaker Audio class instance
+ * @brief Consecutive SOFs without received audio data
  */
-APP_USBD_AUDIO_GLOBAL_DEF(m_app_audio_speakers,
-                          SPKR_INTERFACES_CONFIG(),
-                          spkr_audio_user_ev_handler,
-                          &m_spkr_form_desc,
-                          &m_spkr_inp_desc,
-                          &m_spkr_out_desc,
-                          &m_spkr_fea_desc,
-                          0,
-                          APP_USBD_AUDIO_AS_IFACE_FORMAT_PCM,
-                          USB_RX_PACKET_SIZE,
-                          APP_USBD_AUDIO_SUBCLASS_AUDIOSTREAMING,
-                          1);
-
-APP_TIMER_DEF(m_rx_timeout_timer);
-
-#define USB_RX_TIMEOUT APP_TIMER_TICKS(2)
+static uint8_t m_rx_idle_frames;
 
 /**
- * @brief The size of last received block from
+ * @brief Configured state was seen at the last SOF
  */
-static size_t m_rx_packet_size;
+static bool m_configured;
+
+static usb_event_handler_t      m_usb_event_handler = NULL;
+static usb_rx_handlers_t const *mp_rx_handlers      = NULL;
+
+static struct
+{
+    uint32_t rx_packets;
+    uint32_t rx_dropped;      /**< Packets not armed because there was no room for them. */
+    uint32_t rx_start_errors; /**< Packets not armed because the transfer could not be started. */
+    uint32_t rx_timeouts;
+} m_stats;
 
 /**
- * @brief Actual speaker mute
+ * @brief Feature unit GET request handle (speakers)
  */
-static uint8_t m_mute_spkr;
+static void spkr_feature_get(usb_audio_req_t *p_req)
+{
+    int16_t volume;
+
+    switch (p_req->control)
+    {
+        case USB_AUDIO_FU_CONTROL_MUTE:
+            if (p_req->req_type == USB_AUDIO_REQ_GET_CUR)
+            {
+                p_req->payload[0] = m_mute_spkr;
+            }
+            break;
+        case USB_AUDIO_FU_CONTROL_VOLUME:
+            switch (p_req->req_type)
+            {
+                case USB_AUDIO_REQ_GET_CUR:
+                    volume = m_volume_spkr;
+                    break;
+                case USB_AUDIO_REQ_GET_MIN:
+                    volume = USB_VOLUME_MIN;
+                    break;
+                case USB_AUDIO_REQ_GET_MAX:
+                    volume = USB_VOLUME_MAX;
+                    break;
+                case USB_AUDIO_REQ_GET_RES:
+                    volume = USB_VOLUME_RES;
+                    break;
+                default:
+                    return;
+            }
+
+            UNUSED_RETURN_VALUE(uint16_encode((uint16_t)volume, p_req->payload));
+            break;
+        default:
+            break;
+    }
+}
 
 /**
- * @brief Actual sampling frequency
+ * @brief Feature unit SET_CUR request handle (speakers)
  */
-static uint32_t m_freq_spkr;
+static void spkr_feature_set(usb_audio_req_t *p_req)
+{
+    switch (p_req->control)
+    {
+        case USB_AUDIO_FU_CONTROL_MUTE:
+            if (p_req->channel == 0)
+            {
+                usb_event_t event = USB_EVENT_TYPE_MUTE_SET_DEF(p_req->payload[0]);
+                m_usb_event_handler(&event);
+            }
+
+            m_mute_spkr = p_req->payload[0];
+            break;
+        case USB_AUDIO_FU_CONTROL_VOLUME:
+            if (p_req->channel == 0) // Channel volume controls are not exposed
+            {
+                int16_t volume = (int16_t)uint16_decode(p_req->payload);
 
-static usb_event_handler_t m_usb_event_handler = NULL;
+                m_volume_spkr = MIN(MAX(volume, USB_VOLUME_MIN), USB_VOLUME_MAX);
+
+                usb_event_t event = USB_EVENT_TYPE_VOLUME_SET_DEF(m_volume_spkr);
+                m_usb_event_handler(&event);
+            }
+            break;
+        default:
+            break;
+    }
+}
 
 /**
  * @brief Audio class specific request handle (speakers)
  */
 static void spkr_audio_user_class_req(app_usbd_class_inst_t const *p_inst)
 {
-    app_usbd_audio_t const *p_audio = app_usbd_audio_class_get(p_inst);
-    app_usbd_audio_req_t   *p_req   = app_usbd_audio_class_request_get(p_audio);
-
-    UNUSED_VARIABLE(m_mute_spkr);
-    UNUSED_VARIABLE(m_freq_spkr);
+    usb_audio_req_t *p_req = usb_audio_request_get(p_inst);
 
     switch (p_req->req_target)
     {
-        case APP_USBD_AUDIO_CLASS_REQ_IN:
-            if (p_req->req_type == APP_USBD_AUDIO_REQ_SET_CUR)
+        case USB_AUDIO_CLASS_REQ_IN:
+            spkr_feature_get(p_req);
+            break;
+        case USB_AUDIO_CLASS_REQ_OUT:
+            if (p_req->req_type == USB_AUDIO_REQ_SET_CUR)
             {
-                // Only mute control is defined
-                p_req->payload[0] = m_mute_spkr;
-                NRF_LOG_INFO("Mute spkr 1 0x%x", m_mute_spkr);
+                spkr_feature_set(p_req);
             }
             break;
-        case APP_USBD_AUDIO_CLASS_REQ_OUT:
-
-            if (p_req->req_type == APP_USBD_AUDIO_REQ_SET_CUR)
+        case USB_AUDIO_EP_REQ_IN:
+            if ((p_req->req_type == USB_AUDIO_REQ_GET_CUR) && (p_req->control == USB_AUDIO_EP_CONTROL_SAMPLING_FREQ))
             {
-                if (p_req->channel == 0)
-                {
-                    usb_event_t event = USB_EVENT_TYPE_MUTE_SET_DEF(p_req->payload[0]);
-                    m_usb_event_handler(&event);
-                }
-
-                m_mute_spkr = p_req->payload[0];
-                // Only mute control is defined
-                NRF_LOG_INFO("Mute spkr 2 0x%x 0x%x", m_mute_spkr, p_req->channel);
-                // m_usb_event_handler();
+                uint24_encode(m_freq_spkr, p_req->payload);
             }
             break;
-        case APP_USBD_AUDIO_EP_REQ_IN:
-            break;
-        case APP_USBD_AUDIO_EP_REQ_OUT:
-            if (p_req->req_type == APP_USBD_AUDIO_REQ_SET_CUR)
+        case USB_AUDIO_EP_REQ_OUT:
+            if ((p_req->req_type == USB_AUDIO_REQ_SET_CUR) && (p_req->control == USB_AUDIO_EP_CONTROL_SAMPLING_FREQ))
             {
-                // Only set frequency is supported
                 m_freq_spkr = uint24_decode(p_req->payload);
+
+                usb_event_t event = USB_EVENT_TYPE_SAMPLE_RATE_SET_DEF(m_freq_spkr);
+                m_usb_event_handler(&event);
             }
             break;
         default:
@@ -217,27 +250,38 @@ static void spkr_audio_user_class_req(app_usbd_class_inst_t const *p_inst)
 }
 
 /**
- * @brief User event handler @ref app_usbd_audio_user_ev_handler_t (speaker)
+ * @brief User event handler @ref usb_audio_user_ev_handler_t (speaker)
  */
-static void spkr_audio_user_ev_handler(app_usbd_class_inst_t const *p_inst, app_usbd_audio_user_event_t event)
+static void spkr_audio_user_ev_handler(app_usbd_class_inst_t const *p_inst, usb_audio_user_event_t event)
 {
-    ret_code_t              err_code;
-    app_usbd_audio_t const *p_audio = app_usbd_audio_class_get(p_inst);
-    UNUSED_VARIABLE(p_audio);
+    ret_code_t err_code;
+
     switch (event)
     {
-        case APP_USBD_AUDIO_USER_EVT_CLASS_REQ:
+        case USB_AUDIO_USER_EVT_CLASS_REQ:
             spkr_audio_user_class_req(p_inst);
             break;
-        case APP_USBD_AUDIO_USER_EVT_RX_DONE:
+        case USB_AUDIO_USER_EVT_RX_DONE:
             {
-                err_code = app_timer_stop(m_rx_timeout_timer);                        // TODO
-                APP_ERROR_CHECK(err_code);
-                err_code = app_timer_start(m_rx_timeout_timer, USB_RX_TIMEOUT, NULL); // TODO
+                err_code = mp_rx_handlers->buffer_release(m_rx_packet_size);
                 APP_ERROR_CHECK(err_code);
 
-                usb_event_t event = USB_EVENT_TYPE_RX_DONE_DEF(m_rx_packet_size);
-                m_usb_event_handler(&event);
+                m_rx_active = true;
+                m_stats.rx_packets++;
+                telemetry_packet(m_rx_packet_size);
+                telemetry_trace(TELEMETRY_TRACE_USB_RX, (uint16_t)m_rx_packet_size);
+            }
+            break;
+        case USB_AUDIO_USER_EVT_ALT_SET:
+            {
+                uint8_t alternate = usb_audio_alternate_get(p_inst);
+
+                // Set here rather than from the scheduler, the first packet may arrive in the next frame
+                if (alternate != 0)
+                {
+                    err_code = mp_rx_handlers->format_set(m_spkr_formats[alternate - 1].subframe_size);
+                    APP_ERROR_CHECK(err_code);
+                }
             }
             break;
         default:
@@ -245,27 +289,97 @@ static void spkr_audio_user_ev_handler(app_usbd_class_inst_t const *p_inst, app_
     }
 }
 
+/**
+ * @brief Arm the ISO OUT transfer for the packet received in this frame straight into the codec buffer.
+ */
+static void spkr_rx_arm(size_t size)
+{
+    ret_code_t err_code;
+    void      *p_buffer = mp_rx_handlers->buffer_get(size);
+
+    if (p_buffer == NULL)
+    {
+        m_stats.rx_dropped++;
+        telemetry_count(TELEMETRY_COUNTER_POOL_EXHAUSTED);
+        telemetry_trace(TELEMETRY_TRACE_USB_RX_DROP, (uint16_t)size);
+        return;
+    }
+
+    err_code = usb_audio_rx_start(usb_audio_class_inst_get(&m_app_audio_speakers), p_buffer, size);
+
+    if (err_code != NRF_SUCCESS)
+    {
+        mp_rx_handlers->buffer_cancel();
+        m_stats.rx_start_errors++;
+    }
+}
+
 static void spkr_sof_ev_handler(uint16_t frame_cnt)
 {
+    ret_code_t                   err_code;
+    app_usbd_class_inst_t const *p_inst = usb_audio_class_inst_get(&m_app_audio_speakers);
+
+    PROFILE_SCOPE(PROFILE_PROBE_USB_SOF);
     UNUSED_VARIABLE(frame_cnt);
     if (APP_USBD_STATE_Configured != app_usbd_core_state_get())
     {
+        m_configured = false;
         return;
     }
-    m_rx_packet_size = app_usbd_audio_class_rx_size_get(&m_app_audio_speakers.base);
 
-    if (m_rx_packet_size > 0)
+    if (!m_configured)
     {
-        ASSERT(m_rx_packet_size <= USB_RX_PACKET_SIZE);
+        // SET_CONFIGURATION has no user event of its own, the next SOF follows it within a frame
+        usb_event_t event = USB_EVENT_DEF(USB_EVENT_USB_CONFIGURED);
 
-        usb_event_t event = USB_EVENT_TYPE_RX_BUFFER_REQUEST_DEF(m_rx_packet_size);
+        m_configured = true;
         m_usb_event_handler(&event);
     }
+
+    if (usb_audio_alternate_get(p_inst) != 0)
+    {
+        // Not read by the host yet is fine, the queued value is only a few frames old
+        UNUSED_RETURN_VALUE(usb_audio_feedback_set(p_inst, mp_rx_handlers->feedback_get()));
+    }
+
+    m_rx_packet_size = usb_audio_rx_size_get(p_inst);
+
+    if (m_rx_packet_size > 0)
+    {
+        ASSERT(m_rx_packet_size <= usb_audio_packet_size_max(p_inst, usb_audio_alternate_get(p_inst)));
+
+        m_rx_idle_frames = 0;
+        spkr_rx_arm(m_rx_packet_size);
+        return;
+    }
+
+    if (!m_rx_active || (++m_rx_idle_frames < USB_RX_IDLE_FRAMES))
+    {
+        return;
+    }
+
+    // Host stopped streaming, flush whatever is left of the last block
+    usb_event_t event = USB_EVENT_DEF(USB_EVENT_TYPE_RX_TIMEOUT);
+
+    m_rx_active      = false;
+    m_rx_idle_frames = 0;
+
+    err_code = mp_rx_handlers->buffer_release_unfinished();
+    APP_ERROR_CHECK(err_code);
+
+    m_stats.rx_timeouts++;
+    telemetry_count(TELEMETRY_COUNTER_RX_TIMEOUT);
+    telemetry_trace(TELEMETRY_TRACE_USB_RX_TIMEOUT, 0);
+    m_usb_event_handler(&event);
 }
 
 /**
  * @brief USBD library specific event handler.
  *
+ * Driver events come from the USBD interrupt. Power events come from the SoftDevice SoC observer, which runs from
+ * the scheduler. The library is not reentrant, so the USBD interrupt is kept out while a power event enables, starts
+ * or stops it. That only happens on plug and unplug, when no audio streams.
+ *
  * @param event     USBD library event.
  */
 static void usbd_user_ev_handler(app_usbd_event_type_t event)
@@ -290,57 +404,55 @@ static void usbd_user_ev_handler(app_usbd_event_type_t event)
             {
                 usb_event_t event = USB_EVENT_DEF(USB_EVENT_USB_REMOVED);
 
-                app_usbd_disable();
+                app_usbd_disable(); // Still inside the critical region of app_usbd_stop() below
                 m_usb_event_handler(&event);
             }
             break;
         case APP_USBD_EVT_POWER_DETECTED:
-            NRF_LOG_INFO("USB power detected");
+            CRITICAL_REGION_ENTER();
+
             if (!nrf_drv_usbd_is_enabled())
             {
                 app_usbd_enable();
             }
+
+            CRITICAL_REGION_EXIT();
             break;
         case APP_USBD_EVT_POWER_REMOVED:
-            NRF_LOG_INFO("USB power removed");
+            CRITICAL_REGION_ENTER();
             app_usbd_stop();
+            CRITICAL_REGION_EXIT();
             break;
         case APP_USBD_EVT_POWER_READY:
-            NRF_LOG_INFO("USB ready");
+            CRITICAL_REGION_ENTER();
             app_usbd_start();
+            CRITICAL_REGION_EXIT();
             break;
         default:
             break;
     }
 }
 
-static void usb_rx_timeout_handler(void *p_context)
-{
-    usb_event_t event = USB_EVENT_DEF(USB_EVENT_TYPE_RX_TIMEOUT);
-    m_usb_event_handler(&event);
-}
-
-ret_code_t usb_init(usb_event_handler_t evt_handler)
+ret_code_t usb_init(usb_event_handler_t evt_handler, usb_rx_handlers_t const *p_rx_handlers)
 {
     ret_code_t ret;
 
     static const app_usbd_config_t usbd_config = {.ev_state_proc = usbd_user_ev_handler, .enable_sof = true};
 
     VERIFY_PARAM_NOT_NULL(evt_handler);
+    VERIFY_PARAM_NOT_NULL(p_rx_handlers);
 
     m_usb_event_handler = evt_handler;
-
-    ret = app_timer_create(&m_rx_timeout_timer, APP_TIMER_MODE_SINGLE_SHOT, usb_rx_timeout_handler);
-    VERIFY_SUCCESS(ret);
+    mp_rx_handlers      = p_rx_handlers;
 
     nrf_drv_clock_init();
 
     ret = app_usbd_init(&usbd_config);
     VERIFY_SUCCESS(ret);
 
-    app_usbd_class_inst_t const *class_inst_spkr = app_usbd_audio_class_inst_get(&m_app_audio_speakers);
+    app_usbd_class_inst_t const *class_inst_spkr = usb_audio_class_inst_get(&m_app_audio_speakers);
 
-    ret = app_usbd_audio_sof_interrupt_register(class_inst_spkr, spkr_sof_ev_handler);
+    ret = usb_audio_sof_interrupt_register(class_inst_spkr, spkr_sof_ev_handler);
     VERIFY_SUCCESS(ret);
 
     ret = app_usbd_class_append(class_inst_spkr);
@@ -349,21 +461,8 @@ ret_code_t usb_init(usb_event_handler_t evt_handler)
     return app_usbd_power_events_enable();
 }
 
-void usb_rx_buffer_reply(void *p_buff, size_t size)
-{
-    ret_code_t ret;
-    ret = app_usbd_audio_class_rx_start(&m_app_audio_speakers.base, p_buff, size);
-
-    if (ret != NRF_SUCCESS)
-    {
-        NRF_LOG_ERROR("Could not start an RX transfer");
-    }
-}
-
-bool usb_event_queue_process(void) { return app_usbd_event_queue_process(); }
-
-void usb_stop(void)
+void usb_debug(void)
 {
-    // app_usbd_stop();
-    app_usbd_disable();
+    NRF_LOG_INFO("USB rx packets %u, timeouts %u", m_stats.rx_packets, m_stats.rx_timeouts);
+    NRF_LOG_INFO("USB rx dropped %u, start errors %u", m_stats.rx_dropped, m_stats.rx_start_errors);
 }
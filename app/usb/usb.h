@@ -14,6 +14,7 @@
 
 #include <stdbool.h>
 #include <stddef.h>
+#include <stdint.h>
 
 #include "sdk_errors.h"
 
@@ -21,11 +22,12 @@ typedef enum
 {
     USB_EVENT_USB_CONNECTED,
     USB_EVENT_USB_REMOVED,
-    USB_EVENT_TYPE_RX_BUFFER_REQUEST,
-    USB_EVENT_TYPE_RX_DONE,
-    USB_EVENT_TYPE_RX_TIMEOUT,
+    USB_EVENT_USB_CONFIGURED,  /**< Raised from the first SOF after SET_CONFIGURATION. */
+    USB_EVENT_TYPE_RX_TIMEOUT, /**< Stream stopped, the unfinished buffer has already been released. */
     USB_EVENT_TYPE_MUTE_STATUS_REQ,
-    USB_EVENT_TYPE_MUTE_SET
+    USB_EVENT_TYPE_MUTE_SET,
+    USB_EVENT_TYPE_SAMPLE_RATE_SET,
+    USB_EVENT_TYPE_VOLUME_SET
 } usb_event_type_t;
 
 typedef struct
@@ -33,19 +35,33 @@ typedef struct
     usb_event_type_t evt_type;
     union
     {
-        size_t size;
-        bool   mute;
+        bool     mute;
+        uint32_t sample_rate;
+        int16_t  volume; /**< Volume in 1/256 dB units. */
     } params;
 } usb_event_t;
 
+/**
+ * @brief USB event handler. Called from the USBD interrupt, connect and remove events may come from the scheduler.
+ */
 typedef void (*usb_event_handler_t)(usb_event_t *p_event);
 
-ret_code_t usb_init(usb_event_handler_t evt_handler);
-
-void usb_rx_buffer_reply(void *p_buff, size_t size);
+/**
+ * @brief Audio data handlers. Called from the USBD interrupt, received packets are written straight into the buffers
+ *        they return.
+ */
+typedef struct
+{
+    void *(*buffer_get)(size_t size);                /**< Get room for a packet, NULL drops it. */
+    ret_code_t (*buffer_release)(size_t size);       /**< Packet received. */
+    void (*buffer_cancel)(void);                     /**< Packet will not be received, return the buffer. */
+    ret_code_t (*buffer_release_unfinished)(void);   /**< Stream stopped, flush a partially filled buffer. */
+    uint32_t (*feedback_get)(void);                  /**< Samples per frame for the feedback endpoint, 10.14 format. */
+    ret_code_t (*format_set)(uint8_t subframe_size); /**< Streaming alternate setting selected, bytes per sample. */
+} usb_rx_handlers_t;
 
-bool usb_event_queue_process(void);
+ret_code_t usb_init(usb_event_handler_t evt_handler, usb_rx_handlers_t const *p_rx_handlers);
 
-void usb_stop(void);
+void usb_debug(void);
 
 #endif // USB_H
@@ -0,0 +1,483 @@
+/**
+ * @file        usb_audio.c
+ * @author      Danius Kalvaitis (danius.kalvaitis@gmail.com)
+ * @brief       Asynchronous USB Audio Class 1 speaker class for app_usbd.
+ * @version     0.1
+ * @date        2026-10-17
+ *
+ * @copyright   Copyright (c) Danius Kalvaitis 2026 All rights reserved
+ *
+ * Written for the asynchronous rate feedback rather than patched into the SDK audio class: an explicit feedback
+ * endpoint needs a second endpoint on the streaming interface, bSynchAddress in the 9 byte data endpoint descriptor and
+ * a feedback endpoint descriptor with bRefresh. The SDK class builds its descriptors and endpoint list around a single
+ * ISO endpoint and has no hook for any of them. Control requests, sample rate and volume handling follow the SDK class,
+ * so usb.c only swapped the class it instantiates.
+ */
+
+#include "usb_audio.h"
+
+#include "app_usbd.h"
+#include "app_usbd_core.h"
+#include "app_util_platform.h"
+#include "sdk_common.h"
+
+#include "codec_rt.h" // Must stay the last include, poisons blocking calls
+
+#define USB_AUDIO_IFACE_IDX_CONTROL 0
+#define USB_AUDIO_IFACE_IDX_STREAM  1
+#define USB_AUDIO_EP_IDX_DATA       0
+#define USB_AUDIO_EP_IDX_FEEDBACK   1
+
+/* Audio Device Class 1.0 descriptor constants */
+#define USB_AUDIO_CLASS                  0x01
+#define USB_AUDIO_SUBCLASS_CONTROL       0x01
+#define USB_AUDIO_SUBCLASS_STREAMING     0x02
+#define USB_AUDIO_CS_INTERFACE           0x24
+#define USB_AUDIO_CS_ENDPOINT            0x25
+#define USB_AUDIO_AC_HEADER              0x01
+#define USB_AUDIO_AC_INPUT_TERMINAL      0x02
+#define USB_AUDIO_AC_OUTPUT_TERMINAL     0x03
+#define USB_AUDIO_AC_FEATURE_UNIT        0x06
+#define USB_AUDIO_AS_GENERAL             0x01
+#define USB_AUDIO_AS_FORMAT_TYPE         0x02
+#define USB_AUDIO_EP_GENERAL             0x01
+#define USB_AUDIO_FORMAT_TYPE_I          0x01
+#define USB_AUDIO_FORMAT_PCM             0x0001
+#define USB_AUDIO_TERMINAL_USB_STREAMING 0x0101
+#define USB_AUDIO_TERMINAL_SPEAKER       0x0301
+#define USB_AUDIO_CHANNEL_CONFIG         0x0003 /**< Left front, right front. */
+#define USB_AUDIO_INPUT_TERMINAL_ID      1
+#define USB_AUDIO_OUTPUT_TERMINAL_ID     3
+#define USB_AUDIO_FU_CONTROLS_MASTER     0x03 /**< Mute and volume. */
+#define USB_AUDIO_EP_ISO_ASYNC           0x05
+#define USB_AUDIO_EP_ISO                 0x01
+#define USB_AUDIO_EP_CONTROLS            0x01 /**< Sampling frequency control. */
+
+#define USB_AUDIO_AC_HEADER_SIZE         9
+#define USB_AUDIO_INPUT_TERMINAL_SIZE    12
+#define USB_AUDIO_FEATURE_UNIT_SIZE      (7 + (USB_AUDIO_CHANNELS + 1))
+#define USB_AUDIO_OUTPUT_TERMINAL_SIZE   9
+#define USB_AUDIO_AC_SIZE                                                                                              \
+    (USB_AUDIO_AC_HEADER_SIZE + USB_AUDIO_INPUT_TERMINAL_SIZE + USB_AUDIO_FEATURE_UNIT_SIZE +                          \
+     USB_AUDIO_OUTPUT_TERMINAL_SIZE)
+
+static inline usb_audio_t const *usb_audio_get(app_usbd_class_inst_t const *p_inst)
+{
+    return (usb_audio_t const *)p_inst;
+}
+
+static inline usb_audio_ctx_t *usb_audio_ctx_get(usb_audio_t const *p_audio) { return &p_audio->specific.p_data->ctx; }
+
+static nrf_drv_usbd_ep_t usb_audio_ep_get(app_usbd_class_inst_t const *p_inst, uint8_t ep_idx)
+{
+    app_usbd_class_iface_conf_t const *p_iface = app_usbd_class_iface_get(p_inst, USB_AUDIO_IFACE_IDX_STREAM);
+
+    return app_usbd_class_ep_address_get(app_usbd_class_iface_ep_get(p_iface, ep_idx));
+}
+
+static void usb_audio_user_event(app_usbd_class_inst_t const *p_inst, usb_audio_user_event_t event)
+{
+    usb_audio_t const *p_audio = usb_audio_get(p_inst);
+
+    if (p_audio->specific.inst.user_ev_handler != NULL)
+    {
+        p_audio->specific.inst.user_ev_handler(p_inst, event);
+    }
+}
+
+static ret_code_t usb_audio_req_out_data_cb(nrf_drv_usbd_ep_status_t status, void *p_context)
+{
+    if (status == NRF_USBD_EP_OK)
+    {
+        usb_audio_user_event((app_usbd_class_inst_t const *)p_context, USB_AUDIO_USER_EVT_CLASS_REQ);
+    }
+
+    return NRF_SUCCESS;
+}
+
+static ret_code_t usb_audio_setup_event_handler(app_usbd_class_inst_t const *p_inst,
+                                                app_usbd_setup_evt_t const  *p_setup_ev)
+{
+    ret_code_t       err_code;
+    usb_audio_ctx_t *p_ctx     = usb_audio_ctx_get(usb_audio_get(p_inst));
+    usb_audio_req_t *p_req     = &p_ctx->request;
+    uint8_t          recipient = app_usbd_setup_req_rec(p_setup_ev->setup.bmRequestType);
+    bool             dir_in    = app_usbd_setup_req_dir(p_setup_ev->setup.bmRequestType) == APP_USBD_SETUP_REQDIR_IN;
+
+    // Standard requests, alternate settings included, are handled by the core through the class methods
+    if (app_usbd_setup_req_typ(p_setup_ev->setup.bmRequestType) != APP_USBD_SETUP_REQTYPE_CLASS)
+    {
+        return NRF_ERROR_NOT_SUPPORTED;
+    }
+
+    if (((recipient != APP_USBD_SETUP_REQREC_INTERFACE) && (recipient != APP_USBD_SETUP_REQREC_ENDPOINT)) ||
+        (p_setup_ev->setup.wLength.w > sizeof(p_req->payload)))
+    {
+        return NRF_ERROR_NOT_SUPPORTED;
+    }
+
+    if (recipient == APP_USBD_SETUP_REQREC_INTERFACE)
+    {
+        p_req->req_target = dir_in ? USB_AUDIO_CLASS_REQ_IN : USB_AUDIO_CLASS_REQ_OUT;
+        p_req->entity     = p_setup_ev->setup.wIndex.hb;
+    } else
+    {
+        p_req->req_target = dir_in ? USB_AUDIO_EP_REQ_IN : USB_AUDIO_EP_REQ_OUT;
+        p_req->entity     = p_setup_ev->setup.wIndex.lb;
+    }
+
+    p_req->req_type = p_setup_ev->setup.bmRequest;
+    p_req->control  = p_setup_ev->setup.wValue.hb;
+    p_req->channel  = p_setup_ev->setup.wValue.lb;
+    p_req->length   = p_setup_ev->setup.wLength.w;
+
+    if (dir_in)
+    {
+        memset(p_req->payload, 0, sizeof(p_req->payload));
+        usb_audio_user_event(p_inst, USB_AUDIO_USER_EVT_CLASS_REQ);
+
+        return app_usbd_core_setup_rsp(&p_setup_ev->setup, p_req->payload, p_req->length);
+    }
+
+    // Data stage first, the request is passed on once the payload has arrived
+    NRF_DRV_USBD_TRANSFER_OUT(transfer, p_req->payload, p_req->length);
+
+    CRITICAL_REGION_ENTER();
+
+    err_code = app_usbd_ep_transfer(NRF_DRV_USBD_EPOUT0, &transfer);
+
+    if (err_code == NRF_SUCCESS)
+    {
+        app_usbd_core_setup_data_handler_desc_t desc = {.handler   = usb_audio_req_out_data_cb,
+                                                        .p_context = (void *)p_inst};
+
+        err_code = app_usbd_core_setup_data_handler_set(NRF_DRV_USBD_EPOUT0, &desc);
+    }
+
+    CRITICAL_REGION_EXIT();
+
+    return err_code;
+}
+
+static ret_code_t usb_audio_endpoint_event_handler(app_usbd_class_inst_t const  *p_inst,
+                                                   app_usbd_complex_evt_t const *p_event)
+{
+    if (NRF_USBD_EPIN_CHECK(p_event->drv_evt.data.eptransfer.ep))
+    {
+        return NRF_SUCCESS; // Feedback value sent
+    }
+
+    if (p_event->drv_evt.data.eptransfer.status == NRF_USBD_EP_OK)
+    {
+        usb_audio_user_event(p_inst, USB_AUDIO_USER_EVT_RX_DONE);
+        return NRF_SUCCESS;
+    }
+
+    return NRF_ERROR_INTERNAL;
+}
+
+static ret_code_t usb_audio_event_handler(app_usbd_class_inst_t const *const  p_inst,
+                                          app_usbd_complex_evt_t const *const p_event)
+{
+    switch (p_event->app_evt.type)
+    {
+        case APP_USBD_EVT_DRV_SETUP:
+            return usb_audio_setup_event_handler(p_inst, (app_usbd_setup_evt_t const *)p_event);
+        case APP_USBD_EVT_DRV_EPTRANSFER:
+            return usb_audio_endpoint_event_handler(p_inst, p_event);
+        default:
+            return NRF_ERROR_NOT_SUPPORTED;
+    }
+}
+
+static void usb_audio_stream_endpoints_set(app_usbd_class_inst_t const *p_inst, bool enable)
+{
+    for (uint8_t i = USB_AUDIO_EP_IDX_DATA; i <= USB_AUDIO_EP_IDX_FEEDBACK; i++)
+    {
+        nrf_drv_usbd_ep_t ep = usb_audio_ep_get(p_inst, i);
+
+        if (enable)
+        {
+            nrf_drv_usbd_ep_enable(ep);
+        } else
+        {
+            nrf_drv_usbd_ep_disable(ep);
+        }
+    }
+}
+
+static ret_code_t usb_audio_iface_select(app_usbd_class_inst_t const *const p_inst,
+                                         uint8_t                            iface_idx,
+                                         uint8_t                            alternate)
+{
+    usb_audio_t const *p_audio = usb_audio_get(p_inst);
+    usb_audio_ctx_t   *p_ctx   = usb_audio_ctx_get(p_audio);
+
+    if (iface_idx != USB_AUDIO_IFACE_IDX_STREAM)
+    {
+        return NRF_ERROR_NOT_SUPPORTED; // Control interface only has alternate setting 0, default handling
+    }
+
+    if (alternate > p_audio->specific.inst.format_count)
+    {
+        return NRF_ERROR_INVALID_PARAM;
+    }
+
+    usb_audio_stream_endpoints_set(p_inst, alternate != 0);
+
+    p_ctx->alternate = alternate;
+    usb_audio_user_event(p_inst, USB_AUDIO_USER_EVT_ALT_SET);
+
+    return NRF_SUCCESS;
+}
+
+static void usb_audio_iface_deselect(app_usbd_class_inst_t const *const p_inst, uint8_t iface_idx)
+{
+    usb_audio_ctx_t *p_ctx = usb_audio_ctx_get(usb_audio_get(p_inst));
+
+    if ((iface_idx != USB_AUDIO_IFACE_IDX_STREAM) || (p_ctx->alternate == 0))
+    {
+        return;
+    }
+
+    usb_audio_stream_endpoints_set(p_inst, false);
+
+    p_ctx->alternate = 0;
+    usb_audio_user_event(p_inst, USB_AUDIO_USER_EVT_ALT_SET);
+}
+
+static uint8_t usb_audio_iface_selection_get(app_usbd_class_inst_t const *const p_inst, uint8_t iface_idx)
+{
+    return (iface_idx == USB_AUDIO_IFACE_IDX_STREAM) ? usb_audio_ctx_get(usb_audio_get(p_inst))->alternate : 0;
+}
+
+/**
+ * @brief Write class descriptors. The feeder may be suspended at any write and resumed, state is kept in statics.
+ */
+static bool usb_audio_feed_descriptors(app_usbd_class_descriptor_ctx_t *p_ctx,
+                                       app_usbd_class_inst_t const     *p_inst,
+                                       uint8_t                         *p_buff,
+                                       size_t                           max_size)
+{
+    static usb_audio_t const *p_audio;
+    static uint8_t            iface_control;
+    static uint8_t            iface_stream;
+    static uint8_t            alt;
+    static uint8_t            i;
+    static uint16_t           packet_size;
+
+    p_audio       = usb_audio_get(p_inst);
+    iface_control = app_usbd_class_iface_number_get(app_usbd_class_iface_get(p_inst, USB_AUDIO_IFACE_IDX_CONTROL));
+    iface_stream  = app_usbd_class_iface_number_get(app_usbd_class_iface_get(p_inst, USB_AUDIO_IFACE_IDX_STREAM));
+
+    APP_USBD_CLASS_DESCRIPTOR_BEGIN(p_ctx, p_buff, max_size);
+
+    /* Audio control interface */
+    APP_USBD_CLASS_DESCRIPTOR_WRITE(0x09);
+    APP_USBD_CLASS_DESCRIPTOR_WRITE(APP_USBD_DESCRIPTOR_INTERFACE);
+    APP_USBD_CLASS_DESCRIPTOR_WRITE(iface_control);
+    APP_USBD_CLASS_DESCRIPTOR_WRITE(0x00); // bAlternateSetting
+    APP_USBD_CLASS_DESCRIPTOR_WRITE(0x00); // bNumEndpoints
+    APP_USBD_CLASS_DESCRIPTOR_WRITE(USB_AUDIO_CLASS);
+    APP_USBD_CLASS_DESCRIPTOR_WRITE(USB_AUDIO_SUBCLASS_CONTROL);
+    APP_USBD_CLASS_DESCRIPTOR_WRITE(0x00); // bInterfaceProtocol
+    APP_USBD_CLASS_DESCRIPTOR_WRITE(0x00); // iInterface
+
+    APP_USBD_CLASS_DESCRIPTOR_WRITE(USB_AUDIO_AC_HEADER_SIZE);
+    APP_USBD_CLASS_DESCRIPTOR_WRITE(USB_AUDIO_CS_INTERFACE);
+    APP_USBD_CLASS_DESCRIPTOR_WRITE(USB_AUDIO_AC_HEADER);
+    APP_USBD_CLASS_DESCRIPTOR_WRITE(0x00); // bcdADC 1.00
+    APP_USBD_CLASS_DESCRIPTOR_WRITE(0x01);
+    APP_USBD_CLASS_DESCRIPTOR_WRITE(LSB_16(USB_AUDIO_AC_SIZE));
+    APP_USBD_CLASS_DESCRIPTOR_WRITE(MSB_16(USB_AUDIO_AC_SIZE));
+    APP_USBD_CLASS_DESCRIPTOR_WRITE(0x01); // bInCollection
+    APP_USBD_CLASS_DESCRIPTOR_WRITE(iface_stream);
+
+    APP_USBD_CLASS_DESCRIPTOR_WRITE(USB_AUDIO_INPUT_TERMINAL_SIZE);
+    APP_USBD_CLASS_DESCRIPTOR_WRITE(USB_AUDIO_CS_INTERFACE);
+    APP_USBD_CLASS_DESCRIPTOR_WRITE(USB_AUDIO_AC_INPUT_TERMINAL);
+    APP_USBD_CLASS_DESCRIPTOR_WRITE(USB_AUDIO_INPUT_TERMINAL_ID);
+    APP_USBD_CLASS_DESCRIPTOR_WRITE(LSB_16(USB_AUDIO_TERMINAL_USB_STREAMING));
+    APP_USBD_CLASS_DESCRIPTOR_WRITE(MSB_16(USB_AUDIO_TERMINAL_USB_STREAMING));
+    APP_USBD_CLASS_DESCRIPTOR_WRITE(0x00); // bAssocTerminal
+    APP_USBD_CLASS_DESCRIPTOR_WRITE(USB_AUDIO_CHANNELS);
+    APP_USBD_CLASS_DESCRIPTOR_WRITE(LSB_16(USB_AUDIO_CHANNEL_CONFIG));
+    APP_USBD_CLASS_DESCRIPTOR_WRITE(MSB_16(USB_AUDIO_CHANNEL_CONFIG));
+    APP_USBD_CLASS_DESCRIPTOR_WRITE(0x00); // iChannelNames
+    APP_USBD_CLASS_DESCRIPTOR_WRITE(0x00); // iTerminal
+
+    APP_USBD_CLASS_DESCRIPTOR_WRITE(USB_AUDIO_FEATURE_UNIT_SIZE);
+    APP_USBD_CLASS_DESCRIPTOR_WRITE(USB_AUDIO_CS_INTERFACE);
+    APP_USBD_CLASS_DESCRIPTOR_WRITE(USB_AUDIO_AC_FEATURE_UNIT);
+    APP_USBD_CLASS_DESCRIPTOR_WRITE(USB_AUDIO_FEATURE_UNIT_ID);
+    APP_USBD_CLASS_DESCRIPTOR_WRITE(USB_AUDIO_INPUT_TERMINAL_ID);
+    APP_USBD_CLASS_DESCRIPTOR_WRITE(0x01); // bControlSize
+    APP_USBD_CLASS_DESCRIPTOR_WRITE(USB_AUDIO_FU_CONTROLS_MASTER);
+    for (i = 0; i < USB_AUDIO_CHANNELS; i++)
+    {
+        APP_USBD_CLASS_DESCRIPTOR_WRITE(0x00); // No per channel controls
+    }
+    APP_USBD_CLASS_DESCRIPTOR_WRITE(0x00); // iFeature
+
+    APP_USBD_CLASS_DESCRIPTOR_WRITE(USB_AUDIO_OUTPUT_TERMINAL_SIZE);
+    APP_USBD_CLASS_DESCRIPTOR_WRITE(USB_AUDIO_CS_INTERFACE);
+    APP_USBD_CLASS_DESCRIPTOR_WRITE(USB_AUDIO_AC_OUTPUT_TERMINAL);
+    APP_USBD_CLASS_DESCRIPTOR_WRITE(USB_AUDIO_OUTPUT_TERMINAL_ID);
+    APP_USBD_CLASS_DESCRIPTOR_WRITE(LSB_16(USB_AUDIO_TERMINAL_SPEAKER));
+    APP_USBD_CLASS_DESCRIPTOR_WRITE(MSB_16(USB_AUDIO_TERMINAL_SPEAKER));
+    APP_USBD_CLASS_DESCRIPTOR_WRITE(0x00); // bAssocTerminal
+    APP_USBD_CLASS_DESCRIPTOR_WRITE(USB_AUDIO_FEATURE_UNIT_ID);
+    APP_USBD_CLASS_DESCRIPTOR_WRITE(0x00); // iTerminal
+
+    /* Audio streaming interface, alternate setting 0 has no endpoints */
+    for (alt = 0; alt <= p_audio->specific.inst.format_count; alt++)
+    {
+        APP_USBD_CLASS_DESCRIPTOR_WRITE(0x09);
+        APP_USBD_CLASS_DESCRIPTOR_WRITE(APP_USBD_DESCRIPTOR_INTERFACE);
+        APP_USBD_CLASS_DESCRIPTOR_WRITE(iface_stream);
+        APP_USBD_CLASS_DESCRIPTOR_WRITE(alt);
+        APP_USBD_CLASS_DESCRIPTOR_WRITE((alt == 0) ? 0x00 : 0x02); // Data and feedback endpoints
+        APP_USBD_CLASS_DESCRIPTOR_WRITE(USB_AUDIO_CLASS);
+        APP_USBD_CLASS_DESCRIPTOR_WRITE(USB_AUDIO_SUBCLASS_STREAMING);
+        APP_USBD_CLASS_DESCRIPTOR_WRITE(0x00); // bInterfaceProtocol
+        APP_USBD_CLASS_DESCRIPTOR_WRITE(0x00); // iInterface
+
+        if (alt == 0)
+        {
+            continue;
+        }
+
+        APP_USBD_CLASS_DESCRIPTOR_WRITE(0x07);
+        APP_USBD_CLASS_DESCRIPTOR_WRITE(USB_AUDIO_CS_INTERFACE);
+        APP_USBD_CLASS_DESCRIPTOR_WRITE(USB_AUDIO_AS_GENERAL);
+        APP_USBD_CLASS_DESCRIPTOR_WRITE(USB_AUDIO_INPUT_TERMINAL_ID);
+        APP_USBD_CLASS_DESCRIPTOR_WRITE(0x01); // bDelay in frames
+        APP_USBD_CLASS_DESCRIPTOR_WRITE(LSB_16(USB_AUDIO_FORMAT_PCM));
+        APP_USBD_CLASS_DESCRIPTOR_WRITE(MSB_16(USB_AUDIO_FORMAT_PCM));
+
+        APP_USBD_CLASS_DESCRIPTOR_WRITE(8 + 3 * p_audio->specific.inst.sample_rate_count);
+        APP_USBD_CLASS_DESCRIPTOR_WRITE(USB_AUDIO_CS_INTERFACE);
+        APP_USBD_CLASS_DESCRIPTOR_WRITE(USB_AUDIO_AS_FORMAT_TYPE);
+        APP_USBD_CLASS_DESCRIPTOR_WRITE(USB_AUDIO_FORMAT_TYPE_I);
+        APP_USBD_CLASS_DESCRIPTOR_WRITE(USB_AUDIO_CHANNELS);
+        APP_USBD_CLASS_DESCRIPTOR_WRITE(p_audio->specific.inst.p_formats[alt - 1].subframe_size);
+        APP_USBD_CLASS_DESCRIPTOR_WRITE(p_audio->specific.inst.p_formats[alt - 1].bit_resolution);
+        APP_USBD_CLASS_DESCRIPTOR_WRITE(p_audio->specific.inst.sample_rate_count);
+        for (i = 0; i < p_audio->specific.inst.sample_rate_count; i++)
+        {
+            APP_USBD_CLASS_DESCRIPTOR_WRITE((uint8_t)p_audio->specific.inst.p_sample_rates[i]);
+            APP_USBD_CLASS_DESCRIPTOR_WRITE((uint8_t)(p_audio->specific.inst.p_sample_rates[i] >> 8));
+            APP_USBD_CLASS_DESCRIPTOR_WRITE((uint8_t)(p_audio->specific.inst.p_sample_rates[i] >> 16));
+        }
+
+        packet_size = (uint16_t)usb_audio_packet_size_max(p_inst, alt);
+
+        // Asynchronous data endpoint, paced by the feedback endpoint
+        APP_USBD_CLASS_DESCRIPTOR_WRITE(0x09);
+        APP_USBD_CLASS_DESCRIPTOR_WRITE(APP_USBD_DESCRIPTOR_ENDPOINT);
+        APP_USBD_CLASS_DESCRIPTOR_WRITE(usb_audio_ep_get(p_inst, USB_AUDIO_EP_IDX_DATA));
+        APP_USBD_CLASS_DESCRIPTOR_WRITE(USB_AUDIO_EP_ISO_ASYNC);
+        APP_USBD_CLASS_DESCRIPTOR_WRITE(LSB_16(packet_size));
+        APP_USBD_CLASS_DESCRIPTOR_WRITE(MSB_16(packet_size));
+        APP_USBD_CLASS_DESCRIPTOR_WRITE(0x01); // bInterval
+        APP_USBD_CLASS_DESCRIPTOR_WRITE(0x00); // bRefresh
+        APP_USBD_CLASS_DESCRIPTOR_WRITE(usb_audio_ep_get(p_inst, USB_AUDIO_EP_IDX_FEEDBACK)); // bSynchAddress
+
+        APP_USBD_CLASS_DESCRIPTOR_WRITE(0x07);
+        APP_USBD_CLASS_DESCRIPTOR_WRITE(USB_AUDIO_CS_ENDPOINT);
+        APP_USBD_CLASS_DESCRIPTOR_WRITE(USB_AUDIO_EP_GENERAL);
+        APP_USBD_CLASS_DESCRIPTOR_WRITE(USB_AUDIO_EP_CONTROLS);
+        APP_USBD_CLASS_DESCRIPTOR_WRITE(0x00); // bLockDelayUnits
+        APP_USBD_CLASS_DESCRIPTOR_WRITE(0x00); // wLockDelay
+        APP_USBD_CLASS_DESCRIPTOR_WRITE(0x00);
+
+        APP_USBD_CLASS_DESCRIPTOR_WRITE(0x09);
+        APP_USBD_CLASS_DESCRIPTOR_WRITE(APP_USBD_DESCRIPTOR_ENDPOINT);
+        APP_USBD_CLASS_DESCRIPTOR_WRITE(usb_audio_ep_get(p_inst, USB_AUDIO_EP_IDX_FEEDBACK));
+        APP_USBD_CLASS_DESCRIPTOR_WRITE(USB_AUDIO_EP_ISO);
+        APP_USBD_CLASS_DESCRIPTOR_WRITE(USB_AUDIO_FEEDBACK_SIZE);
+        APP_USBD_CLASS_DESCRIPTOR_WRITE(0x00);
+        APP_USBD_CLASS_DESCRIPTOR_WRITE(0x01); // bInterval
+        APP_USBD_CLASS_DESCRIPTOR_WRITE(USB_AUDIO_FEEDBACK_REFRESH);
+        APP_USBD_CLASS_DESCRIPTOR_WRITE(0x00); // bSynchAddress
+    }
+
+    APP_USBD_CLASS_DESCRIPTOR_END();
+}
+
+const app_usbd_class_methods_t usb_audio_class_methods = {
+  .event_handler       = usb_audio_event_handler,
+  .feed_descriptors    = usb_audio_feed_descriptors,
+  .iface_select        = usb_audio_iface_select,
+  .iface_deselect      = usb_audio_iface_deselect,
+  .iface_selection_get = usb_audio_iface_selection_get,
+};
+
+usb_audio_req_t *usb_audio_request_get(app_usbd_class_inst_t const *p_inst)
+{
+    return &usb_audio_ctx_get(usb_audio_get(p_inst))->request;
+}
+
+uint8_t usb_audio_alternate_get(app_usbd_class_inst_t const *p_inst)
+{
+    return usb_audio_ctx_get(usb_audio_get(p_inst))->alternate;
+}
+
+size_t usb_audio_packet_size_max(app_usbd_class_inst_t const *p_inst, uint8_t alternate)
+{
+    usb_audio_inst_t const *p_config = &usb_audio_get(p_inst)->specific.inst;
+    uint32_t                rate_max = 0;
+
+    if ((alternate == 0) || (alternate > p_config->format_count))
+    {
+        return 0;
+    }
+
+    for (size_t i = 0; i < p_config->sample_rate_count; i++)
+    {
+        rate_max = MAX(rate_max, p_config->p_sample_rates[i]);
+    }
+
+    // One extra frame for the host catching up with the feedback
+    return (rate_max / 1000 + 1) * USB_AUDIO_CHANNELS * p_config->p_formats[alternate - 1].subframe_size;
+}
+
+ret_code_t usb_audio_sof_interrupt_register(app_usbd_class_inst_t const   *p_inst,
+                                            app_usbd_sof_interrupt_handler_t handler)
+{
+    return app_usbd_class_sof_interrupt_register(p_inst, handler);
+}
+
+size_t usb_audio_rx_size_get(app_usbd_class_inst_t const *p_inst)
+{
+    return nrf_drv_usbd_epout_size_get(usb_audio_ep_get(p_inst, USB_AUDIO_EP_IDX_DATA));
+}
+
+ret_code_t usb_audio_rx_start(app_usbd_class_inst_t const *p_inst, void *p_buf, size_t size)
+{
+    NRF_DRV_USBD_TRANSFER_OUT(transfer, p_buf, size);
+
+    return app_usbd_ep_transfer(usb_audio_ep_get(p_inst, USB_AUDIO_EP_IDX_DATA), &transfer);
+}
+
+ret_code_t usb_audio_feedback_set(app_usbd_class_inst_t const *p_inst, uint32_t feedback)
+{
+    usb_audio_ctx_t  *p_ctx = usb_audio_ctx_get(usb_audio_get(p_inst));
+    nrf_drv_usbd_ep_t ep    = usb_audio_ep_get(p_inst, USB_AUDIO_EP_IDX_FEEDBACK);
+
+    if (p_ctx->alternate == 0)
+    {
+        return NRF_ERROR_INVALID_STATE;
+    }
+
+    if (nrf_drv_usbd_ep_is_busy(ep)) // Buffer is owned by EasyDMA until the host has read it
+    {
+        return NRF_ERROR_BUSY;
+    }
+
+    UNUSED_RETURN_VALUE(uint24_encode(feedback, p_ctx->feedback));
+
+    NRF_DRV_USBD_TRANSFER_IN(transfer, p_ctx->feedback, sizeof(p_ctx->feedback));
+
+    return app_usbd_ep_transfer(ep, &transfer);
+}
@@ -0,0 +1,184 @@
+/**
+ * @file        usb_audio.h
+ * @author      Danius Kalvaitis (danius.kalvaitis@gmail.com)
+ * @brief       Asynchronous USB Audio Class 1 speaker class for app_usbd.
+ * @version     0.1
+ * @date        2026-10-17
+ *
+ * @copyright   Copyright (c) Danius Kalvaitis 2026 All rights reserved
+ *
+ * The SDK audio class only knows one streaming alternate setting and adaptive or synchronous endpoints. This class
+ * describes a stereo speaker with one streaming alternate setting per sample format and an asynchronous ISO OUT
+ * endpoint paired with an explicit feedback ISO IN endpoint, so the host paces its packets after the codec clock.
+ *
+ * Topology: USB streaming input terminal (ID 1) -> feature unit with mute and volume (ID 2) -> speaker (ID 3).
+ */
+
+#ifndef USB_AUDIO_H
+#define USB_AUDIO_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include "app_usbd_class_base.h"
+#include "app_util.h"
+#include "nrf_drv_usbd.h"
+#include "sdk_errors.h"
+
+#define USB_AUDIO_CHANNELS                 2
+#define USB_AUDIO_FEATURE_UNIT_ID          2
+#define USB_AUDIO_REQ_PAYLOAD_SIZE         8
+#define USB_AUDIO_FEEDBACK_SIZE            3 /**< Full speed feedback, 10.14 samples per frame. */
+#define USB_AUDIO_FEEDBACK_REFRESH         3 /**< Feedback is refreshed every 2^3 ms. */
+
+#define USB_AUDIO_REQ_SET_CUR              0x01
+#define USB_AUDIO_REQ_GET_CUR              0x81
+#define USB_AUDIO_REQ_GET_MIN              0x82
+#define USB_AUDIO_REQ_GET_MAX              0x83
+#define USB_AUDIO_REQ_GET_RES              0x84
+
+#define USB_AUDIO_FU_CONTROL_MUTE          0x01
+#define USB_AUDIO_FU_CONTROL_VOLUME        0x02
+#define USB_AUDIO_EP_CONTROL_SAMPLING_FREQ 0x01
+
+/**
+ * @brief Interface list of a class instance, @p iface_stream holds the ISO OUT endpoint and its feedback endpoint.
+ */
+#define USB_AUDIO_CONFIG(iface_control, iface_stream)                                                                  \
+    ((iface_control), (iface_stream, NRF_DRV_USBD_EPOUT8, NRF_DRV_USBD_EPIN8))
+
+typedef enum
+{
+    USB_AUDIO_USER_EVT_CLASS_REQ, /**< Class request in @ref usb_audio_request_get, fill the payload of IN requests. */
+    USB_AUDIO_USER_EVT_RX_DONE,   /**< ISO OUT transfer finished. */
+    USB_AUDIO_USER_EVT_ALT_SET    /**< Streaming alternate setting changed, see @ref usb_audio_alternate_get. */
+} usb_audio_user_event_t;
+
+typedef enum
+{
+    USB_AUDIO_CLASS_REQ_IN,  /**< Unit or terminal request, device to host. */
+    USB_AUDIO_CLASS_REQ_OUT, /**< Unit or terminal request, host to device. */
+    USB_AUDIO_EP_REQ_IN,     /**< Endpoint request, device to host. */
+    USB_AUDIO_EP_REQ_OUT     /**< Endpoint request, host to device. */
+} usb_audio_req_target_t;
+
+typedef struct
+{
+    usb_audio_req_target_t req_target;
+    uint8_t                req_type; /**< USB_AUDIO_REQ_* code. */
+    uint8_t                control;  /**< Control selector. */
+    uint8_t                channel;
+    uint8_t                entity; /**< Unit or terminal ID, endpoint address for endpoint requests. */
+    uint16_t               length;
+    uint8_t                payload[USB_AUDIO_REQ_PAYLOAD_SIZE];
+} usb_audio_req_t;
+
+/**
+ * @brief PCM sample format of one streaming alternate setting.
+ */
+typedef struct
+{
+    uint8_t subframe_size;  /**< Bytes per sample. */
+    uint8_t bit_resolution; /**< Valid bits per sample. */
+} usb_audio_format_t;
+
+typedef void (*usb_audio_user_ev_handler_t)(app_usbd_class_inst_t const *p_inst, usb_audio_user_event_t event);
+
+/**
+ * @brief Instance configuration. Alternate setting n streams p_formats[n - 1], alternate setting 0 is idle.
+ */
+typedef struct
+{
+    usb_audio_user_ev_handler_t user_ev_handler;
+    usb_audio_format_t const   *p_formats;
+    uint8_t                     format_count;
+    uint32_t const             *p_sample_rates;
+    uint8_t                     sample_rate_count;
+} usb_audio_inst_t;
+
+typedef struct
+{
+    usb_audio_req_t request;
+    uint8_t         alternate;
+    uint8_t         feedback[USB_AUDIO_FEEDBACK_SIZE];
+} usb_audio_ctx_t;
+
+APP_USBD_CLASS_FORWARD(usb_audio);
+
+#define USB_AUDIO_INSTANCE_SPECIFIC_DEC usb_audio_inst_t inst;
+#define USB_AUDIO_DATA_SPECIFIC_DEC     usb_audio_ctx_t ctx;
+
+APP_USBD_CLASS_TYPEDEF(usb_audio,
+                       USB_AUDIO_CONFIG(0, 1),
+                       USB_AUDIO_INSTANCE_SPECIFIC_DEC,
+                       USB_AUDIO_DATA_SPECIFIC_DEC);
+
+extern const app_usbd_class_methods_t usb_audio_class_methods;
+
+/**
+ * @brief Define a class instance.
+ *
+ * @param instance_name      Instance name.
+ * @param interfaces_configs Interfaces, see @ref USB_AUDIO_CONFIG.
+ * @param user_handler       @ref usb_audio_user_ev_handler_t, called from the USBD interrupt.
+ * @param formats            Array of @ref usb_audio_format_t, one per streaming alternate setting.
+ * @param sample_rates       Array of supported sample rates in Hz.
+ */
+#define USB_AUDIO_GLOBAL_DEF(instance_name, interfaces_configs, user_handler, formats, sample_rates)                   \
+    APP_USBD_CLASS_INST_GLOBAL_DEF(instance_name,                                                                      \
+                                   usb_audio,                                                                          \
+                                   &usb_audio_class_methods,                                                           \
+                                   interfaces_configs,                                                                 \
+                                   (.inst = {.user_ev_handler   = (user_handler),                                      \
+                                             .p_formats         = (formats),                                           \
+                                             .format_count      = ARRAY_SIZE(formats),                                 \
+                                             .p_sample_rates    = (sample_rates),                                      \
+                                             .sample_rate_count = ARRAY_SIZE(sample_rates)}))
+
+static inline app_usbd_class_inst_t const *usb_audio_class_inst_get(usb_audio_t const *p_audio)
+{
+    return &p_audio->base;
+}
+
+/**
+ * @brief Request being handled. Valid during @ref USB_AUDIO_USER_EVT_CLASS_REQ.
+ */
+usb_audio_req_t *usb_audio_request_get(app_usbd_class_inst_t const *p_inst);
+
+/**
+ * @brief Selected streaming alternate setting, 0 while the host does not stream.
+ */
+uint8_t usb_audio_alternate_get(app_usbd_class_inst_t const *p_inst);
+
+/**
+ * @brief Largest ISO OUT packet of an alternate setting in bytes, 0 for alternate setting 0.
+ */
+size_t usb_audio_packet_size_max(app_usbd_class_inst_t const *p_inst, uint8_t alternate);
+
+/**
+ * @brief Register a handler called from the USBD interrupt on every SOF.
+ */
+ret_code_t usb_audio_sof_interrupt_register(app_usbd_class_inst_t const   *p_inst,
+                                            app_usbd_sof_interrupt_handler_t handler);
+
+/**
+ * @brief Bytes received by the ISO OUT endpoint in the last frame.
+ */
+size_t usb_audio_rx_size_get(app_usbd_class_inst_t const *p_inst);
+
+/**
+ * @brief Start the ISO OUT transfer of the data received in the last frame.
+ */
+ret_code_t usb_audio_rx_start(app_usbd_class_inst_t const *p_inst, void *p_buf, size_t size);
+
+/**
+ * @brief Queue a feedback value for the next feedback endpoint poll. Call from the SOF handler.
+ *
+ * @param[in] feedback Samples per frame in 10.14 format.
+ *
+ * @retval NRF_ERROR_BUSY The previous value has not been read by the host yet, it stays queued.
+ */
+ret_code_t usb_audio_feedback_set(app_usbd_class_inst_t const *p_inst, uint32_t feedback);
+
+#endif // USB_AUDIO_H
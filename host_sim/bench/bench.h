@@ -0,0 +1,122 @@
+/**
+ * @file        bench.h
+ * @author      Danius Kalvaitis (danius.kalvaitis@gmail.com)
+ * @brief       Timing and signal measurements for the host benchmarks.
+ * @version     0.1
+ * @date        2026-10-17
+ *
+ * @copyright   Copyright (c) Danius Kalvaitis 2026 All rights reserved
+ *
+ * Every benchmark is a single source file printing one line per measurement. Cycles are host time scaled to
+ * PROFILE_HOST_CPU_MHZ like the host simulation probes, the fastest of BENCH_REPEAT runs is kept to hide scheduler
+ * noise. Use them to compare variants and changes, not as target numbers.
+ */
+
+#ifndef BENCH_H
+#define BENCH_H
+
+#include <math.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+
+#include "profile.h"
+
+#define BENCH_REPEAT 20
+
+/**
+ * @return Fastest of BENCH_REPEAT calls of @p run, in cycles.
+ */
+static inline uint32_t bench_cycles(void (*run)(void))
+{
+    uint32_t best = UINT32_MAX;
+
+    for (unsigned i = 0; i < BENCH_REPEAT; i++)
+    {
+        uint32_t start = profile_timestamp();
+
+        run();
+
+        uint32_t cycles = profile_timestamp() - start;
+
+        if (cycles < best)
+        {
+            best = cycles;
+        }
+    }
+
+    return best;
+}
+
+static inline void bench_print(char const *p_name, double value, char const *p_unit)
+{
+    printf("%-48s %10.2f %s\n", p_name, value, p_unit);
+}
+
+/**
+ * @brief THD+N of a sine, everything but the best fitting sine of frequency @p w and DC counts as distortion and noise.
+ *
+ * @param[in] p_samples Samples to measure.
+ * @param[in] count     Amount of samples.
+ * @param[in] w         Sine frequency in radians per sample.
+ *
+ * @return Residual power relative to the sine power in dB.
+ */
+static inline double bench_thd_n_db(int16_t const *p_samples, size_t count, double w)
+{
+    double m[3][3] = {{0}};
+    double v[3]    = {0};
+    double x[3];
+    double det;
+    double signal   = 0.0;
+    double residual = 0.0;
+
+    // Least squares fit of a * sin + b * cos + c through the normal equations
+    for (size_t n = 0; n < count; n++)
+    {
+        double const basis[3] = {sin(w * n), cos(w * n), 1.0};
+
+        for (int i = 0; i < 3; i++)
+        {
+            for (int j = 0; j < 3; j++)
+            {
+                m[i][j] += basis[i] * basis[j];
+            }
+
+            v[i] += basis[i] * p_samples[n];
+        }
+    }
+
+    det = m[0][0] * (m[1][1] * m[2][2] - m[1][2] * m[2][1]) - m[0][1] * (m[1][0] * m[2][2] - m[1][2] * m[2][0]) +
+          m[0][2] * (m[1][0] * m[2][1] - m[1][1] * m[2][0]);
+
+    for (int k = 0; k < 3; k++) // Cramer's rule, column k replaced by v
+    {
+        double c[3][3];
+
+        for (int i = 0; i < 3; i++)
+        {
+            for (int j = 0; j < 3; j++)
+            {
+                c[i][j] = (j == k) ? v[i] : m[i][j];
+            }
+        }
+
+        x[k] = (c[0][0] * (c[1][1] * c[2][2] - c[1][2] * c[2][1]) - c[0][1] * (c[1][0] * c[2][2] - c[1][2] * c[2][0]) +
+                c[0][2] * (c[1][0] * c[2][1] - c[1][1] * c[2][0])) /
+               det;
+    }
+
+    for (size_t n = 0; n < count; n++)
+    {
+        double sine = x[0] * sin(w * n) + x[1] * cos(w * n);
+        double rest = p_samples[n] - sine - x[2];
+
+        signal += sine * sine;
+        residual += rest * rest;
+    }
+
+    return 10.0 * log10(residual / signal);
+}
+
+#endif // BENCH_H
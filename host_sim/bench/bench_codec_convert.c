@@ -0,0 +1,58 @@
+/**
+ * @file        bench_codec_convert.c
+ * @author      Danius Kalvaitis (danius.kalvaitis@gmail.com)
+ * @brief       Host benchmark of the sample format converters.
+ * @version     0.1
+ * @date        2026-10-17
+ *
+ * @copyright   Copyright (c) Danius Kalvaitis 2026 All rights reserved
+ *
+ * Every converter runs on 48 frame packets, one USB frame at 48 kHz, and reports cycles per packet. Conversion does
+ * not depend on the sample values, so each packet is converted again in place without refilling it.
+ */
+
+#include <string.h>
+
+#include "app_util.h"
+#include "bench.h"
+#include "codec_convert.h"
+
+#define BENCH_PACKET_FRAMES 48
+#define BENCH_PACKETS       1000
+
+static char const *const m_names[] = {"s16 stereo", "s16 stereo swapped", "s16 mono", "s24 stereo", "s32 stereo"};
+
+STATIC_ASSERT(ARRAY_SIZE(m_names) == CODEC_FORMAT_COUNT, "Every format needs a name");
+
+static uint32_t               m_packet[BENCH_PACKET_FRAMES * CODEC_CONVERT_FRAME_SIZE_MAX / sizeof(uint32_t)];
+static codec_convert_t const *mp_convert;
+
+static void bench_run(void)
+{
+    for (size_t packet = 0; packet < BENCH_PACKETS; packet++)
+    {
+        mp_convert->handler(m_packet, BENCH_PACKET_FRAMES);
+    }
+}
+
+int main(void)
+{
+    memset(m_packet, 0x5A, sizeof(m_packet));
+
+    for (codec_format_t format = 0; format < CODEC_FORMAT_COUNT; format++)
+    {
+        char name[64];
+
+        mp_convert = codec_convert_get(format);
+
+        if (mp_convert->handler == NULL) // Native format, the packet is played as received
+        {
+            continue;
+        }
+
+        snprintf(name, sizeof(name), "convert %s cycles per packet", m_names[format]);
+        bench_print(name, (double)bench_cycles(bench_run) / BENCH_PACKETS, "cycles");
+    }
+
+    return 0;
+}
@@ -0,0 +1,171 @@
+/**
+ * @file        bench_codec_ramp.c
+ * @author      Danius Kalvaitis (danius.kalvaitis@gmail.com)
+ * @brief       Host benchmark of the fade in and fade out ramp.
+ * @version     0.1
+ * @date        2026-10-17
+ *
+ * @copyright   Copyright (c) Danius Kalvaitis 2026 All rights reserved
+ *
+ * A half scale DC input is the worst case for a click, every gain step shows in full. Click energy is the energy of the
+ * sample to sample difference of the output, relative to cutting the same input off in a single frame. Reports it for
+ * a fade out, a fade in and a fade out the stream resumes from halfway, and fails if any of them exceeds
+ * BENCH_CLICK_LIMIT_DB. Also reports cycles per block while ramping and at unity gain.
+ */
+
+#include "app_util.h"
+#include "bench.h"
+#include "codec_buffer.h"
+#include "codec_ramp.h"
+
+#define BENCH_RATE           48000
+#define BENCH_DC             0x4000
+#define BENCH_RAMP_FRAMES    (BENCH_RATE * CODEC_RAMP_TIME_MS / 1000)
+#define BENCH_BLOCK_FRAMES   CODEC_BUFFER_SIZE_WORDS
+#define BENCH_RAMP_BLOCKS    CEIL_DIV(BENCH_RAMP_FRAMES, BENCH_BLOCK_FRAMES)
+#define BENCH_BLOCKS         (2 * BENCH_RAMP_BLOCKS + 2)              /**< Room for two ramps. */
+#define BENCH_TIMED_BLOCKS   (BENCH_RAMP_FRAMES / BENCH_BLOCK_FRAMES) /**< Blocks that ramp in every frame. */
+#define BENCH_TIMED_RUNS     100
+#define BENCH_TIMED_COUNT    (BENCH_TIMED_RUNS * BENCH_TIMED_BLOCKS)
+#define BENCH_CLICK_LIMIT_DB -20.0
+
+typedef enum
+{
+    BENCH_CUT,
+    BENCH_FADE_OUT,
+    BENCH_FADE_IN,
+    BENCH_RESUME
+} bench_case_t;
+
+static uint32_t     m_frames[BENCH_BLOCKS * BENCH_BLOCK_FRAMES];
+static bench_case_t m_case;
+
+static void bench_blocks_process(size_t first, size_t count)
+{
+    for (size_t block = first; block < first + count; block++)
+    {
+        UNUSED_RETURN_VALUE(codec_ramp_process(&m_frames[block * BENCH_BLOCK_FRAMES], BENCH_BLOCK_FRAMES));
+    }
+}
+
+static void bench_frames_fill(void)
+{
+    for (size_t i = 0; i < ARRAY_SIZE(m_frames); i++)
+    {
+        m_frames[i] = BENCH_DC | (BENCH_DC << 16);
+    }
+}
+
+/**
+ * @brief Play one block as is, then the gain change of the case and the blocks that follow.
+ */
+static void bench_case_run(void)
+{
+    size_t next = 1;
+
+    bench_frames_fill();
+    codec_ramp_reset(m_case == BENCH_FADE_IN);
+    bench_blocks_process(0, next);
+
+    switch (m_case)
+    {
+        case BENCH_CUT:
+            codec_ramp_reset(true);
+            break;
+        case BENCH_FADE_OUT:
+            codec_ramp_start(false);
+            break;
+        case BENCH_FADE_IN:
+            codec_ramp_start(true);
+            break;
+        case BENCH_RESUME:
+            codec_ramp_start(false);
+            bench_blocks_process(next, BENCH_RAMP_BLOCKS / 2);
+            next += BENCH_RAMP_BLOCKS / 2;
+            codec_ramp_start(true);
+            break;
+    }
+
+    bench_blocks_process(next, BENCH_BLOCKS - next);
+}
+
+/**
+ * @return Energy of the sample to sample difference of the left channel.
+ */
+static double bench_click_energy(void)
+{
+    double energy = 0.0;
+
+    for (size_t i = 1; i < ARRAY_SIZE(m_frames); i++)
+    {
+        double step = (int16_t)m_frames[i] - (int16_t)m_frames[i - 1];
+
+        energy += step * step;
+    }
+
+    return energy;
+}
+
+static double bench_case(char const *p_name, bench_case_t bench_case, double cut_energy)
+{
+    char   name[64];
+    double click_db;
+
+    m_case = bench_case;
+    bench_case_run();
+
+    click_db = 10.0 * log10(bench_click_energy() / cut_energy);
+
+    snprintf(name, sizeof(name), "ramp %s click energy", p_name);
+    bench_print(name, click_db, "dB");
+
+    return click_db;
+}
+
+/**
+ * @brief Fade ins from silence, every frame of the timed blocks sees a gain change.
+ */
+static void bench_ramping_run(void)
+{
+    for (size_t run = 0; run < BENCH_TIMED_RUNS; run++)
+    {
+        codec_ramp_reset(true);
+        codec_ramp_start(true);
+        bench_blocks_process(0, BENCH_TIMED_BLOCKS);
+    }
+}
+
+static void bench_unity_run(void)
+{
+    for (size_t run = 0; run < BENCH_TIMED_RUNS; run++)
+    {
+        codec_ramp_reset(false);
+        bench_blocks_process(0, BENCH_TIMED_BLOCKS);
+    }
+}
+
+int main(void)
+{
+    double cut_energy;
+    double worst = -INFINITY;
+
+    codec_ramp_sample_rate_set(BENCH_RATE);
+
+    m_case = BENCH_CUT;
+    bench_case_run();
+    cut_energy = bench_click_energy();
+
+    worst = fmax(worst, bench_case("fade out", BENCH_FADE_OUT, cut_energy));
+    worst = fmax(worst, bench_case("fade in", BENCH_FADE_IN, cut_energy));
+    worst = fmax(worst, bench_case("resume halfway", BENCH_RESUME, cut_energy));
+
+    bench_frames_fill();
+    bench_print("ramp cycles per block, ramping",
+                (double)bench_cycles(bench_ramping_run) / BENCH_TIMED_COUNT,
+                "cycles");
+    bench_print("ramp cycles per block, unity gain",
+                (double)bench_cycles(bench_unity_run) / BENCH_TIMED_COUNT,
+                "cycles");
+
+    return (worst <= BENCH_CLICK_LIMIT_DB) ? 0 : 1;
+}
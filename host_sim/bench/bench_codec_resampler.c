@@ -0,0 +1,117 @@
+/**
+ * @file        bench_codec_resampler.c
+ * @author      Danius Kalvaitis (danius.kalvaitis@gmail.com)
+ * @brief       Host benchmark of the drift compensating resampler.
+ * @version     0.1
+ * @date        2026-10-17
+ *
+ * @copyright   Copyright (c) Danius Kalvaitis 2026 All rights reserved
+ *
+ * One second of a -6 dBFS 997 Hz tone at 48 kHz is resampled in 48 frame packets with the step held at unity and at
+ * both 0.5 % limits. Reports cycles per input frame and THD+N of the left channel, next to THD+N of the 16 bit input
+ * itself. Fails if THD+N of the correction exceeds BENCH_THD_N_LIMIT_DB.
+ */
+
+#include <stdlib.h>
+
+#include "app_util.h"
+#include "bench.h"
+#include "codec_resampler.h"
+
+#define BENCH_RATE           48000
+#define BENCH_TONE_HZ        997.0
+#define BENCH_AMPLITUDE      16384
+#define BENCH_PACKET_FRAMES  48
+#define BENCH_PACKETS        1000
+#define BENCH_IN_FRAMES      (BENCH_PACKETS * BENCH_PACKET_FRAMES)
+#define BENCH_SETTLE_FRAMES  8     /**< Outputs interpolated against the zeroed history, left out of THD+N. */
+#define BENCH_STEP_ONE       65536 /**< Resampler step at unity, 16.16 fixed point. */
+#define BENCH_STEP_LIMIT     327   /**< Resampler step correction at its 0.5 % limit. */
+#define BENCH_FILL_TARGET    2048
+#define BENCH_FILL_OFFSET    100000 /**< Fill error that drives the step to its limit on the first update. */
+#define BENCH_THD_N_LIMIT_DB -70.0
+
+static uint32_t m_in[BENCH_IN_FRAMES];
+static uint32_t m_out[BENCH_IN_FRAMES + BENCH_IN_FRAMES / 100];
+static int16_t  m_left[ARRAY_SIZE(m_out)];
+static size_t   m_out_frames;
+static int32_t  m_fill_offset;
+
+static void bench_run(void)
+{
+    codec_resampler_reset();
+
+    if (m_fill_offset != 0)
+    {
+        codec_resampler_fill_update(BENCH_FILL_TARGET + m_fill_offset, BENCH_FILL_TARGET);
+    }
+
+    m_out_frames = 0;
+
+    for (size_t packet = 0; packet < BENCH_PACKETS; packet++)
+    {
+        size_t out_frames;
+
+        if (codec_resampler_process(&m_in[packet * BENCH_PACKET_FRAMES],
+                                    BENCH_PACKET_FRAMES,
+                                    &m_out[m_out_frames],
+                                    BENCH_PACKET_FRAMES + 1,
+                                    &out_frames) != NRF_SUCCESS)
+        {
+            abort();
+        }
+
+        m_out_frames += out_frames;
+    }
+}
+
+/**
+ * @param[in] step_offset Step correction the fill offset leads to, input frames per output frame in 16.16 format.
+ *
+ * @return THD+N of the resampled left channel in dB.
+ */
+static double bench_step(char const *p_name, int32_t fill_offset, int32_t step_offset)
+{
+    double w = 2.0 * M_PI * BENCH_TONE_HZ / BENCH_RATE * (BENCH_STEP_ONE + step_offset) / BENCH_STEP_ONE;
+    char   name[64];
+    double thd_n;
+
+    m_fill_offset = fill_offset;
+
+    snprintf(name, sizeof(name), "resampler %s cycles per frame", p_name);
+    bench_print(name, (double)bench_cycles(bench_run) / BENCH_IN_FRAMES, "cycles");
+
+    for (size_t i = 0; i < m_out_frames; i++)
+    {
+        m_left[i] = (int16_t)m_out[i];
+    }
+
+    thd_n = bench_thd_n_db(&m_left[BENCH_SETTLE_FRAMES], m_out_frames - BENCH_SETTLE_FRAMES, w);
+
+    snprintf(name, sizeof(name), "resampler %s THD+N", p_name);
+    bench_print(name, thd_n, "dB");
+
+    return thd_n;
+}
+
+int main(void)
+{
+    double w     = 2.0 * M_PI * BENCH_TONE_HZ / BENCH_RATE;
+    double worst = -INFINITY;
+
+    for (size_t i = 0; i < BENCH_IN_FRAMES; i++)
+    {
+        int16_t sample = (int16_t)lrint(BENCH_AMPLITUDE * sin(w * i));
+
+        m_in[i]   = (uint16_t)sample | ((uint32_t)(uint16_t)sample << 16);
+        m_left[i] = sample;
+    }
+
+    bench_print("input THD+N", bench_thd_n_db(m_left, BENCH_IN_FRAMES, w), "dB");
+
+    worst = fmax(worst, bench_step("unity", 0, 0));
+    worst = fmax(worst, bench_step("+0.5 %", BENCH_FILL_OFFSET, BENCH_STEP_LIMIT));
+    worst = fmax(worst, bench_step("-0.5 %", -BENCH_FILL_OFFSET, -BENCH_STEP_LIMIT));
+
+    return (worst <= BENCH_THD_N_LIMIT_DB) ? 0 : 1;
+}
@@ -0,0 +1,399 @@
+/**
+ * @file        dsp_wav.c
+ * @author      Danius Kalvaitis (danius.kalvaitis@gmail.com)
+ * @brief       Host WAV in, WAV out harness of the DSP chain.
+ * @version     0.1
+ * @date        2026-10-17
+ *
+ * @copyright   Copyright (c) Danius Kalvaitis 2026 All rights reserved
+ *
+ * Runs a 16 bit stereo WAV through the same stages codec.c registers, the equalizer with its default profile and then
+ * the limiter, in blocks of CODEC_BUFFER_SIZE_WORDS frames as the codec buffer hands them out. The last block is padded
+ * with silence. With --reference the output is compared frame by frame against a stored WAV and any difference fails.
+ *
+ * --generate writes the test signal the references in dsp were made from. It uses integer arithmetic only, so it is
+ * the same on every host: quarter scale noise for the equalizer, a full scale square wave to push the limiter and
+ * silence to let both settle. When the DSP output changes on purpose, rebuild the references with make dsp_reference
+ * and listen to them before committing.
+ */
+
+#include <getopt.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "codec_buffer.h"
+#include "codec_dsp.h"
+#include "codec_eq.h"
+#include "codec_limiter.h"
+#include "profile.h"
+#include "sdk_common.h"
+
+#define DSP_WAV_HEADER_SIZE      44
+#define DSP_WAV_FRAME_SIZE       4 /**< 16 bit stereo. */
+#define DSP_WAV_FRAMES_MAX       (10 * 60 * 48000)
+#define DSP_WAV_SEGMENT_FRAMES   2048
+#define DSP_WAV_SQUARE_PERIOD    48 /**< Frames, 1 kHz at 48 kHz. */
+#define DSP_WAV_MISMATCHES_SHOWN 8
+
+typedef struct
+{
+    uint32_t  sample_rate;
+    uint32_t *p_frames; /**< Left in the lower half word, as the codec buffer holds them. */
+    size_t    frames;
+} dsp_wav_t;
+
+static char const *mp_reference_file;
+static uint32_t    m_generate_rate;
+
+static uint16_t dsp_wav_u16(uint8_t const *p_data) { return (uint16_t)(p_data[0] | (p_data[1] << 8)); }
+
+static uint32_t dsp_wav_u32(uint8_t const *p_data)
+{
+    return dsp_wav_u16(p_data) | ((uint32_t)dsp_wav_u16(&p_data[2]) << 16);
+}
+
+static void dsp_wav_u16_put(uint8_t *p_data, uint16_t value)
+{
+    p_data[0] = (uint8_t)value;
+    p_data[1] = (uint8_t)(value >> 8);
+}
+
+static void dsp_wav_u32_put(uint8_t *p_data, uint32_t value)
+{
+    dsp_wav_u16_put(p_data, (uint16_t)value);
+    dsp_wav_u16_put(&p_data[2], (uint16_t)(value >> 16));
+}
+
+static bool dsp_wav_alloc(dsp_wav_t *p_wav, size_t frames)
+{
+    // Room to pad the last block
+    p_wav->p_frames = calloc(CEIL_DIV(frames, CODEC_BUFFER_SIZE_WORDS) * CODEC_BUFFER_SIZE_WORDS, sizeof(uint32_t));
+    p_wav->frames   = frames;
+
+    return p_wav->p_frames != NULL;
+}
+
+/**
+ * @brief Read a PCM WAV, other chunks than fmt and data are skipped.
+ */
+static bool dsp_wav_read(char const *p_file_name, dsp_wav_t *p_wav)
+{
+    FILE   *p_file = fopen(p_file_name, "rb");
+    uint8_t header[12];
+    uint8_t chunk[8];
+    bool    format_ok = false;
+
+    if (p_file == NULL)
+    {
+        fprintf(stderr, "could not open %s\n", p_file_name);
+        return false;
+    }
+
+    if ((fread(header, sizeof(header), 1, p_file) != 1) || (memcmp(header, "RIFF", 4) != 0) ||
+        (memcmp(&header[8], "WAVE", 4) != 0))
+    {
+        fprintf(stderr, "%s is not a WAV file\n", p_file_name);
+        fclose(p_file);
+        return false;
+    }
+
+    while (fread(chunk, sizeof(chunk), 1, p_file) == 1)
+    {
+        uint32_t size = dsp_wav_u32(&chunk[4]);
+
+        if (memcmp(chunk, "fmt ", 4) == 0)
+        {
+            uint8_t format[16];
+
+            if ((size < sizeof(format)) || (fread(format, sizeof(format), 1, p_file) != 1))
+            {
+                break;
+            }
+
+            p_wav->sample_rate = dsp_wav_u32(&format[4]);
+            format_ok          = (dsp_wav_u16(&format[0]) == 1) && (dsp_wav_u16(&format[2]) == 2) &&
+                        (dsp_wav_u16(&format[14]) == 16);
+            size -= sizeof(format);
+        } else if ((memcmp(chunk, "data", 4) == 0) && format_ok)
+        {
+            size_t frames = size / DSP_WAV_FRAME_SIZE;
+
+            if ((frames > DSP_WAV_FRAMES_MAX) || !dsp_wav_alloc(p_wav, frames))
+            {
+                break;
+            }
+
+            for (size_t i = 0; i < frames; i++)
+            {
+                uint8_t frame[DSP_WAV_FRAME_SIZE];
+
+                if (fread(frame, sizeof(frame), 1, p_file) != 1)
+                {
+                    free(p_wav->p_frames);
+                    fclose(p_file);
+                    return false;
+                }
+
+                p_wav->p_frames[i] = dsp_wav_u32(frame);
+            }
+
+            fclose(p_file);
+            return true;
+        }
+
+        if (fseek(p_file, size + (size & 1), SEEK_CUR) != 0) // Chunks are word aligned
+        {
+            break;
+        }
+    }
+
+    fprintf(stderr, "%s is not 16 bit stereo PCM\n", p_file_name);
+    fclose(p_file);
+
+    return false;
+}
+
+static bool dsp_wav_write(char const *p_file_name, dsp_wav_t const *p_wav)
+{
+    FILE    *p_file    = fopen(p_file_name, "wb");
+    uint32_t data_size = p_wav->frames * DSP_WAV_FRAME_SIZE;
+    uint8_t  header[DSP_WAV_HEADER_SIZE];
+    bool     written;
+
+    if (p_file == NULL)
+    {
+        fprintf(stderr, "could not open %s\n", p_file_name);
+        return false;
+    }
+
+    memcpy(&header[0], "RIFF", 4);
+    dsp_wav_u32_put(&header[4], DSP_WAV_HEADER_SIZE - 8 + data_size);
+    memcpy(&header[8], "WAVEfmt ", 8);
+    dsp_wav_u32_put(&header[16], 16);
+    dsp_wav_u16_put(&header[20], 1); // PCM
+    dsp_wav_u16_put(&header[22], 2);
+    dsp_wav_u32_put(&header[24], p_wav->sample_rate);
+    dsp_wav_u32_put(&header[28], p_wav->sample_rate * DSP_WAV_FRAME_SIZE);
+    dsp_wav_u16_put(&header[32], DSP_WAV_FRAME_SIZE);
+    dsp_wav_u16_put(&header[34], 16);
+    memcpy(&header[36], "data", 4);
+    dsp_wav_u32_put(&header[40], data_size);
+
+    written = (fwrite(header, sizeof(header), 1, p_file) == 1);
+
+    for (size_t i = 0; written && (i < p_wav->frames); i++)
+    {
+        uint8_t frame[DSP_WAV_FRAME_SIZE];
+
+        dsp_wav_u32_put(frame, p_wav->p_frames[i]);
+        written = (fwrite(frame, sizeof(frame), 1, p_file) == 1);
+    }
+
+    written &= (fclose(p_file) == 0);
+
+    if (!written)
+    {
+        fprintf(stderr, "could not write %s\n", p_file_name);
+    }
+
+    return written;
+}
+
+static uint16_t dsp_wav_noise(uint32_t *p_rng)
+{
+    *p_rng = *p_rng * 1664525 + 1013904223;
+
+    return (uint16_t)((int16_t)(*p_rng >> 16) >> 2);
+}
+
+/**
+ * @brief Noise, then a square wave at full scale on the left and half scale on the right, then silence.
+ */
+static bool dsp_wav_generate(dsp_wav_t *p_wav)
+{
+    uint32_t rng = 1;
+
+    if (!dsp_wav_alloc(p_wav, 3 * DSP_WAV_SEGMENT_FRAMES))
+    {
+        return false;
+    }
+
+    for (size_t i = 0; i < DSP_WAV_SEGMENT_FRAMES; i++)
+    {
+        uint16_t left = dsp_wav_noise(&rng);
+
+        p_wav->p_frames[i] = left | ((uint32_t)dsp_wav_noise(&rng) << 16);
+    }
+
+    for (size_t i = 0; i < DSP_WAV_SEGMENT_FRAMES; i++)
+    {
+        bool high = (i % DSP_WAV_SQUARE_PERIOD) < (DSP_WAV_SQUARE_PERIOD / 2);
+
+        p_wav->p_frames[DSP_WAV_SEGMENT_FRAMES + i] = high ? ((uint16_t)INT16_MAX | (0x4000u << 16))
+                                                           : ((uint16_t)INT16_MIN | (0xC000u << 16));
+    }
+
+    return true;
+}
+
+/**
+ * @brief Run the stages in codec.c order, block by block.
+ */
+static void dsp_wav_process(dsp_wav_t *p_wav)
+{
+    ret_code_t err_code;
+
+    codec_dsp_init();
+
+    err_code = codec_eq_init();
+    APP_ERROR_CHECK(err_code);
+
+    err_code = codec_limiter_init();
+    APP_ERROR_CHECK(err_code);
+
+    err_code = codec_eq_sample_rate_set(p_wav->sample_rate);
+    APP_ERROR_CHECK(err_code);
+
+    codec_limiter_sample_rate_set(p_wav->sample_rate);
+    codec_limiter_reset();
+
+    for (size_t i = 0; i < p_wav->frames; i += CODEC_BUFFER_SIZE_WORDS)
+    {
+        codec_dsp_process(&p_wav->p_frames[i], CODEC_BUFFER_SIZE_WORDS);
+    }
+}
+
+/**
+ * @return Frames that differ from the reference, a length or rate mismatch counts every frame.
+ */
+static size_t dsp_wav_compare(dsp_wav_t const *p_wav, dsp_wav_t const *p_reference)
+{
+    size_t mismatches = 0;
+
+    if ((p_wav->frames != p_reference->frames) || (p_wav->sample_rate != p_reference->sample_rate))
+    {
+        printf("output is %zu frames at %u Hz, reference %zu frames at %u Hz\n",
+               p_wav->frames,
+               p_wav->sample_rate,
+               p_reference->frames,
+               p_reference->sample_rate);
+        return MAX(p_wav->frames, p_reference->frames);
+    }
+
+    for (size_t i = 0; i < p_wav->frames; i++)
+    {
+        if (p_wav->p_frames[i] == p_reference->p_frames[i])
+        {
+            continue;
+        }
+
+        if (mismatches++ < DSP_WAV_MISMATCHES_SHOWN)
+        {
+            printf("frame %zu: %d %d, reference %d %d\n",
+                   i,
+                   (int16_t)p_wav->p_frames[i],
+                   (int16_t)(p_wav->p_frames[i] >> 16),
+                   (int16_t)p_reference->p_frames[i],
+                   (int16_t)(p_reference->p_frames[i] >> 16));
+        }
+    }
+
+    return mismatches;
+}
+
+static void dsp_wav_usage(char const *p_name)
+{
+    fprintf(stderr,
+            "usage: %s [--reference FILE] IN.wav OUT.wav\n"
+            "       %s --generate HZ OUT.wav\n",
+            p_name,
+            p_name);
+}
+
+static bool dsp_wav_args_parse(int argc, char *argv[])
+{
+    static struct option const options[] = {
+      {"reference", required_argument, NULL, 'r'},
+      {"generate", required_argument, NULL, 'g'},
+      {NULL, 0, NULL, 0},
+    };
+    int option;
+
+    while ((option = getopt_long(argc, argv, "", options, NULL)) != -1)
+    {
+        switch (option)
+        {
+            case 'r':
+                mp_reference_file = optarg;
+                break;
+            case 'g':
+                m_generate_rate = strtoul(optarg, NULL, 0);
+                break;
+            default:
+                return false;
+        }
+    }
+
+    if (m_generate_rate != 0)
+    {
+        return (optind + 1 == argc) && (mp_reference_file == NULL) &&
+               ((m_generate_rate == 44100) || (m_generate_rate == 48000));
+    }
+
+    return optind + 2 == argc;
+}
+
+int main(int argc, char *argv[])
+{
+    dsp_wav_t wav = {0};
+    dsp_wav_t reference;
+    size_t    mismatches;
+
+    if (!dsp_wav_args_parse(argc, argv))
+    {
+        dsp_wav_usage(argv[0]);
+        return 2;
+    }
+
+    if (m_generate_rate != 0)
+    {
+        wav.sample_rate = m_generate_rate;
+
+        return (dsp_wav_generate(&wav) && dsp_wav_write(argv[optind], &wav)) ? 0 : 2;
+    }
+
+    if (!dsp_wav_read(argv[optind], &wav))
+    {
+        return 2;
+    }
+
+    if ((wav.sample_rate != 44100) && (wav.sample_rate != 48000))
+    {
+        fprintf(stderr, "%u Hz is not a USB audio rate\n", wav.sample_rate);
+        return 2;
+    }
+
+    profile_cycle_counter_init();
+    dsp_wav_process(&wav);
+
+    if (!dsp_wav_write(argv[optind + 1], &wav))
+    {
+        return 2;
+    }
+
+    if (mp_reference_file == NULL)
+    {
+        return 0;
+    }
+
+    if (!dsp_wav_read(mp_reference_file, &reference))
+    {
+        return 2;
+    }
+
+    mismatches = dsp_wav_compare(&wav, &reference);
+    printf("%s: %zu of %zu frames differ from %s\n", argv[optind + 1], mismatches, wav.frames, mp_reference_file);
+
+    return (mismatches == 0) ? 0 : 1;
+}
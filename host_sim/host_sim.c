@@ -0,0 +1,687 @@
+/**
+ * @file        host_sim.c
+ * @author      Danius Kalvaitis (danius.kalvaitis@gmail.com)
+ * @brief       Host replay of the USB to I2S audio path.
+ * @version     0.1
+ * @date        2026-10-17
+ *
+ * @copyright   Copyright (c) Danius Kalvaitis 2026 All rights reserved
+ *
+ * Runs usb.c, codec.c, codec_buffer.c and the DSP chain against simulated USBD, I2S and app_timer drivers. Every
+ * simulated millisecond the host sends one ISO OUT packet at SOF, then the I2S bus plays one millisecond of frames on
+ * its own clock, which may run off nominal by a given ppm. Packet sizes follow one of these cadences:
+ *
+ * - async:   the host paces packets after the feedback endpoint, read once per refresh period.
+ * - fixed:   nominal sizes, the host ignores feedback. At 44.1 kHz nine 180 byte packets follow one 176 byte packet.
+ * - jitter:  async pacing, but the host misses single frames and catches up with packets of up to 192 bytes.
+ * - cadence: packet sizes in bytes read from a file, one per line, replayed in a loop.
+ *
+ * The host streams 16 bit samples unless --bits selects the 24 or 32 bit alternate setting.
+ *
+ * app_timer starts, stops and expirations are counted while the host streams. --legacy-rx-timer adds back the timer
+ * traffic of the old stream end detection, a 2 ms single shot timer stopped and started again for every received
+ * packet, so both schemes can be compared from the same run.
+ *
+ * Underruns, overruns, buffer fill, packet sizes and the profile probes are reported at the end. Latency is the fill
+ * level plus the blocks I2S has already taken off the ring. Cycle counts are host time scaled to the target clock, use
+ * them to compare changes, not as target numbers.
+ */
+
+#include <getopt.h>
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "app_scheduler.h"
+#include "app_timer.h"
+#include "codec.h"
+#include "codec_buffer.h"
+#include "profile.h"
+#include "sim.h"
+#include "telemetry.h"
+#include "usb.h"
+
+#define HOST_SIM_FEEDBACK_REFRESH_MS 8  /**< Host reads the feedback endpoint every 2^3 frames. */
+#define HOST_SIM_CATCHUP_FRAMES      4  /**< Extra frames a late host may send in one packet. */
+#define HOST_SIM_PACKET_FRAMES_MAX   64 /**< Biggest packet the cadence file may ask for. */
+#define HOST_SIM_CADENCE_MAX         100000
+#define HOST_SIM_STOP_MS             100 /**< Host silence at the end, long enough to drain the codec buffer. */
+#define HOST_SIM_TONE_HZ             1000
+#define HOST_SIM_TONE_AMPLITUDE      16384
+#define HOST_SIM_SUBFRAME_SIZE_MAX   4
+#define HOST_SIM_FILL_FRAMES_MAX     4096 /**< Fill histogram range, above any ring size. */
+#define HOST_SIM_I2S_BLOCKS          2    /**< Blocks taken off the ring by I2S, the one playing and the next. */
+#define HOST_SIM_LEGACY_RX_TIMEOUT   APP_TIMER_TICKS(2)
+
+typedef enum
+{
+    HOST_SIM_MODE_ASYNC,
+    HOST_SIM_MODE_FIXED,
+    HOST_SIM_MODE_JITTER,
+    HOST_SIM_MODE_CADENCE
+} host_sim_mode_t;
+
+typedef struct
+{
+    host_sim_mode_t mode;
+    uint32_t        sample_rate;
+    double          ppm; /**< I2S clock offset from nominal. */
+    uint32_t        duration_ms;
+    uint8_t         subframe_size; /**< Bytes per sample, selects the streaming alternate setting. */
+    uint32_t        late_permille; /**< Chance of the host missing a frame in jitter mode. */
+    uint32_t        seed;
+    char const     *p_cadence_file;
+    char const     *p_csv_file;
+    bool            expect_clean;
+    bool            legacy_rx_timer; /**< Restart a 2 ms timer on every received packet, as usb.c used to. */
+} host_sim_config_t;
+
+typedef struct
+{
+    uint32_t feedback;     /**< Last feedback value read, 10.14 format. */
+    uint32_t feedback_acc; /**< Fraction of a frame carried to the next packet, 10.14 format. */
+    uint32_t backlog;      /**< Frames due but not sent yet. */
+    bool     late;
+    uint32_t rng;
+    double   phase;
+    double   i2s_acc; /**< Fraction of an I2S frame carried to the next millisecond. */
+} host_sim_state_t;
+
+typedef struct
+{
+    uint32_t packets;
+    uint32_t packet_frames[HOST_SIM_PACKET_FRAMES_MAX + 1];
+    uint32_t streaming_ms;
+    uint32_t fill_min;
+    uint32_t fill_max;
+    uint64_t fill_sum;
+    uint32_t fill_frames[HOST_SIM_FILL_FRAMES_MAX + 1]; /**< Milliseconds spent at each fill level. */
+    uint32_t stream_starts;
+    uint32_t stream_stops;
+    uint32_t          rx_timeouts;
+    uint32_t          usb_configured;
+    sim_timer_stats_t timers; /**< While the host streams. */
+} host_sim_report_t;
+
+static host_sim_config_t m_config = {
+  .mode          = HOST_SIM_MODE_ASYNC,
+  .sample_rate   = 44100,
+  .duration_ms   = 10000,
+  .subframe_size = 2,
+  .late_permille = 20,
+  .seed          = 1,
+};
+
+static host_sim_state_t  m_host;
+static host_sim_report_t m_report = {.fill_min = UINT32_MAX};
+static uint16_t          m_cadence[HOST_SIM_CADENCE_MAX];
+static size_t            m_cadence_count;
+static uint8_t           m_packet[HOST_SIM_PACKET_FRAMES_MAX * 2 * HOST_SIM_SUBFRAME_SIZE_MAX];
+
+APP_TIMER_DEF(m_legacy_rx_timer);
+
+/**
+ * @brief Select the converter of the USB streaming alternate setting. Same as main.c.
+ */
+static ret_code_t usb_format_set(uint8_t subframe_size)
+{
+    switch (subframe_size)
+    {
+        case 2:
+            return codec_set_format(CODEC_FORMAT_S16_STEREO);
+        case 3:
+            return codec_set_format(CODEC_FORMAT_S24_STEREO);
+        case 4:
+            return codec_set_format(CODEC_FORMAT_S32_STEREO);
+        default:
+            return NRF_ERROR_NOT_SUPPORTED;
+    }
+}
+
+/**
+ * @brief Called on every RX_DONE, where usb.c restarted its RX timeout timer before the SOF count replaced it.
+ */
+static ret_code_t host_sim_rx_buffer_release(size_t size)
+{
+    if (m_config.legacy_rx_timer)
+    {
+        ret_code_t err_code = app_timer_stop(m_legacy_rx_timer);
+        APP_ERROR_CHECK(err_code);
+
+        err_code = app_timer_start(m_legacy_rx_timer, HOST_SIM_LEGACY_RX_TIMEOUT, NULL);
+        APP_ERROR_CHECK(err_code);
+    }
+
+    return codec_release_rx_buffer(size);
+}
+
+/**
+ * @brief Stream end is detected by usb.c either way, the legacy timer only adds its expiry.
+ */
+static void host_sim_legacy_rx_timeout_handler(void *p_context) { UNUSED_PARAMETER(p_context); }
+
+static usb_rx_handlers_t const m_usb_rx_handlers = {
+  .buffer_get                = codec_get_rx_buffer,
+  .buffer_release            = host_sim_rx_buffer_release,
+  .buffer_cancel             = codec_cancel_rx_buffer,
+  .buffer_release_unfinished = codec_release_unfinished_rx_buffer,
+  .feedback_get              = codec_feedback_get,
+  .format_set                = usb_format_set,
+};
+
+static dk_twi_mngr_t const m_twi_mngr_codec = {.instance = 0};
+
+/**
+ * @brief Handle USB control events the way main.c does, from the scheduler.
+ */
+static void usb_control_event_handler(void *p_event_data, uint16_t event_size)
+{
+    ret_code_t         err_code;
+    usb_event_t const *p_event = p_event_data;
+
+    UNUSED_PARAMETER(event_size);
+
+    switch (p_event->evt_type)
+    {
+        case USB_EVENT_USB_CONNECTED:
+            err_code = codec_ring_power_set(true);
+            APP_ERROR_CHECK(err_code);
+            break;
+        case USB_EVENT_USB_CONFIGURED:
+            m_report.usb_configured++;
+            break;
+        case USB_EVENT_TYPE_RX_TIMEOUT:
+            m_report.rx_timeouts++;
+            break;
+        case USB_EVENT_TYPE_MUTE_SET:
+            err_code = codec_mute(p_event->params.mute);
+            APP_ERROR_CHECK(err_code);
+            break;
+        case USB_EVENT_TYPE_SAMPLE_RATE_SET:
+            err_code = codec_set_sample_rate(p_event->params.sample_rate);
+            APP_ERROR_CHECK(err_code);
+            break;
+        case USB_EVENT_TYPE_VOLUME_SET:
+            err_code = codec_set_volume(p_event->params.volume);
+            APP_ERROR_CHECK(err_code);
+            break;
+        default:
+            break;
+    }
+}
+
+static void usb_event_handler(usb_event_t *p_event)
+{
+    ret_code_t err_code = app_sched_event_put(p_event, sizeof(usb_event_t), usb_control_event_handler);
+    APP_ERROR_CHECK(err_code);
+}
+
+static void codec_event_handler(codec_evt_type_t event_type)
+{
+    switch (event_type)
+    {
+        case CODEC_EVT_TYPE_AUDIO_STREAM_STARTED:
+            m_report.stream_starts++;
+            break;
+        case CODEC_EVT_TYPE_AUDIO_STREAM_STOPPED:
+            m_report.stream_stops++;
+            break;
+        default:
+            break;
+    }
+}
+
+static uint32_t host_sim_frame_size(void) { return 2 * m_config.subframe_size; }
+
+static uint32_t host_sim_random(void)
+{
+    m_host.rng = m_host.rng * 1664525UL + 1013904223UL;
+
+    return m_host.rng >> 16;
+}
+
+static ret_code_t host_sim_cadence_load(char const *p_file_name)
+{
+    FILE    *p_file = fopen(p_file_name, "r");
+    unsigned bytes;
+
+    if (p_file == NULL)
+    {
+        return NRF_ERROR_NOT_FOUND;
+    }
+
+    while ((m_cadence_count < HOST_SIM_CADENCE_MAX) && (fscanf(p_file, "%u", &bytes) == 1))
+    {
+        if ((bytes % host_sim_frame_size() != 0) || (bytes / host_sim_frame_size() > HOST_SIM_PACKET_FRAMES_MAX))
+        {
+            fclose(p_file);
+            return NRF_ERROR_INVALID_DATA;
+        }
+
+        m_cadence[m_cadence_count++] = (uint16_t)bytes;
+    }
+
+    fclose(p_file);
+
+    return (m_cadence_count > 0) ? NRF_SUCCESS : NRF_ERROR_INVALID_LENGTH;
+}
+
+/**
+ * @brief Frames the host sends in a frame, following the configured cadence.
+ */
+static uint32_t host_sim_packet_frames(uint32_t ms)
+{
+    uint32_t rate = m_config.sample_rate;
+    uint32_t frames;
+
+    switch (m_config.mode)
+    {
+        case HOST_SIM_MODE_FIXED:
+            return (uint32_t)(((uint64_t)(ms + 1) * rate) / 1000 - ((uint64_t)ms * rate) / 1000);
+        case HOST_SIM_MODE_CADENCE:
+            return m_cadence[ms % m_cadence_count] / host_sim_frame_size();
+        default:
+            break;
+    }
+
+    if ((ms % HOST_SIM_FEEDBACK_REFRESH_MS) == 0)
+    {
+        UNUSED_RETURN_VALUE(sim_usbd_feedback_read(&m_host.feedback)); // Keeps the last value if none was queued
+    }
+
+    m_host.feedback_acc += m_host.feedback;
+    frames = m_host.feedback_acc >> 14;
+    m_host.feedback_acc &= (1UL << 14) - 1;
+
+    if (m_config.mode == HOST_SIM_MODE_ASYNC)
+    {
+        return frames;
+    }
+
+    m_host.backlog += frames;
+
+    // Never late twice in a row, the device would take it as the end of the stream
+    if (!m_host.late && ((host_sim_random() % 1000) < m_config.late_permille))
+    {
+        m_host.late = true;
+        return 0;
+    }
+
+    m_host.late = false;
+    frames      = MIN(m_host.backlog, rate / 1000 + HOST_SIM_CATCHUP_FRAMES);
+    m_host.backlog -= frames;
+
+    return frames;
+}
+
+static void host_sim_packet_fill(uint32_t frames)
+{
+    double step = 2.0 * M_PI * HOST_SIM_TONE_HZ / m_config.sample_rate;
+
+    for (uint32_t i = 0; i < frames; i++)
+    {
+        uint8_t *p_frame = &m_packet[i * host_sim_frame_size()];
+        int32_t  sample  = (int32_t)(HOST_SIM_TONE_AMPLITUDE * 65536.0 * sin(m_host.phase));
+
+        // Little endian, the sample bits that fit the subframe
+        for (uint32_t byte = 0; byte < m_config.subframe_size; byte++)
+        {
+            p_frame[byte] = (uint8_t)(sample >> (8 * (HOST_SIM_SUBFRAME_SIZE_MAX - m_config.subframe_size + byte)));
+        }
+
+        memcpy(p_frame + m_config.subframe_size, p_frame, m_config.subframe_size);
+        m_host.phase = fmod(m_host.phase + step, 2.0 * M_PI);
+    }
+}
+
+/**
+ * @brief Move the I2S bus and app_timer forward by one millisecond.
+ */
+static void host_sim_device_ms(uint32_t ms)
+{
+    uint32_t frames;
+
+    m_host.i2s_acc += m_config.sample_rate * (1.0 + m_config.ppm * 1e-6) / 1000.0;
+    frames = (uint32_t)m_host.i2s_acc;
+    m_host.i2s_acc -= frames;
+
+    sim_i2s_frames(frames);
+    sim_timer_advance(APP_TIMER_TICKS(ms + 1) - APP_TIMER_TICKS(ms));
+    app_sched_execute();
+}
+
+/**
+ * @param[in] streaming The host is still streaming, fill levels count towards the report.
+ */
+static void host_sim_sample(FILE *p_csv, uint32_t ms, uint32_t frames, bool streaming)
+{
+    codec_buffer_stats_t stats;
+    uint32_t             fill = codec_buffer_fill_get() / sizeof(uint32_t);
+
+    codec_buffer_stats_get(&stats);
+
+    if (streaming && sim_i2s_is_running())
+    {
+        m_report.streaming_ms++;
+        m_report.fill_sum += fill;
+        m_report.fill_min = MIN(m_report.fill_min, fill);
+        m_report.fill_max = MAX(m_report.fill_max, fill);
+        m_report.fill_frames[MIN(fill, HOST_SIM_FILL_FRAMES_MAX)]++;
+    }
+
+    if (p_csv != NULL)
+    {
+        fprintf(p_csv,
+                "%u,%u,%u,%u,%u\n",
+                ms,
+                frames * host_sim_frame_size(),
+                fill,
+                (unsigned)stats.queue_utilization,
+                codec_feedback_get());
+    }
+}
+
+/**
+ * @param[out] p_streaming Counters taken when the host stops streaming, before the codec buffer drains.
+ */
+static void host_sim_run(FILE *p_csv, telemetry_snapshot_t *p_streaming)
+{
+    sim_timer_stats_t start;
+    uint32_t          ms;
+
+    sim_timer_stats_get(&start);
+
+    for (ms = 0; ms < m_config.duration_ms; ms++)
+    {
+        uint32_t frames = host_sim_packet_frames(ms);
+
+        host_sim_packet_fill(frames);
+        sim_usbd_frame(m_packet, frames * host_sim_frame_size());
+        m_report.packets += (frames > 0);
+        m_report.packet_frames[MIN(frames, HOST_SIM_PACKET_FRAMES_MAX)]++;
+
+        host_sim_device_ms(ms);
+        host_sim_sample(p_csv, ms, frames, true);
+    }
+
+    telemetry_snapshot_get(p_streaming);
+    sim_timer_stats_get(&m_report.timers);
+
+    m_report.timers.starts -= start.starts;
+    m_report.timers.stops -= start.stops;
+    m_report.timers.expirations -= start.expirations;
+
+    for (; ms < m_config.duration_ms + HOST_SIM_STOP_MS; ms++)
+    {
+        sim_usbd_frame(NULL, 0);
+        host_sim_device_ms(ms);
+        host_sim_sample(p_csv, ms, 0, false);
+    }
+}
+
+static double host_sim_frames_to_ms(double frames) { return frames * 1000.0 / m_config.sample_rate; }
+
+/**
+ * @return Fill level in frames that 99 % of the streaming milliseconds stayed at or below.
+ */
+static uint32_t host_sim_fill_p99(void)
+{
+    uint32_t p99_count = m_report.streaming_ms - m_report.streaming_ms / 100;
+    uint32_t seen      = 0;
+    uint32_t fill;
+
+    for (fill = 0; fill < HOST_SIM_FILL_FRAMES_MAX; fill++)
+    {
+        seen += m_report.fill_frames[fill];
+
+        if (seen >= p99_count)
+        {
+            break;
+        }
+    }
+
+    return fill;
+}
+
+/**
+ * @return true if the stream played without any glitch.
+ */
+static bool host_sim_report(telemetry_snapshot_t const *p_streaming)
+{
+    static char const *const mode_names[] = {"async", "fixed", "jitter", "cadence"};
+    telemetry_snapshot_t     snapshot;
+    uint32_t                 underruns = p_streaming->counters[TELEMETRY_COUNTER_UNDERRUN];
+    uint32_t                 overruns  = p_streaming->counters[TELEMETRY_COUNTER_OVERRUN];
+    uint32_t                 dropped   = p_streaming->counters[TELEMETRY_COUNTER_POOL_EXHAUSTED];
+    bool                     clean;
+
+    telemetry_snapshot_get(&snapshot);
+
+    printf("mode %s, %u Hz, %u bit, I2S %+.1f ppm, %u ms, %s profile\n",
+           mode_names[m_config.mode],
+           m_config.sample_rate,
+           8 * m_config.subframe_size,
+           m_config.ppm,
+           m_config.duration_ms,
+           CODEC_BUFFER_LOW_LATENCY ? "low latency" : "default");
+    printf("packets %u, missed %u, dropped %u\n", m_report.packets, sim_usbd_packets_missed_get(), dropped);
+    printf("packet sizes:");
+
+    for (uint32_t frames = 1; frames <= HOST_SIM_PACKET_FRAMES_MAX; frames++)
+    {
+        if (m_report.packet_frames[frames] > 0)
+        {
+            printf(" %uB x%u", frames * host_sim_frame_size(), m_report.packet_frames[frames]);
+        }
+    }
+
+    printf("\n");
+    printf("underruns %u, overruns %u, I2S replays %u\n", underruns, overruns, sim_i2s_replays_get());
+    printf("usb configured %u, streams started %u, stopped %u, rx timeouts %u\n",
+           m_report.usb_configured,
+           m_report.stream_starts,
+           m_report.stream_stops,
+           m_report.rx_timeouts);
+
+    if (m_report.streaming_ms > 0)
+    {
+        uint32_t i2s_frames = HOST_SIM_I2S_BLOCKS * CODEC_BUFFER_SIZE_WORDS;
+
+        printf("fill ms min %.2f avg %.2f p99 %.2f max %.2f, target %.2f\n",
+               host_sim_frames_to_ms(m_report.fill_min),
+               host_sim_frames_to_ms((double)m_report.fill_sum / m_report.streaming_ms),
+               host_sim_frames_to_ms(host_sim_fill_p99()),
+               host_sim_frames_to_ms(m_report.fill_max),
+               host_sim_frames_to_ms(CODEC_BUFFER_FILL_TARGET_FRAMES));
+        printf("latency ms p99 %.2f max %.2f, fill and %u blocks held by I2S\n",
+               host_sim_frames_to_ms(host_sim_fill_p99() + i2s_frames),
+               host_sim_frames_to_ms(m_report.fill_max + i2s_frames),
+               HOST_SIM_I2S_BLOCKS);
+        printf("queue depth blocks min %u max %u\n", snapshot.queue_depth_min, snapshot.queue_depth_max);
+    }
+
+    printf("app_timer per s starts %.1f, stops %.1f, expirations %.1f, %s rx timeout\n",
+           m_report.timers.starts * 1000.0 / m_config.duration_ms,
+           m_report.timers.stops * 1000.0 / m_config.duration_ms,
+           m_report.timers.expirations * 1000.0 / m_config.duration_ms,
+           m_config.legacy_rx_timer ? "legacy timer" : "SOF counted");
+
+    printf("cycles, host time scaled to %u MHz:\n", PROFILE_HOST_CPU_MHZ);
+    PROFILE_DUMP();
+
+    clean = (underruns == 0) && (overruns == 0) && (dropped == 0) && (sim_usbd_packets_missed_get() == 0) &&
+            (sim_i2s_replays_get() == 0) && (m_report.stream_starts == 1) && (m_report.stream_stops == 1) &&
+            (m_report.usb_configured == 1);
+
+    printf("%s\n", clean ? "clean" : "GLITCHES");
+
+    return clean;
+}
+
+static void host_sim_usage(char const *p_name)
+{
+    fprintf(stderr,
+            "usage: %s [--mode async|fixed|jitter] [--cadence FILE] [--rate HZ] [--bits 16|24|32] [--ppm PPM]\n"
+            "          [--ms MS] [--late PERMILLE] [--seed N] [--csv FILE] [--legacy-rx-timer] [--expect-clean]\n",
+            p_name);
+}
+
+static bool host_sim_args_parse(int argc, char *argv[])
+{
+    static struct option const options[] = {
+      {"mode", required_argument, NULL, 'm'},
+      {"cadence", required_argument, NULL, 'c'},
+      {"rate", required_argument, NULL, 'r'},
+      {"bits", required_argument, NULL, 'b'},
+      {"ppm", required_argument, NULL, 'p'},
+      {"ms", required_argument, NULL, 't'},
+      {"late", required_argument, NULL, 'l'},
+      {"seed", required_argument, NULL, 's'},
+      {"csv", required_argument, NULL, 'o'},
+      {"legacy-rx-timer", no_argument, NULL, 'x'},
+      {"expect-clean", no_argument, NULL, 'e'},
+      {NULL, 0, NULL, 0},
+    };
+    int option;
+
+    while ((option = getopt_long(argc, argv, "", options, NULL)) != -1)
+    {
+        switch (option)
+        {
+            case 'm':
+                if (strcmp(optarg, "async") == 0)
+                {
+                    m_config.mode = HOST_SIM_MODE_ASYNC;
+                } else if (strcmp(optarg, "fixed") == 0)
+                {
+                    m_config.mode = HOST_SIM_MODE_FIXED;
+                } else if (strcmp(optarg, "jitter") == 0)
+                {
+                    m_config.mode = HOST_SIM_MODE_JITTER;
+                } else
+                {
+                    return false;
+                }
+                break;
+            case 'c':
+                m_config.mode           = HOST_SIM_MODE_CADENCE;
+                m_config.p_cadence_file = optarg;
+                break;
+            case 'r':
+                m_config.sample_rate = strtoul(optarg, NULL, 0);
+                break;
+            case 'b':
+                {
+                    unsigned long bits = strtoul(optarg, NULL, 0);
+
+                    if ((bits != 16) && (bits != 24) && (bits != 32))
+                    {
+                        return false;
+                    }
+
+                    m_config.subframe_size = (uint8_t)(bits / 8);
+                }
+                break;
+            case 'p':
+                m_config.ppm = strtod(optarg, NULL);
+                break;
+            case 't':
+                m_config.duration_ms = strtoul(optarg, NULL, 0);
+                break;
+            case 'l':
+                m_config.late_permille = strtoul(optarg, NULL, 0);
+                break;
+            case 's':
+                m_config.seed = strtoul(optarg, NULL, 0);
+                break;
+            case 'o':
+                m_config.p_csv_file = optarg;
+                break;
+            case 'x':
+                m_config.legacy_rx_timer = true;
+                break;
+            case 'e':
+                m_config.expect_clean = true;
+                break;
+            default:
+                return false;
+        }
+    }
+
+    return (optind == argc) && ((m_config.sample_rate == 44100) || (m_config.sample_rate == 48000));
+}
+
+int main(int argc, char *argv[])
+{
+    ret_code_t           err_code;
+    telemetry_snapshot_t streaming;
+    FILE                *p_csv = NULL;
+    bool                 clean;
+
+    if (!host_sim_args_parse(argc, argv))
+    {
+        host_sim_usage(argv[0]);
+        return 2;
+    }
+
+    if (m_config.p_cadence_file != NULL)
+    {
+        err_code = host_sim_cadence_load(m_config.p_cadence_file);
+
+        if (err_code != NRF_SUCCESS)
+        {
+            fprintf(stderr, "could not load cadence %s: error %u\n", m_config.p_cadence_file, err_code);
+            return 2;
+        }
+    }
+
+    if (m_config.p_csv_file != NULL)
+    {
+        p_csv = fopen(m_config.p_csv_file, "w");
+
+        if (p_csv == NULL)
+        {
+            fprintf(stderr, "could not open %s\n", m_config.p_csv_file);
+            return 2;
+        }
+
+        fprintf(p_csv, "ms,packet_bytes,fill_frames,queue_blocks,feedback\n");
+    }
+
+    m_host.rng      = m_config.seed;
+    m_host.feedback = (m_config.sample_rate << 14) / 1000;
+
+    profile_cycle_counter_init();
+    PROFILE_INIT();
+    telemetry_init();
+
+    err_code = codec_init(&m_twi_mngr_codec, codec_event_handler);
+    APP_ERROR_CHECK(err_code);
+
+    err_code = usb_init(usb_event_handler, &m_usb_rx_handlers);
+    APP_ERROR_CHECK(err_code);
+
+    err_code = app_timer_create(&m_legacy_rx_timer, APP_TIMER_MODE_SINGLE_SHOT, host_sim_legacy_rx_timeout_handler);
+    APP_ERROR_CHECK(err_code);
+
+    sim_usbd_connect();
+    app_sched_execute();
+
+    sim_usbd_sample_rate_set(m_config.sample_rate);
+    app_sched_execute();
+
+    err_code = sim_usbd_alternate_set(m_config.subframe_size - 1); // Alternate settings follow usb.c formats
+    APP_ERROR_CHECK(err_code);
+
+    host_sim_run(p_csv, &streaming);
+
+    if (p_csv != NULL)
+    {
+        fclose(p_csv);
+    }
+
+    clean = host_sim_report(&streaming);
+
+    return (m_config.expect_clean && !clean) ? 1 : 0;
+}
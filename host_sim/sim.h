@@ -0,0 +1,139 @@
+/**
+ * @file        sim.h
+ * @author      Danius Kalvaitis (danius.kalvaitis@gmail.com)
+ * @brief       Controls of the host simulation stand-ins for the SDK drivers.
+ * @version     0.1
+ * @date        2026-10-17
+ *
+ * @copyright   Copyright (c) Danius Kalvaitis 2026 All rights reserved
+ *
+ * The application sources are built unchanged against the stubs directory. Nothing runs on its own: the simulation
+ * moves USB frames, I2S frames, app_timer ticks and input pins forward explicitly, and every driver callback is made
+ * from inside these calls, the same way the interrupts would preempt the main loop on target.
+ */
+
+#ifndef SIM_H
+#define SIM_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include "app_usbd_core.h"
+#include "sdk_errors.h"
+
+/**
+ * @brief Move app_timer time forward, expired timers are called in expiry order.
+ */
+void sim_timer_advance(uint32_t ticks);
+
+/**
+ * @brief Current simulation time in app_timer ticks.
+ */
+uint32_t sim_timer_now(void);
+
+typedef struct
+{
+    uint32_t starts;      /**< app_timer_start calls, each one a timer list operation on target. */
+    uint32_t stops;       /**< app_timer_stop calls, also for timers that were not running. */
+    uint32_t expirations; /**< Timeout handlers called. */
+} sim_timer_stats_t;
+
+void sim_timer_stats_get(sim_timer_stats_t *p_stats);
+
+/**
+ * @brief Total bytes the application wrote to an RTT up channel.
+ */
+size_t sim_rtt_bytes_get(unsigned channel);
+
+/**
+ * @brief Play frames on the simulated I2S bus. The data handler is called for every finished block.
+ */
+void sim_i2s_frames(uint32_t frames);
+
+bool sim_i2s_is_running(void);
+
+/**
+ * @brief Blocks the simulated I2S has played since the last start.
+ */
+uint32_t sim_i2s_blocks_get(void);
+
+/**
+ * @brief Blocks played twice because the data handler had not set the next buffers in time.
+ */
+uint32_t sim_i2s_replays_get(void);
+
+/**
+ * @brief Drive an input pin. The GPIOTE handler of the pin is called if the edge matches its sense.
+ */
+void sim_gpio_input_set(uint32_t pin_number, bool high);
+
+/**
+ * @brief Level the application drives on an output pin.
+ */
+bool sim_gpio_output_get(uint32_t pin_number);
+
+/**
+ * @brief High to low transitions the application drove on an output pin.
+ */
+uint32_t sim_gpio_falling_edges_get(uint32_t pin_number);
+
+typedef struct
+{
+    uint32_t transactions; /**< Scheduled with the TWI manager. */
+    uint32_t bursts;       /**< Register writes, one register address and its auto-increment data each. */
+    uint32_t bytes;        /**< Written by the bursts, register addresses included. */
+} sim_twi_stats_t;
+
+/**
+ * @brief Run the scheduled TWI transactions in order and call their callbacks.
+ */
+void sim_twi_complete(void);
+
+/**
+ * @brief TWI transactions scheduled but not completed yet.
+ */
+size_t sim_twi_pending_get(void);
+
+void sim_twi_stats_get(sim_twi_stats_t *p_stats);
+
+/**
+ * @brief Codec register value as written over the simulated bus.
+ */
+uint8_t sim_twi_reg_get(uint8_t page, uint8_t reg);
+
+/**
+ * @brief Attach the device: power detected, power ready and started events, then enter the configured state.
+ */
+void sim_usbd_connect(void);
+
+/**
+ * @brief Select a streaming alternate setting as the host would with SET_INTERFACE.
+ */
+ret_code_t sim_usbd_alternate_set(uint8_t alternate);
+
+/**
+ * @brief Send an endpoint SET_CUR sampling frequency request.
+ */
+void sim_usbd_sample_rate_set(uint32_t sample_rate);
+
+/**
+ * @brief Run one 1 ms USB frame. The packet received in the previous frame is reported at SOF, size 0 sends none.
+ */
+void sim_usbd_frame(void const *p_packet, size_t size);
+
+/**
+ * @brief Read the feedback endpoint as the host does once per refresh period.
+ *
+ * @param[out] p_feedback Samples per frame in 10.14 format.
+ *
+ * @return false if the device has not queued a value since the last read.
+ */
+bool sim_usbd_feedback_read(uint32_t *p_feedback);
+
+/**
+ * @brief Packets the device did not arm a transfer for.
+ */
+uint32_t sim_usbd_packets_missed_get(void);
+
+#endif // SIM_H
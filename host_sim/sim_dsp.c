@@ -0,0 +1,74 @@
+/**
+ * @file        sim_dsp.c
+ * @author      Danius Kalvaitis (danius.kalvaitis@gmail.com)
+ * @brief       Host simulation stand-in for the CMSIS DSP biquad cascade. Same arithmetic as the CMSIS C version.
+ * @version     0.1
+ * @date        2026-10-17
+ *
+ * @copyright   Copyright (c) Danius Kalvaitis 2026 All rights reserved
+ *
+ */
+
+#include "arm_math.h"
+
+void arm_biquad_cascade_df1_init_q31(arm_biquad_casd_df1_inst_q31 *S,
+                                     uint8_t                       numStages,
+                                     q31_t const                  *pCoeffs,
+                                     q31_t                        *pState,
+                                     int8_t                        postShift)
+{
+    S->numStages = numStages;
+    S->pCoeffs   = pCoeffs;
+    S->postShift = (uint8_t)postShift;
+    S->pState    = pState;
+
+    memset(pState, 0, 4U * numStages * sizeof(q31_t));
+}
+
+void arm_biquad_cascade_df1_q31(arm_biquad_casd_df1_inst_q31 const *S, q31_t *pSrc, q31_t *pDst, uint32_t blockSize)
+{
+    q31_t const *pIn    = pSrc;
+    q31_t const *pCoeff = S->pCoeffs;
+    q31_t       *pState = S->pState;
+    uint32_t     lShift = 32U - (S->postShift + 1U);
+
+    for (uint32_t stage = 0; stage < S->numStages; stage++)
+    {
+        q31_t b0  = pCoeff[0];
+        q31_t b1  = pCoeff[1];
+        q31_t b2  = pCoeff[2];
+        q31_t a1  = pCoeff[3];
+        q31_t a2  = pCoeff[4];
+        q31_t Xn1 = pState[0];
+        q31_t Xn2 = pState[1];
+        q31_t Yn1 = pState[2];
+        q31_t Yn2 = pState[3];
+
+        for (uint32_t i = 0; i < blockSize; i++)
+        {
+            q31_t Xn  = pIn[i];
+            q63_t acc = (q63_t)b0 * Xn;
+
+            acc += (q63_t)b1 * Xn1;
+            acc += (q63_t)b2 * Xn2;
+            acc += (q63_t)a1 * Yn1;
+            acc += (q63_t)a2 * Yn2;
+
+            Xn2 = Xn1;
+            Xn1 = Xn;
+            Yn2 = Yn1;
+            Yn1 = (q31_t)(acc >> lShift);
+
+            pDst[i] = Yn1;
+        }
+
+        pState[0] = Xn1;
+        pState[1] = Xn2;
+        pState[2] = Yn1;
+        pState[3] = Yn2;
+
+        pIn = pDst; // Next stage filters the output of this one
+        pCoeff += 5;
+        pState += 4;
+    }
+}
@@ -0,0 +1,124 @@
+/**
+ * @file        sim_gpio.c
+ * @author      Danius Kalvaitis (danius.kalvaitis@gmail.com)
+ * @brief       Host simulation stand-in for the GPIO HAL and GPIOTE input events.
+ * @version     0.1
+ * @date        2026-10-17
+ *
+ * @copyright   Copyright (c) Danius Kalvaitis 2026 All rights reserved
+ *
+ * One port of 32 pins. The application drives outputs, the simulation drives inputs with sim_gpio_input_set(), which
+ * calls the GPIOTE handler of the pin right away when the edge matches its sense, like the GPIOTE interrupt would.
+ */
+
+#include "nrf_gpio.h"
+#include "nrfx_gpiote.h"
+#include "sdk_common.h"
+#include "sim.h"
+
+#define SIM_GPIO_PINS 32
+
+typedef struct
+{
+    nrfx_gpiote_evt_handler_t handler;
+    nrf_gpiote_polarity_t     sense;
+    bool                      enabled;
+} sim_gpiote_in_t;
+
+static bool            m_levels[SIM_GPIO_PINS];
+static uint32_t        m_falling_edges[SIM_GPIO_PINS]; /**< Driven by the application. */
+static sim_gpiote_in_t m_gpiote_in[SIM_GPIO_PINS];
+
+static void sim_gpio_level_set(uint32_t pin_number, bool high)
+{
+    if (pin_number >= SIM_GPIO_PINS)
+    {
+        return;
+    }
+
+    if (m_levels[pin_number] && !high)
+    {
+        m_falling_edges[pin_number]++;
+    }
+
+    m_levels[pin_number] = high;
+}
+
+void nrf_gpio_cfg(uint32_t             pin_number,
+                  nrf_gpio_pin_dir_t   dir,
+                  nrf_gpio_pin_input_t input,
+                  nrf_gpio_pin_pull_t  pull,
+                  nrf_gpio_pin_drive_t drive,
+                  nrf_gpio_pin_sense_t sense)
+{
+    UNUSED_PARAMETER(pin_number);
+    UNUSED_PARAMETER(dir);
+    UNUSED_PARAMETER(input);
+    UNUSED_PARAMETER(pull);
+    UNUSED_PARAMETER(drive);
+    UNUSED_PARAMETER(sense);
+}
+
+void nrf_gpio_cfg_output(uint32_t pin_number) { UNUSED_PARAMETER(pin_number); }
+
+void nrf_gpio_pin_set(uint32_t pin_number) { sim_gpio_level_set(pin_number, true); }
+
+void nrf_gpio_pin_clear(uint32_t pin_number) { sim_gpio_level_set(pin_number, false); }
+
+uint32_t nrf_gpio_pin_read(uint32_t pin_number)
+{
+    return (pin_number < SIM_GPIO_PINS) ? m_levels[pin_number] : 0;
+}
+
+nrfx_err_t nrfx_gpiote_in_init(nrfx_gpiote_pin_t              pin,
+                               nrfx_gpiote_in_config_t const *p_config,
+                               nrfx_gpiote_evt_handler_t      evt_handler)
+{
+    if ((pin >= SIM_GPIO_PINS) || (p_config == NULL))
+    {
+        return NRF_ERROR_INVALID_PARAM;
+    }
+
+    // The driver refuses a second init, the simulation allows it so tests can start over
+    m_gpiote_in[pin].handler = evt_handler;
+    m_gpiote_in[pin].sense   = p_config->sense;
+    m_gpiote_in[pin].enabled = false;
+
+    return NRF_SUCCESS;
+}
+
+void nrfx_gpiote_in_event_enable(nrfx_gpiote_pin_t pin, bool int_enable)
+{
+    if (pin < SIM_GPIO_PINS)
+    {
+        m_gpiote_in[pin].enabled = int_enable;
+    }
+}
+
+void sim_gpio_input_set(uint32_t pin_number, bool high)
+{
+    sim_gpiote_in_t const *p_in;
+    nrf_gpiote_polarity_t  edge;
+
+    if ((pin_number >= SIM_GPIO_PINS) || (m_levels[pin_number] == high))
+    {
+        return;
+    }
+
+    m_levels[pin_number] = high;
+
+    p_in = &m_gpiote_in[pin_number];
+    edge = high ? NRF_GPIOTE_POLARITY_LOTOHI : NRF_GPIOTE_POLARITY_HITOLO;
+
+    if (p_in->enabled && (p_in->handler != NULL) && ((p_in->sense & edge) != 0))
+    {
+        p_in->handler(pin_number, p_in->sense);
+    }
+}
+
+bool sim_gpio_output_get(uint32_t pin_number) { return (pin_number < SIM_GPIO_PINS) && m_levels[pin_number]; }
+
+uint32_t sim_gpio_falling_edges_get(uint32_t pin_number)
+{
+    return (pin_number < SIM_GPIO_PINS) ? m_falling_edges[pin_number] : 0;
+}
@@ -0,0 +1,68 @@
+/**
+ * @file        sim_hal.c
+ * @author      Danius Kalvaitis (danius.kalvaitis@gmail.com)
+ * @brief       Host simulation stand-ins for the codec HAL and RAM power control. Hardware is always ready.
+ * @version     0.1
+ * @date        2026-10-17
+ *
+ * @copyright   Copyright (c) Danius Kalvaitis 2026 All rights reserved
+ *
+ */
+
+#include "codec_hal.h"
+#include "ram_power.h"
+#include "sdk_common.h"
+
+ret_code_t codec_hal_init(dk_twi_mngr_t const *p_dk_twi_mngr, codec_hal_evt_handler_t evt_handler)
+{
+    VERIFY_PARAM_NOT_NULL(p_dk_twi_mngr);
+    VERIFY_PARAM_NOT_NULL(evt_handler);
+
+    return NRF_SUCCESS;
+}
+
+ret_code_t codec_hal_mode_set(codec_mode_t mode)
+{
+    UNUSED_PARAMETER(mode);
+
+    return NRF_SUCCESS;
+}
+
+ret_code_t codec_hal_mute(bool mute)
+{
+    UNUSED_PARAMETER(mute);
+
+    return NRF_SUCCESS;
+}
+
+ret_code_t codec_hal_volume_set(int16_t volume)
+{
+    UNUSED_PARAMETER(volume);
+
+    return NRF_SUCCESS;
+}
+
+ret_code_t codec_hal_biquads_set(codec_hal_biquad_t const *p_biquads)
+{
+    VERIFY_PARAM_NOT_NULL(p_biquads);
+
+    return NRF_SUCCESS;
+}
+
+ret_code_t codec_hal_clock_set(uint32_t sample_rate)
+{
+    UNUSED_PARAMETER(sample_rate);
+
+    return NRF_SUCCESS;
+}
+
+void codec_hal_debug(void) {}
+
+ret_code_t ram_power_set(void const *p_start, size_t size, bool on)
+{
+    UNUSED_PARAMETER(p_start);
+    UNUSED_PARAMETER(size);
+    UNUSED_PARAMETER(on);
+
+    return NRF_SUCCESS;
+}
@@ -0,0 +1,168 @@
+/**
+ * @file        sim_i2s.c
+ * @author      Danius Kalvaitis (danius.kalvaitis@gmail.com)
+ * @brief       Host simulation stand-in for the nrfx I2S driver.
+ * @version     0.1
+ * @date        2026-10-17
+ *
+ * @copyright   Copyright (c) Danius Kalvaitis 2026 All rights reserved
+ *
+ * Follows the driver callback sequence: start requests the next buffers before any data is played, every finished
+ * block releases the previous buffers and requests the next ones, and stop releases the current and the next buffers
+ * with two calls once the interrupt that stopped it has returned. Handlers never nest, like the I2S interrupt.
+ */
+
+#include "nrfx_i2s.h"
+#include "sim.h"
+
+static nrfx_i2s_data_handler_t m_handler;
+static bool                    m_running;
+static bool                    m_in_handler;
+static bool                    m_start_pending;
+static bool                    m_stop_pending;
+static nrfx_i2s_buffers_t      m_current;
+static nrfx_i2s_buffers_t      m_next;
+static uint16_t                m_block_words;
+static uint32_t                m_block_pos;
+static uint32_t                m_blocks;
+static uint32_t                m_replays; /**< Blocks played again because the next buffers came too late. */
+
+static void sim_i2s_handler_call(nrfx_i2s_buffers_t const *p_released, uint32_t status)
+{
+    m_in_handler = true;
+    m_handler(p_released, status);
+    m_in_handler = false;
+}
+
+/**
+ * @brief Deliver driver events that were raised while the handler or the caller was running.
+ */
+static void sim_i2s_pending_process(void)
+{
+    if (m_in_handler)
+    {
+        return;
+    }
+
+    if (m_start_pending)
+    {
+        nrfx_i2s_buffers_t const released = {.p_rx_buffer = NULL, .p_tx_buffer = NULL};
+
+        m_start_pending = false;
+        sim_i2s_handler_call(&released, NRFX_I2S_STATUS_NEXT_BUFFERS_NEEDED);
+    }
+
+    if (m_stop_pending)
+    {
+        nrfx_i2s_buffers_t const current = m_current;
+        nrfx_i2s_buffers_t const next    = m_next;
+
+        m_stop_pending = false;
+        sim_i2s_handler_call(&current, 0);
+        sim_i2s_handler_call(&next, 0);
+    }
+}
+
+nrfx_err_t nrfx_i2s_init(nrfx_i2s_config_t const *p_config, nrfx_i2s_data_handler_t handler)
+{
+    VERIFY_PARAM_NOT_NULL(p_config);
+    VERIFY_PARAM_NOT_NULL(handler);
+
+    m_handler = handler;
+    m_running = false;
+
+    return NRF_SUCCESS;
+}
+
+nrfx_err_t nrfx_i2s_start(nrfx_i2s_buffers_t const *p_initial_buffers, uint16_t buffer_size, uint8_t flags)
+{
+    VERIFY_PARAM_NOT_NULL(p_initial_buffers);
+    UNUSED_PARAMETER(flags);
+
+    if (m_running || m_stop_pending)
+    {
+        return NRF_ERROR_INVALID_STATE;
+    }
+
+    if ((p_initial_buffers->p_tx_buffer == NULL) || (buffer_size == 0))
+    {
+        return NRF_ERROR_INVALID_PARAM;
+    }
+
+    m_current       = *p_initial_buffers;
+    m_next          = (nrfx_i2s_buffers_t){0};
+    m_block_words   = buffer_size;
+    m_block_pos     = 0;
+    m_blocks        = 0;
+    m_running       = true;
+    m_start_pending = true;
+
+    return NRF_SUCCESS;
+}
+
+nrfx_err_t nrfx_i2s_next_buffers_set(nrfx_i2s_buffers_t const *p_buffers)
+{
+    VERIFY_PARAM_NOT_NULL(p_buffers);
+
+    if (!m_running)
+    {
+        return NRF_ERROR_INVALID_STATE;
+    }
+
+    m_next = *p_buffers;
+
+    return NRF_SUCCESS;
+}
+
+void nrfx_i2s_stop(void)
+{
+    if (!m_running)
+    {
+        return;
+    }
+
+    m_running      = false;
+    m_stop_pending = true;
+    sim_i2s_pending_process();
+}
+
+void sim_i2s_frames(uint32_t frames)
+{
+    sim_i2s_pending_process();
+
+    while (m_running && (frames > 0))
+    {
+        uint32_t step = MIN(frames, m_block_words - m_block_pos);
+
+        frames -= step;
+        m_block_pos += step;
+
+        if (m_block_pos < m_block_words)
+        {
+            break;
+        }
+
+        m_block_pos = 0;
+        m_blocks++;
+
+        if (m_next.p_tx_buffer == NULL)
+        {
+            m_replays++; // EasyDMA starts over from the pointer it already has
+            continue;
+        }
+
+        nrfx_i2s_buffers_t const released = m_current;
+
+        m_current = m_next;
+        m_next    = (nrfx_i2s_buffers_t){0};
+
+        sim_i2s_handler_call(&released, NRFX_I2S_STATUS_NEXT_BUFFERS_NEEDED);
+        sim_i2s_pending_process();
+    }
+}
+
+bool sim_i2s_is_running(void) { return m_running; }
+
+uint32_t sim_i2s_blocks_get(void) { return m_blocks; }
+
+uint32_t sim_i2s_replays_get(void) { return m_replays; }
@@ -0,0 +1,238 @@
+/**
+ * @file        sim_sdk.c
+ * @author      Danius Kalvaitis (danius.kalvaitis@gmail.com)
+ * @brief       Host simulation stand-ins for the SDK error handler, scheduler, app_timer, RTT and clock driver.
+ * @version     0.1
+ * @date        2026-10-17
+ *
+ * @copyright   Copyright (c) Danius Kalvaitis 2026 All rights reserved
+ *
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "SEGGER_RTT.h"
+#include "app_error.h"
+#include "app_scheduler.h"
+#include "app_timer.h"
+#include "nrf_drv_clock.h"
+#include "sim.h"
+
+#define SIM_SCHED_QUEUE_SIZE     32
+#define SIM_SCHED_EVENT_SIZE_MAX 16
+#define SIM_TIMERS_MAX           16
+#define SIM_TIMER_MASK           0x00FFFFFF /**< RTC counter width. */
+
+typedef struct
+{
+    app_sched_event_handler_t handler;
+    uint16_t                  event_size;
+    uint32_t                  event_data[SIM_SCHED_EVENT_SIZE_MAX / sizeof(uint32_t)]; /**< Word aligned copy. */
+} sim_sched_event_t;
+
+static sim_sched_event_t m_sched_queue[SIM_SCHED_QUEUE_SIZE];
+static size_t            m_sched_head;
+static size_t            m_sched_tail;
+
+static app_timer_t      *mp_timers[SIM_TIMERS_MAX];
+static size_t            m_timer_count;
+static uint32_t          m_now;
+static sim_timer_stats_t m_timer_stats;
+
+static size_t m_rtt_bytes[SEGGER_RTT_MAX_NUM_UP_BUFFERS];
+
+void app_error_handler(ret_code_t error_code, uint32_t line_num, char const *p_file_name)
+{
+    fprintf(stderr, "%s:%u: error %u\n", p_file_name, line_num, error_code);
+    abort();
+}
+
+ret_code_t app_sched_event_put(void const *p_event_data, uint16_t event_size, app_sched_event_handler_t handler)
+{
+    size_t             next = (m_sched_tail + 1) % SIM_SCHED_QUEUE_SIZE;
+    sim_sched_event_t *p_event;
+
+    if (event_size > SIM_SCHED_EVENT_SIZE_MAX)
+    {
+        return NRF_ERROR_INVALID_LENGTH;
+    }
+
+    if (next == m_sched_head)
+    {
+        return NRF_ERROR_NO_MEM;
+    }
+
+    p_event             = &m_sched_queue[m_sched_tail];
+    p_event->handler    = handler;
+    p_event->event_size = event_size;
+
+    if ((p_event_data != NULL) && (event_size > 0))
+    {
+        memcpy(p_event->event_data, p_event_data, event_size);
+    }
+
+    m_sched_tail = next;
+
+    return NRF_SUCCESS;
+}
+
+void app_sched_execute(void)
+{
+    while (m_sched_head != m_sched_tail)
+    {
+        sim_sched_event_t event = m_sched_queue[m_sched_head];
+
+        m_sched_head = (m_sched_head + 1) % SIM_SCHED_QUEUE_SIZE;
+        event.handler((event.event_size > 0) ? event.event_data : NULL, event.event_size);
+    }
+}
+
+ret_code_t app_timer_create(app_timer_id_t const      *p_timer_id,
+                            app_timer_mode_t            mode,
+                            app_timer_timeout_handler_t timeout_handler)
+{
+    app_timer_t *p_timer;
+
+    VERIFY_PARAM_NOT_NULL(p_timer_id);
+    VERIFY_PARAM_NOT_NULL(timeout_handler);
+
+    p_timer = *p_timer_id;
+
+    if (p_timer->handler == NULL)
+    {
+        if (m_timer_count == SIM_TIMERS_MAX)
+        {
+            return NRF_ERROR_NO_MEM;
+        }
+
+        mp_timers[m_timer_count++] = p_timer;
+    }
+
+    p_timer->handler = timeout_handler;
+    p_timer->mode    = mode;
+    p_timer->active  = false;
+
+    return NRF_SUCCESS;
+}
+
+ret_code_t app_timer_start(app_timer_id_t timer_id, uint32_t timeout_ticks, void *p_context)
+{
+    VERIFY_PARAM_NOT_NULL(timer_id);
+
+    if ((timer_id->handler == NULL) || (timeout_ticks == 0))
+    {
+        return NRF_ERROR_INVALID_PARAM;
+    }
+
+    timer_id->p_context = p_context;
+    timer_id->expiry    = m_now + timeout_ticks;
+    timer_id->interval  = timeout_ticks;
+    timer_id->active    = true;
+
+    m_timer_stats.starts++;
+
+    return NRF_SUCCESS;
+}
+
+ret_code_t app_timer_stop(app_timer_id_t timer_id)
+{
+    VERIFY_PARAM_NOT_NULL(timer_id);
+
+    timer_id->active = false;
+
+    m_timer_stats.stops++;
+
+    return NRF_SUCCESS;
+}
+
+uint32_t app_timer_cnt_get(void) { return m_now & SIM_TIMER_MASK; }
+
+uint32_t app_timer_cnt_diff_compute(uint32_t ticks_to, uint32_t ticks_from)
+{
+    return (ticks_to - ticks_from) & SIM_TIMER_MASK;
+}
+
+/**
+ * @brief Earliest active timer expiring at or before a tick, NULL if none.
+ */
+static app_timer_t *sim_timer_next_get(uint32_t until)
+{
+    app_timer_t *p_next = NULL;
+
+    for (size_t i = 0; i < m_timer_count; i++)
+    {
+        app_timer_t *p_timer = mp_timers[i];
+
+        if (!p_timer->active || ((int32_t)(until - p_timer->expiry) < 0))
+        {
+            continue;
+        }
+
+        if ((p_next == NULL) || ((int32_t)(p_timer->expiry - p_next->expiry) < 0))
+        {
+            p_next = p_timer;
+        }
+    }
+
+    return p_next;
+}
+
+void sim_timer_advance(uint32_t ticks)
+{
+    uint32_t     until = m_now + ticks;
+    app_timer_t *p_timer;
+
+    while ((p_timer = sim_timer_next_get(until)) != NULL)
+    {
+        m_now = p_timer->expiry;
+
+        if (p_timer->mode == APP_TIMER_MODE_REPEATED)
+        {
+            p_timer->expiry += p_timer->interval;
+        } else
+        {
+            p_timer->active = false;
+        }
+
+        m_timer_stats.expirations++;
+        p_timer->handler(p_timer->p_context);
+    }
+
+    m_now = until;
+}
+
+uint32_t sim_timer_now(void) { return m_now; }
+
+void sim_timer_stats_get(sim_timer_stats_t *p_stats) { *p_stats = m_timer_stats; }
+
+int SEGGER_RTT_ConfigUpBuffer(unsigned buffer_index, char const *s_name, void *p_buffer, unsigned size, unsigned flags)
+{
+    UNUSED_PARAMETER(s_name);
+    UNUSED_PARAMETER(p_buffer);
+    UNUSED_PARAMETER(size);
+    UNUSED_PARAMETER(flags);
+
+    return (buffer_index < SEGGER_RTT_MAX_NUM_UP_BUFFERS) ? 0 : -1;
+}
+
+unsigned SEGGER_RTT_Write(unsigned buffer_index, void const *p_buffer, unsigned num_bytes)
+{
+    UNUSED_PARAMETER(p_buffer);
+
+    if (buffer_index >= SEGGER_RTT_MAX_NUM_UP_BUFFERS)
+    {
+        return 0;
+    }
+
+    m_rtt_bytes[buffer_index] += num_bytes;
+
+    return num_bytes;
+}
+
+size_t sim_rtt_bytes_get(unsigned channel)
+{
+    return (channel < SEGGER_RTT_MAX_NUM_UP_BUFFERS) ? m_rtt_bytes[channel] : 0;
+}
+
+ret_code_t nrf_drv_clock_init(void) { return NRF_SUCCESS; }
@@ -0,0 +1,240 @@
+/**
+ * @file        sim_twi.c
+ * @author      Danius Kalvaitis (danius.kalvaitis@gmail.com)
+ * @brief       Host simulation stand-ins for the TWI transaction manager and the TLV320AIC3106 driver.
+ * @version     0.1
+ * @date        2026-10-17
+ *
+ * @copyright   Copyright (c) Danius Kalvaitis 2026 All rights reserved
+ *
+ * Scheduled transactions wait in a queue until sim_twi_complete() runs them in order against a register file of two
+ * pages, then their callbacks are made as from the TWI interrupt. A write transfer is one burst: register address,
+ * then data written with auto-increment. A read continues at the address of the write before it.
+ */
+
+#include "dk_twi_mngr.h"
+#include "sdk_common.h"
+#include "sim.h"
+#include "tlv320aic3106.h"
+
+#define SIM_TWI_QUEUE_SIZE        8
+#define SIM_TWI_PAGE_SIZE         128
+#define SIM_TWI_REG_PAGE          0
+#define SIM_TWI_REG_DAC_PWR       37 /**< Left and right DAC power in bits 7 and 6. */
+#define SIM_TWI_REG_LEFT_LOP_LVL  86 /**< Output power in bit 0. */
+#define SIM_TWI_REG_RIGHT_LOP_LVL 93
+
+static dk_twi_mngr_transaction_t const *m_queue[SIM_TWI_QUEUE_SIZE];
+static size_t                           m_queue_count;
+static uint8_t                          m_regs[2][SIM_TWI_PAGE_SIZE];
+static uint8_t                          m_reg_pointer;
+static sim_twi_stats_t                  m_stats;
+static tlv320aic3106_evt_handler_t      m_evt_handler;
+
+ret_code_t dk_twi_mngr_schedule(dk_twi_mngr_t const *p_dk_twi_mngr, dk_twi_mngr_transaction_t const *p_transaction)
+{
+    VERIFY_PARAM_NOT_NULL(p_dk_twi_mngr);
+    VERIFY_PARAM_NOT_NULL(p_transaction);
+
+    if (m_queue_count == SIM_TWI_QUEUE_SIZE)
+    {
+        return NRF_ERROR_NO_MEM;
+    }
+
+    m_queue[m_queue_count++] = p_transaction;
+    m_stats.transactions++;
+
+    return NRF_SUCCESS;
+}
+
+static uint8_t *sim_twi_reg_ptr(uint8_t reg)
+{
+    uint8_t page = m_regs[0][SIM_TWI_REG_PAGE] & 1;
+
+    return &m_regs[page][reg % SIM_TWI_PAGE_SIZE];
+}
+
+static void sim_twi_transfer(dk_twi_mngr_transfer_t const *p_transfer)
+{
+    if (DK_TWI_MNGR_IS_READ_OP(p_transfer->operation))
+    {
+        for (size_t i = 0; i < p_transfer->length; i++)
+        {
+            p_transfer->p_data[i] = *sim_twi_reg_ptr(m_reg_pointer++);
+        }
+
+        return;
+    }
+
+    if (p_transfer->length > 1) // Not only the register address of a read that follows
+    {
+        m_stats.bursts++;
+        m_stats.bytes += p_transfer->length;
+    }
+
+    m_reg_pointer = p_transfer->p_data[0];
+
+    for (size_t i = 1; i < p_transfer->length; i++)
+    {
+        *sim_twi_reg_ptr(m_reg_pointer++) = p_transfer->p_data[i];
+    }
+}
+
+void sim_twi_complete(void)
+{
+    while (m_queue_count > 0)
+    {
+        dk_twi_mngr_transaction_t const *p_transaction = m_queue[0];
+
+        memmove(&m_queue[0], &m_queue[1], --m_queue_count * sizeof(m_queue[0]));
+
+        for (size_t i = 0; i < p_transaction->number_of_transfers; i++)
+        {
+            sim_twi_transfer(&p_transaction->p_transfers[i]);
+        }
+
+        if (p_transaction->callback != NULL)
+        {
+            p_transaction->callback(NRF_SUCCESS, p_transaction->p_user_data);
+        }
+    }
+}
+
+size_t sim_twi_pending_get(void) { return m_queue_count; }
+
+void sim_twi_stats_get(sim_twi_stats_t *p_stats) { *p_stats = m_stats; }
+
+uint8_t sim_twi_reg_get(uint8_t page, uint8_t reg) { return m_regs[page & 1][reg % SIM_TWI_PAGE_SIZE]; }
+
+ret_code_t tlv320aic3106_init(tlv320aic3106_t const *p_inst, tlv320aic3106_evt_handler_t evt_handler)
+{
+    VERIFY_PARAM_NOT_NULL(p_inst);
+
+    m_evt_handler = evt_handler;
+
+    return NRF_SUCCESS;
+}
+
+ret_code_t tlv320aic3106_pll_init(tlv320aic3106_t const *p_inst, tlv320aic3106_pll_config_t const *p_config)
+{
+    UNUSED_PARAMETER(p_inst);
+    UNUSED_PARAMETER(p_config);
+
+    return NRF_SUCCESS;
+}
+
+ret_code_t tlv320aic3106_set_clkin_src(tlv320aic3106_t const *p_inst, tlv320aic3106_codec_clkin_src_t clkin_src)
+{
+    UNUSED_PARAMETER(p_inst);
+    UNUSED_PARAMETER(clkin_src);
+
+    return NRF_SUCCESS;
+}
+
+ret_code_t tlv320aic3106_set_audio_ser_data_interface_ctrl_a(
+  tlv320aic3106_t const *p_inst, tlv320aic3106_audio_ser_data_interface_ctrl_a_t const *p_ctrl)
+{
+    UNUSED_PARAMETER(p_inst);
+    UNUSED_PARAMETER(p_ctrl);
+
+    return NRF_SUCCESS;
+}
+
+ret_code_t tlv320aic3106_set_audio_ser_data_interface_ctrl_b(
+  tlv320aic3106_t const *p_inst, tlv320aic3106_audio_ser_data_interface_ctrl_b_t const *p_ctrl)
+{
+    UNUSED_PARAMETER(p_inst);
+    UNUSED_PARAMETER(p_ctrl);
+
+    return NRF_SUCCESS;
+}
+
+ret_code_t tlv320aic3106_set_datapath(tlv320aic3106_t const *p_inst, tlv320aic3106_datapath_setup_t const *p_setup)
+{
+    UNUSED_PARAMETER(p_inst);
+    UNUSED_PARAMETER(p_setup);
+
+    return NRF_SUCCESS;
+}
+
+ret_code_t tlv320aic3106_set_dac_quiescent_current(tlv320aic3106_t const                           *p_inst,
+                                                   tlv320aic3106_dac_quiescent_current_adj_t const *p_adj)
+{
+    UNUSED_PARAMETER(p_inst);
+    UNUSED_PARAMETER(p_adj);
+
+    return NRF_SUCCESS;
+}
+
+ret_code_t tlv320aic3106_set_dac_pwr(tlv320aic3106_t const *p_inst, bool left_dac_pwr_on, bool right_dac_pwr_on)
+{
+    UNUSED_PARAMETER(p_inst);
+    UNUSED_PARAMETER(left_dac_pwr_on);
+    UNUSED_PARAMETER(right_dac_pwr_on);
+
+    return NRF_SUCCESS;
+}
+
+ret_code_t tlv320aic3106_set_dac_out_switch_ctrl(tlv320aic3106_t const                     *p_inst,
+                                                 tlv320aic3106_dac_out_switch_ctrl_t const *p_ctrl)
+{
+    UNUSED_PARAMETER(p_inst);
+    UNUSED_PARAMETER(p_ctrl);
+
+    return NRF_SUCCESS;
+}
+
+ret_code_t tlv320aic3106_set_dac_dig_volume_ctrl(tlv320aic3106_t const                     *p_inst,
+                                                 tlv320aic3106_dac_dig_volume_ctrl_t const *p_ctrl)
+{
+    UNUSED_PARAMETER(p_inst);
+    UNUSED_PARAMETER(p_ctrl);
+
+    return NRF_SUCCESS;
+}
+
+ret_code_t tlv320aic3106_set_dac_x1_to_lop(tlv320aic3106_t const                    *p_inst,
+                                           tlv320aic3106_x_to_y_volume_ctrl_t const *p_ctrl)
+{
+    UNUSED_PARAMETER(p_inst);
+    UNUSED_PARAMETER(p_ctrl);
+
+    return NRF_SUCCESS;
+}
+
+ret_code_t tlv320aic3106_set_lop_m_out_lvl_ctrl(tlv320aic3106_t const                *p_inst,
+                                                tlv320aic3106_x_out_lvl_ctrl_t const *p_ctrl)
+{
+    UNUSED_PARAMETER(p_inst);
+    UNUSED_PARAMETER(p_ctrl);
+
+    return NRF_SUCCESS;
+}
+
+ret_code_t tlv320aic3106_set_line1_bypass(tlv320aic3106_t const *p_inst, bool bypass)
+{
+    UNUSED_PARAMETER(p_inst);
+    UNUSED_PARAMETER(bypass);
+
+    return NRF_SUCCESS;
+}
+
+ret_code_t tlv320aic3106_get_module_power_status(tlv320aic3106_t const *p_inst)
+{
+    tlv320aic3106_module_pwr_status_t status = {
+      .left_dac_powered_up    = (m_regs[0][SIM_TWI_REG_DAC_PWR] & 0x80) != 0,
+      .right_dac_powered_up   = (m_regs[0][SIM_TWI_REG_DAC_PWR] & 0x40) != 0,
+      .left_lop_m_powered_up  = (m_regs[0][SIM_TWI_REG_LEFT_LOP_LVL] & 0x01) != 0,
+      .right_lop_m_powered_up = (m_regs[0][SIM_TWI_REG_RIGHT_LOP_LVL] & 0x01) != 0,
+    };
+    tlv320aic3106_evt_t evt = {.type = TLV320AIC3106_EVT_TYPE_RX_MODULE_PWR_STATUS};
+
+    VERIFY_PARAM_NOT_NULL(p_inst);
+
+    evt.params.p_module_pwr_status = &status;
+    m_evt_handler(&evt);
+
+    return NRF_SUCCESS;
+}
+
+void tlv320aic3106_debug(tlv320aic3106_t const *p_inst) { UNUSED_PARAMETER(p_inst); }
@@ -0,0 +1,246 @@
+/**
+ * @file        sim_usbd.c
+ * @author      Danius Kalvaitis (danius.kalvaitis@gmail.com)
+ * @brief       Host simulation stand-in for app_usbd and the USB audio class.
+ * @version     0.1
+ * @date        2026-10-17
+ *
+ * @copyright   Copyright (c) Danius Kalvaitis 2026 All rights reserved
+ *
+ * Replaces usb_audio.c below its public API, the instance defined by usb.c is used as is. An ISO OUT packet sent by
+ * the host in one frame is reported by usb_audio_rx_size_get() at the next SOF, the transfer armed from the SOF
+ * handler completes right after it returns. The feedback endpoint holds one value until the host reads it.
+ */
+
+#include "app_usbd.h"
+#include "nrf_drv_usbd.h"
+#include "sdk_common.h"
+#include "sim.h"
+#include "usb_audio.h"
+
+const app_usbd_class_methods_t usb_audio_class_methods = {0};
+
+static app_usbd_ev_state_proc_t         m_ev_state_proc;
+static app_usbd_class_inst_t const     *mp_inst;
+static app_usbd_sof_interrupt_handler_t m_sof_handler;
+static app_usbd_state_t                 m_state = APP_USBD_STATE_Disabled;
+static uint16_t                         m_frame_cnt;
+static size_t                           m_rx_size;     /**< Packet waiting in the ISO OUT endpoint. */
+static void                            *mp_rx_buffer;  /**< Transfer armed by the application this frame. */
+static size_t                           m_rx_capacity; /**< Size of the armed transfer. */
+static bool                             m_feedback_queued;
+static uint32_t                         m_packets_missed;
+
+static inline usb_audio_t const *sim_usbd_audio_get(app_usbd_class_inst_t const *p_inst)
+{
+    return (usb_audio_t const *)p_inst;
+}
+
+static inline usb_audio_ctx_t *sim_usbd_ctx_get(app_usbd_class_inst_t const *p_inst)
+{
+    return &sim_usbd_audio_get(p_inst)->specific.p_data->ctx;
+}
+
+static void sim_usbd_user_event(usb_audio_user_event_t event)
+{
+    sim_usbd_audio_get(mp_inst)->specific.inst.user_ev_handler(mp_inst, event);
+}
+
+ret_code_t app_usbd_init(app_usbd_config_t const *p_config)
+{
+    VERIFY_PARAM_NOT_NULL(p_config);
+
+    m_ev_state_proc = p_config->ev_state_proc;
+    m_state         = APP_USBD_STATE_Disabled;
+
+    return NRF_SUCCESS;
+}
+
+ret_code_t app_usbd_class_append(app_usbd_class_inst_t const *p_cinst)
+{
+    VERIFY_PARAM_NOT_NULL(p_cinst);
+
+    mp_inst = p_cinst;
+
+    return NRF_SUCCESS;
+}
+
+ret_code_t app_usbd_power_events_enable(void) { return NRF_SUCCESS; }
+
+void app_usbd_enable(void) { m_state = APP_USBD_STATE_Unattached; }
+
+void app_usbd_disable(void) { m_state = APP_USBD_STATE_Disabled; }
+
+void app_usbd_start(void)
+{
+    m_state = APP_USBD_STATE_Powered;
+    m_ev_state_proc(APP_USBD_EVT_STARTED);
+}
+
+void app_usbd_stop(void) { m_ev_state_proc(APP_USBD_EVT_STOPPED); }
+
+app_usbd_state_t app_usbd_core_state_get(void) { return m_state; }
+
+bool nrf_drv_usbd_is_enabled(void) { return m_state != APP_USBD_STATE_Disabled; }
+
+usb_audio_req_t *usb_audio_request_get(app_usbd_class_inst_t const *p_inst)
+{
+    return &sim_usbd_ctx_get(p_inst)->request;
+}
+
+uint8_t usb_audio_alternate_get(app_usbd_class_inst_t const *p_inst) { return sim_usbd_ctx_get(p_inst)->alternate; }
+
+size_t usb_audio_packet_size_max(app_usbd_class_inst_t const *p_inst, uint8_t alternate)
+{
+    usb_audio_inst_t const *p_config = &sim_usbd_audio_get(p_inst)->specific.inst;
+    uint32_t                rate_max = 0;
+
+    if ((alternate == 0) || (alternate > p_config->format_count))
+    {
+        return 0;
+    }
+
+    for (size_t i = 0; i < p_config->sample_rate_count; i++)
+    {
+        rate_max = MAX(rate_max, p_config->p_sample_rates[i]);
+    }
+
+    return (rate_max / 1000 + 1) * USB_AUDIO_CHANNELS * p_config->p_formats[alternate - 1].subframe_size;
+}
+
+ret_code_t usb_audio_sof_interrupt_register(app_usbd_class_inst_t const   *p_inst,
+                                            app_usbd_sof_interrupt_handler_t handler)
+{
+    VERIFY_PARAM_NOT_NULL(p_inst);
+
+    m_sof_handler = handler;
+
+    return NRF_SUCCESS;
+}
+
+size_t usb_audio_rx_size_get(app_usbd_class_inst_t const *p_inst)
+{
+    UNUSED_PARAMETER(p_inst);
+
+    return m_rx_size;
+}
+
+ret_code_t usb_audio_rx_start(app_usbd_class_inst_t const *p_inst, void *p_buf, size_t size)
+{
+    VERIFY_PARAM_NOT_NULL(p_buf);
+
+    if ((sim_usbd_ctx_get(p_inst)->alternate == 0) || (m_rx_size == 0))
+    {
+        return NRF_ERROR_INVALID_STATE;
+    }
+
+    if (mp_rx_buffer != NULL)
+    {
+        return NRF_ERROR_BUSY;
+    }
+
+    mp_rx_buffer  = p_buf;
+    m_rx_capacity = size;
+
+    return NRF_SUCCESS;
+}
+
+ret_code_t usb_audio_feedback_set(app_usbd_class_inst_t const *p_inst, uint32_t feedback)
+{
+    usb_audio_ctx_t *p_ctx = sim_usbd_ctx_get(p_inst);
+
+    if (p_ctx->alternate == 0)
+    {
+        return NRF_ERROR_INVALID_STATE;
+    }
+
+    if (m_feedback_queued)
+    {
+        return NRF_ERROR_BUSY;
+    }
+
+    UNUSED_RETURN_VALUE(uint24_encode(feedback, p_ctx->feedback));
+    m_feedback_queued = true;
+
+    return NRF_SUCCESS;
+}
+
+void sim_usbd_connect(void)
+{
+    m_ev_state_proc(APP_USBD_EVT_POWER_DETECTED);
+    m_ev_state_proc(APP_USBD_EVT_POWER_READY);
+
+    m_state = APP_USBD_STATE_Configured; // Enumeration is not simulated
+}
+
+ret_code_t sim_usbd_alternate_set(uint8_t alternate)
+{
+    usb_audio_ctx_t *p_ctx = sim_usbd_ctx_get(mp_inst);
+
+    if (alternate > sim_usbd_audio_get(mp_inst)->specific.inst.format_count)
+    {
+        return NRF_ERROR_INVALID_PARAM;
+    }
+
+    p_ctx->alternate  = alternate;
+    m_feedback_queued = false;
+    sim_usbd_user_event(USB_AUDIO_USER_EVT_ALT_SET);
+
+    return NRF_SUCCESS;
+}
+
+void sim_usbd_sample_rate_set(uint32_t sample_rate)
+{
+    usb_audio_req_t *p_req = &sim_usbd_ctx_get(mp_inst)->request;
+
+    memset(p_req, 0, sizeof(*p_req));
+
+    p_req->req_target = USB_AUDIO_EP_REQ_OUT;
+    p_req->req_type   = USB_AUDIO_REQ_SET_CUR;
+    p_req->control    = USB_AUDIO_EP_CONTROL_SAMPLING_FREQ;
+    p_req->entity     = NRF_DRV_USBD_EPOUT8;
+    p_req->length     = 3;
+
+    uint24_encode(sample_rate, p_req->payload);
+    sim_usbd_user_event(USB_AUDIO_USER_EVT_CLASS_REQ);
+}
+
+void sim_usbd_frame(void const *p_packet, size_t size)
+{
+    m_rx_size    = (sim_usbd_ctx_get(mp_inst)->alternate != 0) ? size : 0;
+    mp_rx_buffer = NULL;
+
+    if (m_sof_handler != NULL)
+    {
+        m_sof_handler(m_frame_cnt);
+    }
+
+    m_frame_cnt = (m_frame_cnt + 1) & 0x7FF; // 11 bit frame number
+
+    if (mp_rx_buffer != NULL)
+    {
+        memcpy(mp_rx_buffer, p_packet, MIN(m_rx_size, m_rx_capacity));
+        mp_rx_buffer = NULL;
+        sim_usbd_user_event(USB_AUDIO_USER_EVT_RX_DONE);
+    } else if (m_rx_size > 0)
+    {
+        m_packets_missed++;
+    }
+
+    m_rx_size = 0;
+}
+
+bool sim_usbd_feedback_read(uint32_t *p_feedback)
+{
+    if (!m_feedback_queued)
+    {
+        return false;
+    }
+
+    *p_feedback       = uint24_decode(sim_usbd_ctx_get(mp_inst)->feedback);
+    m_feedback_queued = false;
+
+    return true;
+}
+
+uint32_t sim_usbd_packets_missed_get(void) { return m_packets_missed; }
@@ -0,0 +1,27 @@
+/**
+ * @file        SEGGER_RTT.h
+ * @author      Danius Kalvaitis (danius.kalvaitis@gmail.com)
+ * @brief       Host simulation stand-in for SEGGER RTT. Written bytes are counted and dropped.
+ * @version     0.1
+ * @date        2026-10-17
+ *
+ * @copyright   Copyright (c) Danius Kalvaitis 2026 All rights reserved
+ *
+ */
+
+#ifndef SEGGER_RTT_H
+#define SEGGER_RTT_H
+
+#include "sdk_common.h"
+
+#define SEGGER_RTT_MAX_NUM_UP_BUFFERS SEGGER_RTT_CONFIG_MAX_NUM_UP_BUFFERS
+#define SEGGER_RTT_MODE_NO_BLOCK_SKIP 0
+
+int SEGGER_RTT_ConfigUpBuffer(unsigned buffer_index, char const *s_name, void *p_buffer, unsigned size, unsigned flags);
+
+/**
+ * @return Bytes written, all of them or none in skip mode.
+ */
+unsigned SEGGER_RTT_Write(unsigned buffer_index, void const *p_buffer, unsigned num_bytes);
+
+#endif // SEGGER_RTT_H
@@ -0,0 +1,40 @@
+/**
+ * @file        app_error.h
+ * @author      Danius Kalvaitis (danius.kalvaitis@gmail.com)
+ * @brief       Host simulation stand-in for the SDK error handler. Errors and failed asserts abort the simulation.
+ * @version     0.1
+ * @date        2026-10-17
+ *
+ * @copyright   Copyright (c) Danius Kalvaitis 2026 All rights reserved
+ *
+ */
+
+#ifndef APP_ERROR_H
+#define APP_ERROR_H
+
+#include <stdint.h>
+
+#include "sdk_errors.h"
+
+void app_error_handler(ret_code_t error_code, uint32_t line_num, char const *p_file_name);
+
+#define APP_ERROR_CHECK(err_code)                                                                                      \
+    do                                                                                                                 \
+    {                                                                                                                  \
+        ret_code_t const local_err_code = (err_code);                                                                  \
+        if (local_err_code != NRF_SUCCESS)                                                                             \
+        {                                                                                                              \
+            app_error_handler(local_err_code, __LINE__, __FILE__);                                                     \
+        }                                                                                                              \
+    } while (0)
+
+#define ASSERT(expr)                                                                                                   \
+    do                                                                                                                 \
+    {                                                                                                                  \
+        if (!(expr))                                                                                                   \
+        {                                                                                                              \
+            app_error_handler(NRF_ERROR_INTERNAL, __LINE__, __FILE__);                                                 \
+        }                                                                                                              \
+    } while (0)
+
+#endif // APP_ERROR_H
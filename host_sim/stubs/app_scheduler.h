@@ -0,0 +1,25 @@
+/**
+ * @file        app_scheduler.h
+ * @author      Danius Kalvaitis (danius.kalvaitis@gmail.com)
+ * @brief       Host simulation stand-in for the SDK scheduler.
+ * @version     0.1
+ * @date        2026-10-17
+ *
+ * @copyright   Copyright (c) Danius Kalvaitis 2026 All rights reserved
+ *
+ */
+
+#ifndef APP_SCHEDULER_H
+#define APP_SCHEDULER_H
+
+#include <stdint.h>
+
+#include "sdk_errors.h"
+
+typedef void (*app_sched_event_handler_t)(void *p_event_data, uint16_t event_size);
+
+ret_code_t app_sched_event_put(void const *p_event_data, uint16_t event_size, app_sched_event_handler_t handler);
+
+void app_sched_execute(void);
+
+#endif // APP_SCHEDULER_H
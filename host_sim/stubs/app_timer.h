@@ -0,0 +1,62 @@
+/**
+ * @file        app_timer.h
+ * @author      Danius Kalvaitis (danius.kalvaitis@gmail.com)
+ * @brief       Host simulation stand-in for app_timer. Time only moves when the simulation calls
+ *              sim_timer_advance().
+ * @version     0.1
+ * @date        2026-10-17
+ *
+ * @copyright   Copyright (c) Danius Kalvaitis 2026 All rights reserved
+ *
+ */
+
+#ifndef APP_TIMER_H
+#define APP_TIMER_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "sdk_common.h"
+
+#define APP_TIMER_CLOCK_FREQ 32768
+
+#define APP_TIMER_TICKS(ms)                                                                                            \
+    ((uint32_t)ROUNDED_DIV((ms) * (uint64_t)APP_TIMER_CLOCK_FREQ, 1000 * (APP_TIMER_CONFIG_RTC_FREQUENCY + 1)))
+
+typedef void (*app_timer_timeout_handler_t)(void *p_context);
+
+typedef enum
+{
+    APP_TIMER_MODE_SINGLE_SHOT,
+    APP_TIMER_MODE_REPEATED
+} app_timer_mode_t;
+
+typedef struct
+{
+    app_timer_timeout_handler_t handler;
+    app_timer_mode_t            mode;
+    void                       *p_context;
+    uint32_t                    expiry;   /**< Simulation tick the timer fires at. */
+    uint32_t                    interval; /**< Reload of repeated timers. */
+    bool                        active;
+} app_timer_t;
+
+typedef app_timer_t *app_timer_id_t;
+
+#define APP_TIMER_DEF(timer_id)                                                                                        \
+    static app_timer_t          timer_id##_data;                                                                       \
+    static app_timer_id_t const timer_id = &timer_id##_data
+
+ret_code_t app_timer_create(app_timer_id_t const      *p_timer_id,
+                            app_timer_mode_t            mode,
+                            app_timer_timeout_handler_t timeout_handler);
+
+ret_code_t app_timer_start(app_timer_id_t timer_id, uint32_t timeout_ticks, void *p_context);
+
+ret_code_t app_timer_stop(app_timer_id_t timer_id);
+
+uint32_t app_timer_cnt_get(void);
+
+uint32_t app_timer_cnt_diff_compute(uint32_t ticks_to, uint32_t ticks_from);
+
+#endif // APP_TIMER_H
@@ -0,0 +1,59 @@
+/**
+ * @file        app_usbd.h
+ * @author      Danius Kalvaitis (danius.kalvaitis@gmail.com)
+ * @brief       Host simulation stand-in for app_usbd. Connection and bus events are driven by the simulation.
+ * @version     0.1
+ * @date        2026-10-17
+ *
+ * @copyright   Copyright (c) Danius Kalvaitis 2026 All rights reserved
+ *
+ */
+
+#ifndef APP_USBD_H
+#define APP_USBD_H
+
+#include <stdbool.h>
+
+#include "app_usbd_class_base.h"
+#include "app_usbd_core.h"
+#include "sdk_errors.h"
+
+typedef enum
+{
+    APP_USBD_EVT_DRV_SOF,
+    APP_USBD_EVT_DRV_RESET,
+    APP_USBD_EVT_DRV_SUSPEND,
+    APP_USBD_EVT_DRV_RESUME,
+    APP_USBD_EVT_DRV_WUREQ,
+    APP_USBD_EVT_DRV_SETUP,
+    APP_USBD_EVT_DRV_EPTRANSFER,
+    APP_USBD_EVT_POWER_DETECTED,
+    APP_USBD_EVT_POWER_REMOVED,
+    APP_USBD_EVT_POWER_READY,
+    APP_USBD_EVT_STARTED,
+    APP_USBD_EVT_STOPPED
+} app_usbd_event_type_t;
+
+typedef void (*app_usbd_ev_state_proc_t)(app_usbd_event_type_t event);
+
+typedef struct
+{
+    app_usbd_ev_state_proc_t ev_state_proc;
+    bool                     enable_sof;
+} app_usbd_config_t;
+
+ret_code_t app_usbd_init(app_usbd_config_t const *p_config);
+
+ret_code_t app_usbd_class_append(app_usbd_class_inst_t const *p_cinst);
+
+ret_code_t app_usbd_power_events_enable(void);
+
+void app_usbd_enable(void);
+
+void app_usbd_disable(void);
+
+void app_usbd_start(void);
+
+void app_usbd_stop(void);
+
+#endif // APP_USBD_H
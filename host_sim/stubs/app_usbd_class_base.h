@@ -0,0 +1,57 @@
+/**
+ * @file        app_usbd_class_base.h
+ * @author      Danius Kalvaitis (danius.kalvaitis@gmail.com)
+ * @brief       Host simulation stand-in for the app_usbd class base. Keeps the instance layout the application
+ *              touches: a base followed by the class specific instance and data parts.
+ * @version     0.1
+ * @date        2026-10-17
+ *
+ * @copyright   Copyright (c) Danius Kalvaitis 2026 All rights reserved
+ *
+ */
+
+#ifndef APP_USBD_CLASS_BASE_H
+#define APP_USBD_CLASS_BASE_H
+
+#include <stdint.h>
+
+#include "sdk_errors.h"
+
+typedef struct
+{
+    uint8_t unused;
+} app_usbd_class_methods_t;
+
+typedef struct
+{
+    app_usbd_class_methods_t const *p_class_methods;
+} app_usbd_class_inst_t;
+
+typedef void (*app_usbd_sof_interrupt_handler_t)(uint16_t framecnt);
+
+#define APP_USBD_SIM_EXPAND(...)          __VA_ARGS__
+
+#define APP_USBD_CLASS_FORWARD(type_name) typedef struct type_name##_s type_name##_t
+
+#define APP_USBD_CLASS_TYPEDEF(type_name, interfaces_configs, instance_specific_dec, data_specific_dec)                \
+    typedef struct                                                                                                     \
+    {                                                                                                                  \
+        data_specific_dec                                                                                              \
+    } type_name##_data_t;                                                                                              \
+    struct type_name##_s                                                                                               \
+    {                                                                                                                  \
+        app_usbd_class_inst_t base;                                                                                    \
+        struct                                                                                                         \
+        {                                                                                                              \
+            type_name##_data_t *p_data;                                                                                \
+            instance_specific_dec                                                                                      \
+        } specific;                                                                                                    \
+    }
+
+#define APP_USBD_CLASS_INST_GLOBAL_DEF(instance_name, type_name, class_methods, interfaces_configs, config_part)       \
+    static type_name##_data_t  instance_name##_data;                                                                   \
+    static type_name##_t const instance_name = {                                                                       \
+      .base     = {.p_class_methods = (class_methods)},                                                                \
+      .specific = {.p_data = &instance_name##_data, APP_USBD_SIM_EXPAND config_part}}
+
+#endif // APP_USBD_CLASS_BASE_H
@@ -0,0 +1,27 @@
+/**
+ * @file        app_usbd_core.h
+ * @author      Danius Kalvaitis (danius.kalvaitis@gmail.com)
+ * @brief       Host simulation stand-in for the app_usbd core.
+ * @version     0.1
+ * @date        2026-10-17
+ *
+ * @copyright   Copyright (c) Danius Kalvaitis 2026 All rights reserved
+ *
+ */
+
+#ifndef APP_USBD_CORE_H
+#define APP_USBD_CORE_H
+
+typedef enum
+{
+    APP_USBD_STATE_Disabled,
+    APP_USBD_STATE_Unattached,
+    APP_USBD_STATE_Powered,
+    APP_USBD_STATE_Default,
+    APP_USBD_STATE_Addressed,
+    APP_USBD_STATE_Configured
+} app_usbd_state_t;
+
+app_usbd_state_t app_usbd_core_state_get(void);
+
+#endif // APP_USBD_CORE_H
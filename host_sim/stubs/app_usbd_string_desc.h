@@ -0,0 +1,15 @@
+/**
+ * @file        app_usbd_string_desc.h
+ * @author      Danius Kalvaitis (danius.kalvaitis@gmail.com)
+ * @brief       Host simulation stand-in for the app_usbd string descriptors. Descriptors are not simulated.
+ * @version     0.1
+ * @date        2026-10-17
+ *
+ * @copyright   Copyright (c) Danius Kalvaitis 2026 All rights reserved
+ *
+ */
+
+#ifndef APP_USBD_STRING_DESC_H
+#define APP_USBD_STRING_DESC_H
+
+#endif // APP_USBD_STRING_DESC_H
@@ -0,0 +1,62 @@
+/**
+ * @file        app_util.h
+ * @author      Danius Kalvaitis (danius.kalvaitis@gmail.com)
+ * @brief       Host simulation stand-in for the SDK utility macros used by the application.
+ * @version     0.1
+ * @date        2026-10-17
+ *
+ * @copyright   Copyright (c) Danius Kalvaitis 2026 All rights reserved
+ *
+ */
+
+#ifndef APP_UTIL_H
+#define APP_UTIL_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#define STATIC_ASSERT(expr, msg) _Static_assert(expr, msg)
+
+#define ARRAY_SIZE(arr)          (sizeof(arr) / sizeof((arr)[0]))
+#define MIN(a, b)                ((a) < (b) ? (a) : (b))
+#define MAX(a, b)                ((a) < (b) ? (b) : (a))
+#define IS_POWER_OF_TWO(a)       (((a) != 0) && ((((a) - 1) & (a)) == 0))
+#define ROUNDED_DIV(a, b)        (((a) + ((b) / 2)) / (b))
+#define CEIL_DIV(a, b)           ((((a) - 1) / (b)) + 1)
+
+#define UNUSED_VARIABLE(x)       ((void)(x))
+#define UNUSED_PARAMETER(x)      ((void)(x))
+#define UNUSED_RETURN_VALUE(x)   ((void)(x))
+
+#define LSB_16(a)                ((uint8_t)((a) & 0x00FF))
+#define MSB_16(a)                ((uint8_t)(((a) & 0xFF00) >> 8))
+
+static inline uint8_t uint16_encode(uint16_t value, uint8_t *p_encoded_data)
+{
+    p_encoded_data[0] = (uint8_t)value;
+    p_encoded_data[1] = (uint8_t)(value >> 8);
+
+    return sizeof(uint16_t);
+}
+
+static inline uint8_t uint24_encode(uint32_t value, uint8_t *p_encoded_data)
+{
+    p_encoded_data[0] = (uint8_t)value;
+    p_encoded_data[1] = (uint8_t)(value >> 8);
+    p_encoded_data[2] = (uint8_t)(value >> 16);
+
+    return 3;
+}
+
+static inline uint16_t uint16_decode(uint8_t const *p_encoded_data)
+{
+    return (uint16_t)(p_encoded_data[0] | ((uint16_t)p_encoded_data[1] << 8));
+}
+
+static inline uint32_t uint24_decode(uint8_t const *p_encoded_data)
+{
+    return p_encoded_data[0] | ((uint32_t)p_encoded_data[1] << 8) | ((uint32_t)p_encoded_data[2] << 16);
+}
+
+#endif // APP_UTIL_H
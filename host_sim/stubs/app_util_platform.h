@@ -0,0 +1,22 @@
+/**
+ * @file        app_util_platform.h
+ * @author      Danius Kalvaitis (danius.kalvaitis@gmail.com)
+ * @brief       Host simulation stand-in for the SDK platform utilities. The simulation runs on a single thread, so
+ *              critical regions only keep their block structure.
+ * @version     0.1
+ * @date        2026-10-17
+ *
+ * @copyright   Copyright (c) Danius Kalvaitis 2026 All rights reserved
+ *
+ */
+
+#ifndef APP_UTIL_PLATFORM_H
+#define APP_UTIL_PLATFORM_H
+
+#include "nrf.h"
+#include "sdk_common.h"
+
+#define CRITICAL_REGION_ENTER() {
+#define CRITICAL_REGION_EXIT()  }
+
+#endif // APP_UTIL_PLATFORM_H
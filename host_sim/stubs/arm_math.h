@@ -0,0 +1,43 @@
+/**
+ * @file        arm_math.h
+ * @author      Danius Kalvaitis (danius.kalvaitis@gmail.com)
+ * @brief       Host simulation stand-in for the CMSIS DSP functions used by the equalizer.
+ * @version     0.1
+ * @date        2026-10-17
+ *
+ * @copyright   Copyright (c) Danius Kalvaitis 2026 All rights reserved
+ *
+ */
+
+#ifndef ARM_MATH_H
+#define ARM_MATH_H
+
+#include <stdint.h>
+
+#include "nrf.h"
+
+#define PI 3.14159265358979f
+
+typedef int32_t q31_t;
+typedef int64_t q63_t;
+
+/**
+ * @brief Direct form I biquad cascade, Q31 data and coefficients.
+ */
+typedef struct
+{
+    uint32_t     numStages;
+    q31_t       *pState;  /**< 4 values per stage: x[n-1], x[n-2], y[n-1], y[n-2]. */
+    q31_t const *pCoeffs; /**< 5 values per stage: b0, b1, b2, a1, a2. Feedback coefficients are negated. */
+    uint8_t      postShift;
+} arm_biquad_casd_df1_inst_q31;
+
+void arm_biquad_cascade_df1_init_q31(arm_biquad_casd_df1_inst_q31 *S,
+                                     uint8_t                       numStages,
+                                     q31_t const                  *pCoeffs,
+                                     q31_t                        *pState,
+                                     int8_t                        postShift);
+
+void arm_biquad_cascade_df1_q31(arm_biquad_casd_df1_inst_q31 const *S, q31_t *pSrc, q31_t *pDst, uint32_t blockSize);
+
+#endif // ARM_MATH_H
@@ -0,0 +1,30 @@
+/**
+ * @file        boards.h
+ * @author      Danius Kalvaitis (danius.kalvaitis@gmail.com)
+ * @brief       Host simulation stand-in for the board definitions. Pin numbers only index the simulated GPIO port.
+ * @version     0.1
+ * @date        2026-10-17
+ *
+ * @copyright   Copyright (c) Danius Kalvaitis 2026 All rights reserved
+ *
+ */
+
+#ifndef BOARDS_H
+#define BOARDS_H
+
+#define DK_BSP_I2S_MCLK           0
+#define DK_BSP_I2S_BCLK           1
+#define DK_BSP_I2S_WCLK           2
+#define DK_BSP_I2S_DOUT           3
+#define DK_BSP_I2S_DIN            4
+
+#define DK_BSP_TPA3220_RST        8
+#define DK_BSP_TPA3220_MUTE       9
+#define DK_BSP_TPA3220_FAULT      10
+#define DK_BSP_TPA3220_OTW_CLIP   11
+#define DK_BSP_TPA3220_HEAD       12
+
+#define DK_BSP_TLV320_RST         13
+#define DK_BSP_TLV320_I2C_ADDRESS 0x18
+
+#endif // BOARDS_H
@@ -0,0 +1,65 @@
+/**
+ * @file        dk_twi_mngr.h
+ * @author      Danius Kalvaitis (danius.kalvaitis@gmail.com)
+ * @brief       Host simulation stand-in for the TWI transaction manager. Scheduled transactions are held by sim_twi.c
+ *              until the simulation completes them.
+ * @version     0.1
+ * @date        2026-10-17
+ *
+ * @copyright   Copyright (c) Danius Kalvaitis 2026 All rights reserved
+ *
+ */
+
+#ifndef DK_TWI_MNGR_H
+#define DK_TWI_MNGR_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include "sdk_errors.h"
+
+#define DK_TWI_MNGR_NO_STOP 0x01 /**< Next transfer follows with a repeated start. */
+
+#define DK_TWI_MNGR_READ_OP(address)  (((address) << 1) | 1)
+#define DK_TWI_MNGR_WRITE_OP(address) ((address) << 1)
+#define DK_TWI_MNGR_IS_READ_OP(op)    ((op) & 1)
+
+#define DK_TWI_MNGR_TRANSFER(_operation, _p_data, _length, _flags)                                                     \
+    {                                                                                                                  \
+        .p_data = (uint8_t *)(_p_data), .length = (_length), .operation = (_operation), .flags = (_flags)              \
+    }
+
+#define DK_TWI_MNGR_WRITE(address, p_data, length, flags)                                                              \
+    DK_TWI_MNGR_TRANSFER(DK_TWI_MNGR_WRITE_OP(address), p_data, length, flags)
+
+#define DK_TWI_MNGR_READ(address, p_data, length, flags)                                                               \
+    DK_TWI_MNGR_TRANSFER(DK_TWI_MNGR_READ_OP(address), p_data, length, flags)
+
+typedef struct
+{
+    uint8_t instance;
+} dk_twi_mngr_t;
+
+typedef void (*dk_twi_mngr_callback_t)(ret_code_t result, void *p_user_data);
+
+typedef struct
+{
+    uint8_t *p_data;
+    uint8_t  length;
+    uint8_t  operation;
+    uint8_t  flags;
+} dk_twi_mngr_transfer_t;
+
+typedef struct
+{
+    dk_twi_mngr_callback_t        callback;
+    void                         *p_user_data;
+    dk_twi_mngr_transfer_t const *p_transfers;
+    uint8_t                       number_of_transfers;
+    void const                   *p_required_twi_cfg;
+} dk_twi_mngr_transaction_t;
+
+ret_code_t dk_twi_mngr_schedule(dk_twi_mngr_t const *p_dk_twi_mngr, dk_twi_mngr_transaction_t const *p_transaction);
+
+#endif // DK_TWI_MNGR_H
@@ -0,0 +1,65 @@
+/**
+ * @file        nrf.h
+ * @author      Danius Kalvaitis (danius.kalvaitis@gmail.com)
+ * @brief       Host simulation stand-in for the device header. Provides the CMSIS intrinsics used by the audio path,
+ *              with the same results as the Cortex-M4 instructions.
+ * @version     0.1
+ * @date        2026-10-17
+ *
+ * @copyright   Copyright (c) Danius Kalvaitis 2026 All rights reserved
+ *
+ */
+
+#ifndef NRF_H
+#define NRF_H
+
+#include <stdint.h>
+#include <string.h>
+
+#define __DMB() __atomic_thread_fence(__ATOMIC_SEQ_CST)
+#define __DSB() __atomic_thread_fence(__ATOMIC_SEQ_CST)
+#define __ISB() __atomic_thread_fence(__ATOMIC_SEQ_CST)
+
+#define __PKHBT(arg1, arg2, arg3)                                                                                      \
+    ((((uint32_t)(arg1)) & 0x0000FFFFUL) | ((((uint32_t)(arg2)) << (arg3)) & 0xFFFF0000UL))
+#define __PKHTB(arg1, arg2, arg3)                                                                                      \
+    ((((uint32_t)(arg1)) & 0xFFFF0000UL) | ((((uint32_t)(arg2)) >> (arg3)) & 0x0000FFFFUL))
+
+static inline uint32_t __ROR(uint32_t op1, uint32_t op2)
+{
+    op2 %= 32U;
+
+    if (op2 == 0U)
+    {
+        return op1;
+    }
+
+    return (op1 >> op2) | (op1 << (32U - op2));
+}
+
+static inline int32_t __SSAT(int32_t val, uint32_t sat)
+{
+    int32_t max = (int32_t)((1U << (sat - 1U)) - 1U);
+    int32_t min = -1 - max;
+
+    if (val > max)
+    {
+        return max;
+    } else if (val < min)
+    {
+        return min;
+    }
+
+    return val;
+}
+
+static inline uint32_t __UNALIGNED_UINT32_READ(void const *p_addr)
+{
+    uint32_t value;
+
+    memcpy(&value, p_addr, sizeof(value));
+
+    return value;
+}
+
+#endif // NRF_H
@@ -0,0 +1,19 @@
+/**
+ * @file        nrf_drv_clock.h
+ * @author      Danius Kalvaitis (danius.kalvaitis@gmail.com)
+ * @brief       Host simulation stand-in for the legacy clock driver header.
+ * @version     0.1
+ * @date        2026-10-17
+ *
+ * @copyright   Copyright (c) Danius Kalvaitis 2026 All rights reserved
+ *
+ */
+
+#ifndef NRF_DRV_CLOCK_H
+#define NRF_DRV_CLOCK_H
+
+#include "sdk_errors.h"
+
+ret_code_t nrf_drv_clock_init(void);
+
+#endif // NRF_DRV_CLOCK_H
@@ -0,0 +1,28 @@
+/**
+ * @file        nrf_drv_usbd.h
+ * @author      Danius Kalvaitis (danius.kalvaitis@gmail.com)
+ * @brief       Host simulation stand-in for the legacy USBD driver header.
+ * @version     0.1
+ * @date        2026-10-17
+ *
+ * @copyright   Copyright (c) Danius Kalvaitis 2026 All rights reserved
+ *
+ */
+
+#ifndef NRF_DRV_USBD_H
+#define NRF_DRV_USBD_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+typedef enum
+{
+    NRF_DRV_USBD_EPOUT0 = 0x00,
+    NRF_DRV_USBD_EPOUT8 = 0x08,
+    NRF_DRV_USBD_EPIN0  = 0x80,
+    NRF_DRV_USBD_EPIN8  = 0x88
+} nrf_drv_usbd_ep_t;
+
+bool nrf_drv_usbd_is_enabled(void);
+
+#endif // NRF_DRV_USBD_H
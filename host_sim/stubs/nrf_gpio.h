@@ -0,0 +1,70 @@
+/**
+ * @file        nrf_gpio.h
+ * @author      Danius Kalvaitis (danius.kalvaitis@gmail.com)
+ * @brief       Host simulation stand-in for the GPIO HAL. Pins are driven and read on a simulated port, see sim.h.
+ * @version     0.1
+ * @date        2026-10-17
+ *
+ * @copyright   Copyright (c) Danius Kalvaitis 2026 All rights reserved
+ *
+ */
+
+#ifndef NRF_GPIO_H
+#define NRF_GPIO_H
+
+#include <stdint.h>
+
+typedef enum
+{
+    NRF_GPIO_PIN_DIR_INPUT,
+    NRF_GPIO_PIN_DIR_OUTPUT
+} nrf_gpio_pin_dir_t;
+
+typedef enum
+{
+    NRF_GPIO_PIN_INPUT_CONNECT,
+    NRF_GPIO_PIN_INPUT_DISCONNECT
+} nrf_gpio_pin_input_t;
+
+typedef enum
+{
+    NRF_GPIO_PIN_NOPULL,
+    NRF_GPIO_PIN_PULLDOWN,
+    NRF_GPIO_PIN_PULLUP = 3
+} nrf_gpio_pin_pull_t;
+
+typedef enum
+{
+    NRF_GPIO_PIN_S0S1,
+    NRF_GPIO_PIN_H0S1,
+    NRF_GPIO_PIN_S0H1,
+    NRF_GPIO_PIN_H0H1,
+    NRF_GPIO_PIN_D0S1,
+    NRF_GPIO_PIN_D0H1,
+    NRF_GPIO_PIN_S0D1,
+    NRF_GPIO_PIN_H0D1
+} nrf_gpio_pin_drive_t;
+
+typedef enum
+{
+    NRF_GPIO_PIN_NOSENSE,
+    NRF_GPIO_PIN_SENSE_HIGH = 2,
+    NRF_GPIO_PIN_SENSE_LOW
+} nrf_gpio_pin_sense_t;
+
+void nrf_gpio_cfg(uint32_t             pin_number,
+                  nrf_gpio_pin_dir_t   dir,
+                  nrf_gpio_pin_input_t input,
+                  nrf_gpio_pin_pull_t  pull,
+                  nrf_gpio_pin_drive_t drive,
+                  nrf_gpio_pin_sense_t sense);
+
+void nrf_gpio_cfg_output(uint32_t pin_number);
+
+void nrf_gpio_pin_set(uint32_t pin_number);
+
+void nrf_gpio_pin_clear(uint32_t pin_number);
+
+uint32_t nrf_gpio_pin_read(uint32_t pin_number);
+
+#endif // NRF_GPIO_H
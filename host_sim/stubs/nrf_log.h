@@ -0,0 +1,25 @@
+/**
+ * @file        nrf_log.h
+ * @author      Danius Kalvaitis (danius.kalvaitis@gmail.com)
+ * @brief       Host simulation stand-in for the SDK logger. Logs are compiled out, the simulation reports through its
+ *              own statistics.
+ * @version     0.1
+ * @date        2026-10-17
+ *
+ * @copyright   Copyright (c) Danius Kalvaitis 2026 All rights reserved
+ *
+ */
+
+#ifndef NRF_LOG_H
+#define NRF_LOG_H
+
+#define NRF_LOG_MODULE_REGISTER()            extern int nrf_log_module_unused
+
+#define NRF_LOG_ERROR(...)                   ((void)0)
+#define NRF_LOG_WARNING(...)                 ((void)0)
+#define NRF_LOG_INFO(...)                    ((void)0)
+#define NRF_LOG_DEBUG(...)                   ((void)0)
+#define NRF_LOG_HEXDUMP_INFO(p_data, length) ((void)(p_data), (void)(length))
+#define NRF_LOG_FLUSH()                      ((void)0)
+
+#endif // NRF_LOG_H
@@ -0,0 +1,22 @@
+/**
+ * @file        nrf_section.h
+ * @author      Danius Kalvaitis (danius.kalvaitis@gmail.com)
+ * @brief       Host simulation stand-in for the SDK named sections. The host linker script does not place application
+ *              sections, so a section reads as empty.
+ * @version     0.1
+ * @date        2026-10-17
+ *
+ * @copyright   Copyright (c) Danius Kalvaitis 2026 All rights reserved
+ *
+ */
+
+#ifndef NRF_SECTION_H
+#define NRF_SECTION_H
+
+#include <stddef.h>
+
+#define NRF_SECTION_DEF(section_name, data_type) extern int nrf_section_unused_##section_name
+#define NRF_SECTION_START_ADDR(section_name)     ((void const *)NULL)
+#define NRF_SECTION_LENGTH(section_name)         ((size_t)0)
+
+#endif // NRF_SECTION_H
@@ -0,0 +1,61 @@
+/**
+ * @file        nrfx_gpiote.h
+ * @author      Danius Kalvaitis (danius.kalvaitis@gmail.com)
+ * @brief       Host simulation stand-in for the nrfx GPIOTE driver, input events only. Events are raised by
+ *              sim_gpio_input_set().
+ * @version     0.1
+ * @date        2026-10-17
+ *
+ * @copyright   Copyright (c) Danius Kalvaitis 2026 All rights reserved
+ *
+ */
+
+#ifndef NRFX_GPIOTE_H
+#define NRFX_GPIOTE_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "nrf_gpio.h"
+
+#define NRFX_GPIOTE_CONFIG_IN_SENSE_LOTOHI(hi_accu)                                                                    \
+    {                                                                                                                  \
+        .sense = NRF_GPIOTE_POLARITY_LOTOHI, .pull = NRF_GPIO_PIN_NOPULL, .hi_accuracy = (hi_accu)                     \
+    }
+
+#define NRFX_GPIOTE_CONFIG_IN_SENSE_HITOLO(hi_accu)                                                                    \
+    {                                                                                                                  \
+        .sense = NRF_GPIOTE_POLARITY_HITOLO, .pull = NRF_GPIO_PIN_NOPULL, .hi_accuracy = (hi_accu)                     \
+    }
+
+#define NRFX_GPIOTE_CONFIG_IN_SENSE_TOGGLE(hi_accu)                                                                    \
+    {                                                                                                                  \
+        .sense = NRF_GPIOTE_POLARITY_TOGGLE, .pull = NRF_GPIO_PIN_NOPULL, .hi_accuracy = (hi_accu)                     \
+    }
+
+typedef uint32_t nrfx_err_t;
+typedef uint32_t nrfx_gpiote_pin_t;
+
+typedef enum
+{
+    NRF_GPIOTE_POLARITY_LOTOHI = 1,
+    NRF_GPIOTE_POLARITY_HITOLO,
+    NRF_GPIOTE_POLARITY_TOGGLE
+} nrf_gpiote_polarity_t;
+
+typedef struct
+{
+    nrf_gpiote_polarity_t sense;
+    nrf_gpio_pin_pull_t   pull;
+    bool                  hi_accuracy;
+} nrfx_gpiote_in_config_t;
+
+typedef void (*nrfx_gpiote_evt_handler_t)(nrfx_gpiote_pin_t pin, nrf_gpiote_polarity_t action);
+
+nrfx_err_t nrfx_gpiote_in_init(nrfx_gpiote_pin_t              pin,
+                               nrfx_gpiote_in_config_t const *p_config,
+                               nrfx_gpiote_evt_handler_t      evt_handler);
+
+void nrfx_gpiote_in_event_enable(nrfx_gpiote_pin_t pin, bool int_enable);
+
+#endif // NRFX_GPIOTE_H
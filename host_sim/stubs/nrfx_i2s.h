@@ -0,0 +1,58 @@
+/**
+ * @file        nrfx_i2s.h
+ * @author      Danius Kalvaitis (danius.kalvaitis@gmail.com)
+ * @brief       Host simulation stand-in for the nrfx I2S driver. The driver is clocked by sim_i2s_frames().
+ * @version     0.1
+ * @date        2026-10-17
+ *
+ * @copyright   Copyright (c) Danius Kalvaitis 2026 All rights reserved
+ *
+ */
+
+#ifndef NRFX_I2S_H
+#define NRFX_I2S_H
+
+#include <stdint.h>
+
+#include "sdk_common.h"
+
+#define NRFX_I2S_STATUS_NEXT_BUFFERS_NEEDED (1UL << 0)
+
+#define NRF_I2S_MCK_32MDIV2                 0x80000000UL
+#define NRF_I2S_MCK_32MDIV3                 0x50000000UL
+
+#define NRFX_I2S_DEFAULT_CONFIG                                                                                        \
+    {                                                                                                                  \
+        .sck_pin = 0, .lrck_pin = 0, .mck_pin = 0, .sdout_pin = 0, .sdin_pin = 0,                                      \
+        .irq_priority = NRFX_I2S_CONFIG_IRQ_PRIORITY                                                                   \
+    }
+
+typedef uint32_t nrfx_err_t;
+
+typedef struct
+{
+    uint8_t sck_pin;
+    uint8_t lrck_pin;
+    uint8_t mck_pin;
+    uint8_t sdout_pin;
+    uint8_t sdin_pin;
+    uint8_t irq_priority;
+} nrfx_i2s_config_t;
+
+typedef struct
+{
+    uint32_t       *p_rx_buffer;
+    uint32_t const *p_tx_buffer;
+} nrfx_i2s_buffers_t;
+
+typedef void (*nrfx_i2s_data_handler_t)(nrfx_i2s_buffers_t const *p_released, uint32_t status);
+
+nrfx_err_t nrfx_i2s_init(nrfx_i2s_config_t const *p_config, nrfx_i2s_data_handler_t handler);
+
+nrfx_err_t nrfx_i2s_start(nrfx_i2s_buffers_t const *p_initial_buffers, uint16_t buffer_size, uint8_t flags);
+
+nrfx_err_t nrfx_i2s_next_buffers_set(nrfx_i2s_buffers_t const *p_buffers);
+
+void nrfx_i2s_stop(void);
+
+#endif // NRFX_I2S_H
@@ -0,0 +1,61 @@
+/**
+ * @file        sdk_common.h
+ * @author      Danius Kalvaitis (danius.kalvaitis@gmail.com)
+ * @brief       Host simulation stand-in for the SDK common header. Configuration comes from the real sdk_config.h.
+ * @version     0.1
+ * @date        2026-10-17
+ *
+ * @copyright   Copyright (c) Danius Kalvaitis 2026 All rights reserved
+ *
+ */
+
+#ifndef SDK_COMMON_H
+#define SDK_COMMON_H
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <string.h>
+
+#include "app_error.h"
+#include "app_util.h"
+#include "sdk_config.h"
+#include "sdk_errors.h"
+
+#define VERIFY_SUCCESS(statement)                                                                                      \
+    do                                                                                                                 \
+    {                                                                                                                  \
+        ret_code_t const _err_code = (statement);                                                                      \
+        if (_err_code != NRF_SUCCESS)                                                                                  \
+        {                                                                                                              \
+            return _err_code;                                                                                          \
+        }                                                                                                              \
+    } while (0)
+
+#define VERIFY_SUCCESS_VOID(err_code)                                                                                  \
+    do                                                                                                                 \
+    {                                                                                                                  \
+        if ((err_code) != NRF_SUCCESS)                                                                                 \
+        {                                                                                                              \
+            return;                                                                                                    \
+        }                                                                                                              \
+    } while (0)
+
+#define VERIFY_PARAM_NOT_NULL(param)                                                                                   \
+    do                                                                                                                 \
+    {                                                                                                                  \
+        if ((param) == NULL)                                                                                           \
+        {                                                                                                              \
+            return NRF_ERROR_NULL;                                                                                     \
+        }                                                                                                              \
+    } while (0)
+
+#define VERIFY_PARAM_NOT_NULL_VOID(param)                                                                              \
+    do                                                                                                                 \
+    {                                                                                                                  \
+        if ((param) == NULL)                                                                                           \
+        {                                                                                                              \
+            return;                                                                                                    \
+        }                                                                                                              \
+    } while (0)
+
+#endif // SDK_COMMON_H
@@ -0,0 +1,38 @@
+/**
+ * @file        sdk_errors.h
+ * @author      Danius Kalvaitis (danius.kalvaitis@gmail.com)
+ * @brief       Host simulation stand-in for the SDK error codes.
+ * @version     0.1
+ * @date        2026-10-17
+ *
+ * @copyright   Copyright (c) Danius Kalvaitis 2026 All rights reserved
+ *
+ */
+
+#ifndef SDK_ERRORS_H
+#define SDK_ERRORS_H
+
+#include <stdint.h>
+
+typedef uint32_t ret_code_t;
+
+#define NRF_SUCCESS                      0
+#define NRF_ERROR_SVC_HANDLER_MISSING    1
+#define NRF_ERROR_SOFTDEVICE_NOT_ENABLED 2
+#define NRF_ERROR_INTERNAL               3
+#define NRF_ERROR_NO_MEM                 4
+#define NRF_ERROR_NOT_FOUND              5
+#define NRF_ERROR_NOT_SUPPORTED          6
+#define NRF_ERROR_INVALID_PARAM          7
+#define NRF_ERROR_INVALID_STATE          8
+#define NRF_ERROR_INVALID_LENGTH         9
+#define NRF_ERROR_INVALID_FLAGS          10
+#define NRF_ERROR_INVALID_DATA           11
+#define NRF_ERROR_DATA_SIZE              12
+#define NRF_ERROR_TIMEOUT                13
+#define NRF_ERROR_NULL                   14
+#define NRF_ERROR_FORBIDDEN              15
+#define NRF_ERROR_INVALID_ADDR           16
+#define NRF_ERROR_BUSY                   17
+
+#endif // SDK_ERRORS_H
@@ -0,0 +1,187 @@
+/**
+ * @file        tlv320aic3106.h
+ * @author      Danius Kalvaitis (danius.kalvaitis@gmail.com)
+ * @brief       Host simulation stand-in for the TLV320AIC3106 driver, implemented in sim_twi.c.
+ * @version     0.1
+ * @date        2026-10-17
+ *
+ * @copyright   Copyright (c) Danius Kalvaitis 2026 All rights reserved
+ *
+ * Configuration calls only return success, they put nothing on the simulated bus, so the bus carries the register
+ * traffic of codec_hal.c alone. The module power status is reported right away from the simulated register file.
+ */
+
+#ifndef TLV320AIC3106_H
+#define TLV320AIC3106_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "dk_twi_mngr.h"
+#include "sdk_common.h"
+
+#define TLV320AIC3106_DEF(instance_name, p_twi_mngr, address)                                                          \
+    static tlv320aic3106_t instance_name = {.p_dk_twi_mngr_instance = (p_twi_mngr), .i2c_address = (address)}
+
+typedef enum
+{
+    TLV320AIC3106_EVT_TYPE_ERROR,
+    TLV320AIC3106_EVT_TYPE_RX_MODULE_PWR_STATUS
+} tlv320aic3106_evt_type_t;
+
+typedef enum
+{
+    TLV320AIC3106_PLL_P_1 = 1
+} tlv320aic3106_pll_p_t;
+
+typedef enum
+{
+    TLV320AIC3106_CODEC_CLKIN_SRC_PLLDIV_OUT
+} tlv320aic3106_codec_clkin_src_t;
+
+typedef enum
+{
+    TLV320AIC3106_LEFT_DAC_DATAPATH_CTRL_LEFT_EN = 1
+} tlv320aic3106_left_dac_datapath_ctrl_t;
+
+typedef enum
+{
+    TLV320AIC3106_RIGHT_DAC_DATAPATH_CTRL_RIGHT_EN = 1
+} tlv320aic3106_right_dac_datapath_ctrl_t;
+
+typedef enum
+{
+    TLV320AIC3106_DAC_QUIESCENT_CURRENT_2_DAC_REF = 1
+} tlv320aic3106_dac_quiescent_current_t;
+
+typedef enum
+{
+    TLV320AIC3106_DAC_DIG_VOL_CTRL_LEFT_FOLLOWS_RIGHT_CHANNEL = 1
+} tlv320aic3106_dac_dig_vol_ctrl_t;
+
+typedef enum
+{
+    TLV320AIC3106_DAC_OUT_SWITCH_DAC_X1
+} tlv320aic3106_dac_out_switch_t;
+
+typedef struct
+{
+    dk_twi_mngr_t const *p_dk_twi_mngr_instance;
+    uint8_t              i2c_address;
+} tlv320aic3106_t;
+
+typedef struct
+{
+    bool left_dac_powered_up;
+    bool right_dac_powered_up;
+    bool left_lop_m_powered_up;
+    bool right_lop_m_powered_up;
+} tlv320aic3106_module_pwr_status_t;
+
+typedef struct
+{
+    tlv320aic3106_evt_type_t type;
+    union
+    {
+        ret_code_t                         err_code;
+        tlv320aic3106_module_pwr_status_t *p_module_pwr_status;
+    } params;
+} tlv320aic3106_evt_t;
+
+typedef void (*tlv320aic3106_evt_handler_t)(tlv320aic3106_evt_t *p_evt);
+
+typedef struct
+{
+    tlv320aic3106_pll_p_t p;
+    uint8_t               j;
+    uint16_t              d;
+    uint8_t               r;
+} tlv320aic3106_pll_config_t;
+
+typedef struct
+{
+    bool bclk_dir_output;
+    bool wclk_dir_output;
+} tlv320aic3106_audio_ser_data_interface_ctrl_a_t;
+
+typedef struct
+{
+    bool re_sync_dac;
+    bool re_sync_with_soft_mute;
+} tlv320aic3106_audio_ser_data_interface_ctrl_b_t;
+
+typedef struct
+{
+    tlv320aic3106_left_dac_datapath_ctrl_t  left_dac_datapath_ctrl;
+    tlv320aic3106_right_dac_datapath_ctrl_t right_dac_datapath_ctrl;
+} tlv320aic3106_datapath_setup_t;
+
+typedef struct
+{
+    tlv320aic3106_dac_quiescent_current_t dac_quiescent_current;
+} tlv320aic3106_dac_quiescent_current_adj_t;
+
+typedef struct
+{
+    tlv320aic3106_dac_dig_vol_ctrl_t dac_dig_vol_ctrl;
+    tlv320aic3106_dac_out_switch_t   left_dac_out_switch;
+    tlv320aic3106_dac_out_switch_t   right_dac_out_switch;
+} tlv320aic3106_dac_out_switch_ctrl_t;
+
+typedef struct
+{
+    bool dac_muted;
+} tlv320aic3106_dac_dig_volume_ctrl_t;
+
+typedef struct
+{
+    bool routed_to_y;
+} tlv320aic3106_x_to_y_volume_ctrl_t;
+
+typedef struct
+{
+    bool not_muted;
+    bool power_en;
+} tlv320aic3106_x_out_lvl_ctrl_t;
+
+ret_code_t tlv320aic3106_init(tlv320aic3106_t const *p_inst, tlv320aic3106_evt_handler_t evt_handler);
+
+ret_code_t tlv320aic3106_pll_init(tlv320aic3106_t const *p_inst, tlv320aic3106_pll_config_t const *p_config);
+
+ret_code_t tlv320aic3106_set_clkin_src(tlv320aic3106_t const *p_inst, tlv320aic3106_codec_clkin_src_t clkin_src);
+
+ret_code_t tlv320aic3106_set_audio_ser_data_interface_ctrl_a(
+  tlv320aic3106_t const *p_inst, tlv320aic3106_audio_ser_data_interface_ctrl_a_t const *p_ctrl);
+
+ret_code_t tlv320aic3106_set_audio_ser_data_interface_ctrl_b(
+  tlv320aic3106_t const *p_inst, tlv320aic3106_audio_ser_data_interface_ctrl_b_t const *p_ctrl);
+
+ret_code_t tlv320aic3106_set_datapath(tlv320aic3106_t const *p_inst, tlv320aic3106_datapath_setup_t const *p_setup);
+
+ret_code_t tlv320aic3106_set_dac_quiescent_current(tlv320aic3106_t const                           *p_inst,
+                                                   tlv320aic3106_dac_quiescent_current_adj_t const *p_adj);
+
+ret_code_t tlv320aic3106_set_dac_pwr(tlv320aic3106_t const *p_inst, bool left_dac_pwr_on, bool right_dac_pwr_on);
+
+ret_code_t tlv320aic3106_set_dac_out_switch_ctrl(tlv320aic3106_t const                     *p_inst,
+                                                 tlv320aic3106_dac_out_switch_ctrl_t const *p_ctrl);
+
+ret_code_t tlv320aic3106_set_dac_dig_volume_ctrl(tlv320aic3106_t const                     *p_inst,
+                                                 tlv320aic3106_dac_dig_volume_ctrl_t const *p_ctrl);
+
+ret_code_t tlv320aic3106_set_dac_x1_to_lop(tlv320aic3106_t const                    *p_inst,
+                                           tlv320aic3106_x_to_y_volume_ctrl_t const *p_ctrl);
+
+ret_code_t tlv320aic3106_set_lop_m_out_lvl_ctrl(tlv320aic3106_t const                *p_inst,
+                                                tlv320aic3106_x_out_lvl_ctrl_t const *p_ctrl);
+
+ret_code_t tlv320aic3106_set_line1_bypass(tlv320aic3106_t const *p_inst, bool bypass);
+
+/**
+ * @brief Reports TLV320AIC3106_EVT_TYPE_RX_MODULE_PWR_STATUS from the DAC power and LOP level registers.
+ */
+ret_code_t tlv320aic3106_get_module_power_status(tlv320aic3106_t const *p_inst);
+
+void tlv320aic3106_debug(tlv320aic3106_t const *p_inst);
+
+#endif // TLV320AIC3106_H
@@ -0,0 +1,56 @@
+/**
+ * @file        test.h
+ * @author      Danius Kalvaitis (danius.kalvaitis@gmail.com)
+ * @brief       Minimal assertions for the host unit tests.
+ * @version     0.1
+ * @date        2026-10-17
+ *
+ * @copyright   Copyright (c) Danius Kalvaitis 2026 All rights reserved
+ *
+ * Every test program is a single source file. Failed checks are printed and counted, TEST_RUN runs a test function
+ * and TEST_EXIT_CODE gives the exit status of the program.
+ */
+
+#ifndef TEST_H
+#define TEST_H
+
+#include <stdio.h>
+
+static unsigned m_test_checks;
+static unsigned m_test_failures;
+
+#define TEST_CHECK(expr)                                                                                               \
+    do                                                                                                                 \
+    {                                                                                                                  \
+        m_test_checks++;                                                                                               \
+        if (!(expr))                                                                                                   \
+        {                                                                                                              \
+            m_test_failures++;                                                                                         \
+            printf("%s:%d: check failed: %s\n", __FILE__, __LINE__, #expr);                                            \
+        }                                                                                                              \
+    } while (0)
+
+#define TEST_CHECK_EQUAL(expected, actual)                                                                             \
+    do                                                                                                                 \
+    {                                                                                                                  \
+        long long const test_expected = (long long)(expected);                                                         \
+        long long const test_actual   = (long long)(actual);                                                           \
+        m_test_checks++;                                                                                               \
+        if (test_expected != test_actual)                                                                              \
+        {                                                                                                              \
+            m_test_failures++;                                                                                         \
+            printf("%s:%d: %s is %lld, expected %lld\n", __FILE__, __LINE__, #actual, test_actual, test_expected);     \
+        }                                                                                                              \
+    } while (0)
+
+#define TEST_RUN(test)                                                                                                 \
+    do                                                                                                                 \
+    {                                                                                                                  \
+        unsigned const test_failures = m_test_failures;                                                                \
+        test();                                                                                                        \
+        printf("%-48s %s\n", #test, (m_test_failures == test_failures) ? "ok" : "FAILED");                             \
+    } while (0)
+
+#define TEST_EXIT_CODE() ((m_test_failures == 0) ? 0 : 1)
+
+#endif // TEST_H
@@ -0,0 +1,209 @@
+/**
+ * @file        test_amp.c
+ * @author      Danius Kalvaitis (danius.kalvaitis@gmail.com)
+ * @brief       Host unit tests of the amplifier fault supervisor.
+ * @version     0.1
+ * @date        2026-10-17
+ *
+ * @copyright   Copyright (c) Danius Kalvaitis 2026 All rights reserved
+ *
+ * FAULT and OTW/CLIP are driven on the simulated GPIO port, the supervisor runs from app_timer and the scheduler as on
+ * target. A latched fault is modelled the way the TPA3220 clears it: FAULT goes back high while RESET is held low.
+ */
+
+#include <string.h>
+
+#include "amp.h"
+#include "app_scheduler.h"
+#include "app_timer.h"
+#include "boards.h"
+#include "sim.h"
+#include "test.h"
+
+#define TEST_RESET_ATTEMPTS 6 /**< First reset and every retry. */
+
+static uint32_t m_events[AMP_EVT_TYPE_RECOVERY_FAILED + 1];
+static uint32_t m_recovery_ms;
+static bool     m_clipping;
+
+static void test_evt_handler(amp_evt_t const *p_evt)
+{
+    m_events[p_evt->type]++;
+
+    if (p_evt->type == AMP_EVT_TYPE_RECOVERED)
+    {
+        m_recovery_ms = p_evt->params.recovery_ms;
+    } else if (p_evt->type == AMP_EVT_TYPE_CLIP)
+    {
+        m_clipping = p_evt->params.clipping;
+    }
+}
+
+static void test_run_ms(uint32_t ms)
+{
+    for (uint32_t i = 0; i < ms; i++)
+    {
+        sim_timer_advance(APP_TIMER_TICKS(1));
+        app_sched_execute();
+    }
+}
+
+/**
+ * @brief Fresh amplifier, running and unmuted, with FAULT and OTW/CLIP released.
+ */
+static void test_setup(void)
+{
+    sim_gpio_input_set(DK_BSP_TPA3220_FAULT, true);
+    sim_gpio_input_set(DK_BSP_TPA3220_OTW_CLIP, true);
+    app_sched_execute();
+
+    memset(m_events, 0, sizeof(m_events));
+    m_recovery_ms = 0;
+    m_clipping    = false;
+
+    TEST_CHECK_EQUAL(NRF_SUCCESS, amp_init(test_evt_handler));
+    amp_mute(false);
+}
+
+/**
+ * @brief FAULT latches low, the supervisor handles it from the scheduler.
+ */
+static void test_fault_raise(void)
+{
+    sim_gpio_input_set(DK_BSP_TPA3220_FAULT, false);
+    app_sched_execute();
+}
+
+static void test_init(void)
+{
+    test_setup();
+
+    TEST_CHECK(sim_gpio_output_get(DK_BSP_TPA3220_RST));
+    TEST_CHECK(sim_gpio_output_get(DK_BSP_TPA3220_MUTE)); // Unmuted, MUTE is active low
+    TEST_CHECK(!sim_gpio_output_get(DK_BSP_TPA3220_HEAD));
+
+    amp_mute(true);
+    TEST_CHECK(!sim_gpio_output_get(DK_BSP_TPA3220_MUTE));
+}
+
+static void test_fault_recovery(void)
+{
+    uint32_t resets;
+
+    test_setup();
+    resets = sim_gpio_falling_edges_get(DK_BSP_TPA3220_RST);
+
+    test_fault_raise();
+
+    TEST_CHECK_EQUAL(1, m_events[AMP_EVT_TYPE_FAULT]);
+    TEST_CHECK(!sim_gpio_output_get(DK_BSP_TPA3220_RST));
+    TEST_CHECK(!sim_gpio_output_get(DK_BSP_TPA3220_MUTE));
+
+    sim_gpio_input_set(DK_BSP_TPA3220_FAULT, true); // Cleared by the reset pulse
+
+    test_run_ms(1);
+    TEST_CHECK(sim_gpio_output_get(DK_BSP_TPA3220_RST));
+
+    // Started once FAULT has stayed high for 5 polls 10 ms apart
+    test_run_ms(45);
+    TEST_CHECK_EQUAL(0, m_events[AMP_EVT_TYPE_RECOVERED]);
+    TEST_CHECK(!sim_gpio_output_get(DK_BSP_TPA3220_MUTE));
+
+    test_run_ms(10);
+    TEST_CHECK_EQUAL(1, m_events[AMP_EVT_TYPE_RECOVERED]);
+    TEST_CHECK(m_recovery_ms >= 50 && m_recovery_ms <= 56);
+    TEST_CHECK(sim_gpio_output_get(DK_BSP_TPA3220_MUTE)); // Back to the requested state
+    TEST_CHECK_EQUAL(resets + 1, sim_gpio_falling_edges_get(DK_BSP_TPA3220_RST));
+}
+
+/**
+ * @brief A fault that stays latched is retried, then the amplifier is kept in reset and muted.
+ */
+static void test_fault_persists(void)
+{
+    uint32_t resets;
+
+    test_setup();
+    resets = sim_gpio_falling_edges_get(DK_BSP_TPA3220_RST);
+
+    test_fault_raise();
+    amp_mute(false); // Ignored until the amplifier runs again
+
+    test_run_ms(5000);
+
+    TEST_CHECK_EQUAL(1, m_events[AMP_EVT_TYPE_FAULT]);
+    TEST_CHECK_EQUAL(0, m_events[AMP_EVT_TYPE_RECOVERED]);
+    TEST_CHECK_EQUAL(1, m_events[AMP_EVT_TYPE_RECOVERY_FAILED]);
+    TEST_CHECK_EQUAL(resets + TEST_RESET_ATTEMPTS + 1, sim_gpio_falling_edges_get(DK_BSP_TPA3220_RST)); // And held
+    TEST_CHECK(!sim_gpio_output_get(DK_BSP_TPA3220_RST));
+    TEST_CHECK(!sim_gpio_output_get(DK_BSP_TPA3220_MUTE));
+}
+
+static void test_fault_clears_on_retry(void)
+{
+    uint32_t resets;
+
+    test_setup();
+    resets = sim_gpio_falling_edges_get(DK_BSP_TPA3220_RST);
+
+    test_fault_raise();
+    test_run_ms(300); // First start attempt gave up after 200 ms
+
+    sim_gpio_input_set(DK_BSP_TPA3220_FAULT, true);
+    test_run_ms(500);
+
+    TEST_CHECK_EQUAL(1, m_events[AMP_EVT_TYPE_RECOVERED]);
+    TEST_CHECK_EQUAL(0, m_events[AMP_EVT_TYPE_RECOVERY_FAILED]);
+    TEST_CHECK(m_recovery_ms > 700);
+    TEST_CHECK_EQUAL(resets + 2, sim_gpio_falling_edges_get(DK_BSP_TPA3220_RST));
+    TEST_CHECK(sim_gpio_output_get(DK_BSP_TPA3220_MUTE));
+}
+
+/**
+ * @brief FAULT dropping again while the amplifier starts restarts the stable count, it is not a new fault.
+ */
+static void test_fault_during_startup(void)
+{
+    test_setup();
+
+    test_fault_raise();
+    sim_gpio_input_set(DK_BSP_TPA3220_FAULT, true);
+    test_run_ms(30);
+
+    sim_gpio_input_set(DK_BSP_TPA3220_FAULT, false);
+    test_run_ms(10);
+    sim_gpio_input_set(DK_BSP_TPA3220_FAULT, true);
+
+    test_run_ms(35);
+    TEST_CHECK_EQUAL(0, m_events[AMP_EVT_TYPE_RECOVERED]);
+
+    test_run_ms(10);
+    TEST_CHECK_EQUAL(1, m_events[AMP_EVT_TYPE_FAULT]);
+    TEST_CHECK_EQUAL(1, m_events[AMP_EVT_TYPE_RECOVERED]);
+    TEST_CHECK(m_recovery_ms >= 75);
+}
+
+static void test_otw_clip(void)
+{
+    test_setup();
+
+    sim_gpio_input_set(DK_BSP_TPA3220_OTW_CLIP, false);
+    TEST_CHECK_EQUAL(1, m_events[AMP_EVT_TYPE_CLIP]);
+    TEST_CHECK(m_clipping);
+
+    sim_gpio_input_set(DK_BSP_TPA3220_OTW_CLIP, true);
+    TEST_CHECK_EQUAL(2, m_events[AMP_EVT_TYPE_CLIP]);
+    TEST_CHECK(!m_clipping);
+}
+
+int main(void)
+{
+    TEST_RUN(test_init);
+    TEST_RUN(test_fault_recovery);
+    TEST_RUN(test_fault_persists);
+    TEST_RUN(test_fault_clears_on_retry);
+    TEST_RUN(test_fault_during_startup);
+    TEST_RUN(test_otw_clip);
+
+    return TEST_EXIT_CODE();
+}
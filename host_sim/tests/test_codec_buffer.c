@@ -0,0 +1,428 @@
+/**
+ * @file        test_codec_buffer.c
+ * @author      Danius Kalvaitis (danius.kalvaitis@gmail.com)
+ * @brief       Host unit tests of the codec ring buffer.
+ * @version     0.1
+ * @date        2026-10-17
+ *
+ * @copyright   Copyright (c) Danius Kalvaitis 2026 All rights reserved
+ *
+ * The producer writes a running word count into every packet, so any block I2S gets must continue the count exactly
+ * where the previous one stopped, whatever the ring wrapped or folded in between.
+ */
+
+#include "codec_buffer.h"
+#include "codec_common.h"
+#include "sdk_common.h"
+#include "test.h"
+
+#define TEST_BLOCK_SIZE   (CODEC_BUFFER_SIZE_WORDS * sizeof(uint32_t))
+#define TEST_RING_SIZE    (8 * TEST_BLOCK_SIZE) /**< Queue and popped blocks of codec_buffer.c. */
+#define TEST_POPPED_SIZE  (2 * TEST_BLOCK_SIZE) /**< Blocks I2S may still read after taking the next one. */
+#define TEST_PACKET_SMALL 176                   /**< 44 frames. */
+#define TEST_PACKET_BIG   180                   /**< 45 frames. */
+
+static uint32_t m_rx_bytes; /**< Bytes released so far. */
+static uint32_t m_tx_word;  /**< Word expected at the start of the next TX block. */
+static uint32_t m_watermark_events;
+static uint32_t m_blocks_completed;
+static uint32_t m_blocks_broken; /**< Completed blocks that did not hold the running count. */
+static uint32_t m_folds;         /**< Packets that ran past the ring end. */
+
+static void test_event_handler(codec_buffer_event_type_t event_type)
+{
+    if (event_type == CODEC_BUFFER_EVENT_TYPE_LOW_WATERMARK_CROSSED_UP)
+    {
+        m_watermark_events++;
+    }
+}
+
+/**
+ * @brief Checks every block is complete, tail of a folded packet included, before it is handed on.
+ */
+static void test_block_handler(uint32_t *p_block, size_t words)
+{
+    uint32_t first = m_blocks_completed * CODEC_BUFFER_SIZE_WORDS;
+
+    for (size_t i = 0; i < words; i++)
+    {
+        if ((p_block[i] != first + i) && (p_block[i] != 0)) // Zeroes pad an unfinished block
+        {
+            m_blocks_broken++;
+            break;
+        }
+    }
+
+    m_blocks_completed++;
+}
+
+static void test_setup(void)
+{
+    TEST_CHECK_EQUAL(NRF_SUCCESS, codec_buffer_init(test_event_handler, test_block_handler));
+
+    m_rx_bytes         = 0;
+    m_tx_word          = 0;
+    m_watermark_events = 0;
+    m_blocks_completed = 0;
+    m_blocks_broken    = 0;
+    m_folds            = 0;
+}
+
+static void test_packet_fill(uint32_t *p_words, size_t size)
+{
+    uint32_t word = m_rx_bytes / sizeof(uint32_t);
+
+    for (size_t i = 0; i < size / sizeof(uint32_t); i++)
+    {
+        p_words[i] = word + i;
+    }
+}
+
+static void test_packet_release(size_t size)
+{
+    if ((m_rx_bytes % TEST_RING_SIZE) + size > TEST_RING_SIZE)
+    {
+        m_folds++;
+    }
+
+    TEST_CHECK_EQUAL(NRF_SUCCESS, codec_buffer_release_rx(size));
+    m_rx_bytes += size;
+}
+
+/**
+ * @return false if the ring had no room for the packet.
+ */
+static bool test_packet_write(size_t size)
+{
+    uint32_t *p_words = codec_buffer_get_rx(size);
+
+    if (p_words == NULL)
+    {
+        return false;
+    }
+
+    test_packet_fill(p_words, size);
+    test_packet_release(size);
+
+    return true;
+}
+
+/**
+ * @return false if no complete block was queued.
+ */
+static bool test_block_read(void)
+{
+    uint32_t const *p_block = codec_buffer_get_tx();
+    bool            intact  = true;
+
+    if (p_block == NULL)
+    {
+        return false;
+    }
+
+    for (size_t i = 0; i < CODEC_BUFFER_SIZE_WORDS; i++)
+    {
+        intact = intact && (p_block[i] == m_tx_word + i);
+    }
+
+    TEST_CHECK(intact);
+    m_tx_word += CODEC_BUFFER_SIZE_WORDS;
+
+    return true;
+}
+
+/**
+ * @brief Ten seconds of 44.1 kHz packets against an I2S consumer on the same clock.
+ */
+static void test_streaming(void)
+{
+    codec_buffer_stats_t stats;
+    uint32_t             i2s_frames = 0;
+    bool                 playing    = false;
+
+    test_setup();
+
+    for (uint32_t ms = 0; ms < 10000; ms++)
+    {
+        size_t size = (((ms + 1) * 441 / 10) - (ms * 441 / 10)) * sizeof(uint32_t);
+
+        TEST_CHECK(test_packet_write(size));
+
+        playing = playing || (m_watermark_events > 0);
+
+        if (!playing)
+        {
+            continue;
+        }
+
+        i2s_frames += 441;
+
+        while (i2s_frames >= CODEC_BUFFER_SIZE_WORDS * 10)
+        {
+            i2s_frames -= CODEC_BUFFER_SIZE_WORDS * 10;
+            TEST_CHECK(test_block_read());
+        }
+    }
+
+    codec_buffer_stats_get(&stats);
+
+    TEST_CHECK(m_watermark_events > 0); // Fires again whenever I2S takes the fill back under the watermark
+    TEST_CHECK(stats.max_queue_utilization <= CODEC_BUFFER_WATERMARK + 1);
+    TEST_CHECK_EQUAL(0, stats.underruns);
+    TEST_CHECK_EQUAL(0, stats.overruns);
+    TEST_CHECK_EQUAL(0, m_blocks_broken);
+    TEST_CHECK(m_folds > 50);
+    TEST_CHECK(stats.max_ring_utilization <= TEST_RING_SIZE);
+}
+
+/**
+ * @brief A transfer of the biggest size straddling the ring end is folded back to the ring start.
+ */
+static void test_slack_fold(void)
+{
+    uint32_t *p_words;
+    size_t    before_end;
+
+    test_setup();
+
+    // Move the write position close to the ring end, I2S keeps up so the ring never fills
+    while ((m_rx_bytes + TEST_PACKET_BIG) < TEST_RING_SIZE)
+    {
+        TEST_CHECK(test_packet_write(TEST_PACKET_BIG));
+
+        while (test_block_read())
+        {
+        }
+    }
+
+    before_end = TEST_RING_SIZE - m_rx_bytes;
+    p_words    = codec_buffer_get_rx(CODEC_BUFFER_RX_SIZE_MAX);
+
+    TEST_CHECK(p_words != NULL);
+    TEST_CHECK(before_end < CODEC_BUFFER_RX_SIZE_MAX);
+
+    test_packet_fill(p_words, CODEC_BUFFER_RX_SIZE_MAX);
+    test_packet_release(CODEC_BUFFER_RX_SIZE_MAX);
+
+    TEST_CHECK_EQUAL(1, m_folds);
+
+    // The block after the fold starts at the ring start and must hold the folded tail
+    while ((m_rx_bytes % TEST_BLOCK_SIZE) != 0)
+    {
+        TEST_CHECK(test_packet_write(MIN(TEST_PACKET_BIG, TEST_BLOCK_SIZE - (m_rx_bytes % TEST_BLOCK_SIZE))));
+    }
+
+    while (test_block_read())
+    {
+    }
+
+    TEST_CHECK_EQUAL(m_rx_bytes / sizeof(uint32_t), m_tx_word);
+    TEST_CHECK_EQUAL(0, m_blocks_broken);
+}
+
+/**
+ * @brief A full ring rejects transfers until I2S has let go of the oldest blocks.
+ */
+static void test_overrun(void)
+{
+    codec_buffer_stats_t stats;
+    uint32_t             packets = 0;
+
+    test_setup();
+
+    TEST_CHECK(codec_buffer_get_rx(CODEC_BUFFER_RX_SIZE_MAX + sizeof(uint32_t)) == NULL);
+
+    codec_buffer_stats_get(&stats);
+    TEST_CHECK_EQUAL(0, stats.overruns); // Too big is not an overrun
+
+    while (test_packet_write(TEST_PACKET_BIG))
+    {
+        packets++;
+    }
+
+    codec_buffer_stats_get(&stats);
+
+    TEST_CHECK_EQUAL(TEST_RING_SIZE / TEST_PACKET_BIG, packets);
+    TEST_CHECK_EQUAL(1, stats.overruns);
+    TEST_CHECK(stats.max_ring_utilization <= TEST_RING_SIZE);
+
+    // Blocks still owned by I2S are not freed by taking the next block
+    TEST_CHECK(test_block_read());
+    TEST_CHECK(test_block_read());
+    TEST_CHECK(!test_packet_write(TEST_PACKET_BIG));
+
+    TEST_CHECK(test_block_read());
+    TEST_CHECK(test_packet_write(TEST_PACKET_BIG));
+
+    codec_buffer_stats_get(&stats);
+    TEST_CHECK_EQUAL(2, stats.overruns);
+
+    while (test_block_read())
+    {
+    }
+
+    TEST_CHECK_EQUAL(0, m_blocks_broken);
+}
+
+/**
+ * @brief I2S stops and resets the ring while USB writes a packet into it.
+ */
+static void test_reset_during_rx(void)
+{
+    codec_buffer_stats_t stats;
+    uint32_t            *p_words;
+    uint32_t             unfinished_start;
+
+    test_setup();
+
+    while (m_rx_bytes < CODEC_BUFFER_WATERMARK * TEST_BLOCK_SIZE)
+    {
+        TEST_CHECK(test_packet_write(TEST_PACKET_BIG));
+    }
+
+    TEST_CHECK_EQUAL(1, m_watermark_events);
+    TEST_CHECK(test_block_read());
+
+    p_words = codec_buffer_get_rx(TEST_PACKET_BIG);
+    TEST_CHECK(p_words != NULL);
+
+    codec_buffer_reset();
+
+    codec_buffer_stats_get(&stats);
+    TEST_CHECK_EQUAL(0, stats.queue_utilization);
+    TEST_CHECK_EQUAL(m_rx_bytes % TEST_BLOCK_SIZE, codec_buffer_fill_get()); // Unfinished block stays
+
+    unfinished_start = (m_rx_bytes / TEST_BLOCK_SIZE) * CODEC_BUFFER_SIZE_WORDS;
+
+    test_packet_fill(p_words, TEST_PACKET_BIG);
+    test_packet_release(TEST_PACKET_BIG);
+
+    // Refilling after the reset crosses the watermark again
+    while (m_rx_bytes < (unfinished_start * sizeof(uint32_t)) + CODEC_BUFFER_WATERMARK * TEST_BLOCK_SIZE)
+    {
+        TEST_CHECK(test_packet_write(TEST_PACKET_BIG));
+    }
+
+    TEST_CHECK_EQUAL(2, m_watermark_events);
+
+    m_tx_word = unfinished_start; // Playback resumes with the block that was being written
+
+    for (uint32_t i = 0; i < CODEC_BUFFER_WATERMARK; i++)
+    {
+        TEST_CHECK(test_block_read());
+    }
+
+    TEST_CHECK_EQUAL(0, m_blocks_broken);
+}
+
+/**
+ * @brief A stopped stream pads the unfinished block with silence.
+ */
+static void test_release_unfinished(void)
+{
+    uint32_t const *p_block;
+    size_t          words;
+
+    test_setup();
+
+    TEST_CHECK(test_packet_write(TEST_PACKET_BIG));
+    TEST_CHECK(test_packet_write(TEST_PACKET_SMALL));
+
+    words = m_rx_bytes / sizeof(uint32_t);
+
+    TEST_CHECK_EQUAL(NRF_SUCCESS, codec_buffer_release_rx_unfinished());
+    TEST_CHECK_EQUAL(TEST_BLOCK_SIZE, codec_buffer_fill_get());
+    TEST_CHECK_EQUAL(1, m_blocks_completed);
+
+    p_block = codec_buffer_get_tx();
+    TEST_CHECK(p_block != NULL);
+
+    for (size_t i = 0; (p_block != NULL) && (i < CODEC_BUFFER_SIZE_WORDS); i++)
+    {
+        TEST_CHECK_EQUAL((i < words) ? i : 0, p_block[i]);
+    }
+
+    // Nothing to pad on a block boundary
+    TEST_CHECK_EQUAL(NRF_SUCCESS, codec_buffer_release_rx_unfinished());
+    TEST_CHECK_EQUAL(0, codec_buffer_fill_get());
+}
+
+static void test_cancel(void)
+{
+    void *p_first;
+
+    test_setup();
+
+    p_first = codec_buffer_get_rx(TEST_PACKET_BIG);
+    codec_buffer_cancel_rx();
+
+    TEST_CHECK(codec_buffer_get_rx(TEST_PACKET_BIG) == p_first);
+
+    // A shorter release hands the rest of the reservation back
+    TEST_CHECK_EQUAL(NRF_SUCCESS, codec_buffer_release_rx(TEST_PACKET_SMALL));
+    TEST_CHECK(codec_buffer_get_rx(TEST_PACKET_BIG) == (uint8_t *)p_first + TEST_PACKET_SMALL);
+}
+
+/**
+ * @brief Check a feedback value and its wire format, 10.14 samples per frame in 3 bytes, little endian.
+ *
+ * @param[in] expected Value in 10.14 format.
+ */
+static void test_feedback_check(uint32_t expected)
+{
+    uint32_t feedback = codec_buffer_feedback_get();
+    uint8_t  encoded[3];
+
+    TEST_CHECK_EQUAL(expected, feedback);
+    TEST_CHECK(feedback < (1UL << 24)); // 10 integer bits are enough up to 1023 samples per frame
+
+    TEST_CHECK_EQUAL(sizeof(encoded), uint24_encode(feedback, encoded));
+    TEST_CHECK_EQUAL(feedback, encoded[0] | (encoded[1] << 8) | ((uint32_t)encoded[2] << 16));
+}
+
+static void test_feedback_rate(uint32_t sample_rate, uint32_t nominal)
+{
+    test_setup();
+    codec_buffer_sample_rate_set(sample_rate);
+
+    while (m_rx_bytes < CODEC_BUFFER_FILL_TARGET_FRAMES * sizeof(uint32_t))
+    {
+        TEST_CHECK(test_packet_write(TEST_BLOCK_SIZE / 4)); // Lands on the target exactly
+    }
+
+    test_feedback_check(nominal);
+
+    TEST_CHECK(test_packet_write(10 * sizeof(uint32_t)));
+    TEST_CHECK(codec_buffer_feedback_get() < nominal); // Too full, ask for less
+
+    while (test_packet_write(TEST_PACKET_SMALL))
+    {
+    }
+
+    test_feedback_check(nominal - nominal / 200); // Clamped to 0.5 %
+
+    while (test_block_read())
+    {
+    }
+
+    test_feedback_check(nominal + nominal / 200);
+}
+
+static void test_feedback(void)
+{
+    test_feedback_rate(48000, 0x0C0000); // 48.0 samples per frame
+    test_feedback_rate(44100, 0x0B0666); // 44.1 rounded down to 1/16384
+}
+
+int main(void)
+{
+    TEST_RUN(test_streaming);
+    TEST_RUN(test_slack_fold);
+    TEST_RUN(test_overrun);
+    TEST_RUN(test_reset_during_rx);
+    TEST_RUN(test_release_unfinished);
+    TEST_RUN(test_cancel);
+    TEST_RUN(test_feedback);
+
+    return TEST_EXIT_CODE();
+}
@@ -0,0 +1,191 @@
+/**
+ * @file        test_codec_buffer_spsc.c
+ * @author      Danius Kalvaitis (danius.kalvaitis@gmail.com)
+ * @brief       Host stress test of the codec ring as a single producer, single consumer queue.
+ * @version     0.1
+ * @date        2026-10-17
+ *
+ * @copyright   Copyright (c) Danius Kalvaitis 2026 All rights reserved
+ *
+ * One thread plays USB and writes packets of varying size holding a running word count, another plays I2S and takes
+ * blocks as fast as it can. Neither side takes a lock, they only meet in the ring indexes like the two interrupts do on
+ * target. Every block taken must continue the count exactly, and its words must still hold it once the consumer has
+ * taken the blocks that follow, the ring keeps that many popped blocks away from the producer.
+ */
+
+#include <pthread.h>
+#include <sched.h>
+
+#include "codec_buffer.h"
+#include "sdk_common.h"
+#include "test.h"
+
+#define TEST_BLOCKS        200000 /**< Blocks the consumer takes per run, about 200 MB through the ring. */
+#define TEST_RUNS          5
+#define TEST_POPPED_BLOCKS 2      /**< Blocks I2S may still read after taking the next one. */
+#define TEST_PACKET_MIN    4
+#define TEST_YIELD_MASK    0x3F   /**< Each side yields now and then to shuffle the interleaving. */
+
+static uint32_t m_words_written; /**< Owned by the producer until it is joined. */
+static uint32_t m_packets;
+static uint32_t m_producer_stalls; /**< Packets that had to wait for the consumer. */
+static uint32_t m_consumer_stalls; /**< Blocks that had to wait for the producer. */
+static uint32_t m_blocks_broken;   /**< Blocks that did not continue the count when taken. */
+static uint32_t m_blocks_reused;   /**< Popped blocks overwritten while I2S could still read them. */
+
+static volatile bool m_consumer_done;
+
+static void test_event_handler(codec_buffer_event_type_t event_type) { UNUSED_PARAMETER(event_type); }
+
+static uint32_t test_random(uint32_t *p_state)
+{
+    *p_state = *p_state * 1664525UL + 1013904223UL;
+
+    return *p_state >> 16;
+}
+
+/**
+ * @brief USB side. Packet sizes cover the whole range, so transfers fold across the ring end at every offset.
+ */
+static void *test_producer(void *p_context)
+{
+    uint32_t rng  = (uint32_t)(uintptr_t)p_context;
+    uint32_t word = 0;
+
+    while (!m_consumer_done)
+    {
+        size_t    words = (TEST_PACKET_MIN + test_random(&rng) % (CODEC_BUFFER_RX_SIZE_MAX - TEST_PACKET_MIN + 1)) / 4;
+        uint32_t *p_words;
+
+        while ((p_words = codec_buffer_get_rx(words * sizeof(uint32_t))) == NULL)
+        {
+            m_producer_stalls++;
+
+            if (m_consumer_done)
+            {
+                return NULL;
+            }
+
+            sched_yield();
+        }
+
+        for (size_t i = 0; i < words; i++)
+        {
+            p_words[i] = word + i;
+        }
+
+        TEST_CHECK_EQUAL(NRF_SUCCESS, codec_buffer_release_rx(words * sizeof(uint32_t)));
+
+        word += words;
+        m_packets++;
+
+        if ((m_packets & TEST_YIELD_MASK) == 0)
+        {
+            sched_yield();
+        }
+    }
+
+    m_words_written = word;
+
+    return NULL;
+}
+
+static bool test_block_check(uint32_t const *p_block, uint32_t first)
+{
+    for (size_t i = 0; i < CODEC_BUFFER_SIZE_WORDS; i++)
+    {
+        if (p_block[i] != first + i)
+        {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+/**
+ * @brief I2S side. Checks each block when it is taken and again just before the ring may hand it back to USB.
+ */
+static void *test_consumer(void *p_context)
+{
+    uint32_t const *popped[TEST_POPPED_BLOCKS] = {NULL};
+
+    UNUSED_PARAMETER(p_context);
+
+    for (uint32_t block = 0; block < TEST_BLOCKS; block++)
+    {
+        uint32_t const *p_block;
+        uint32_t const *p_oldest = popped[block % ARRAY_SIZE(popped)];
+
+        // Still protected until the next block is taken
+        if ((p_oldest != NULL) &&
+            !test_block_check(p_oldest, (block - ARRAY_SIZE(popped)) * CODEC_BUFFER_SIZE_WORDS))
+        {
+            m_blocks_reused++;
+        }
+
+        while ((p_block = codec_buffer_get_tx()) == NULL)
+        {
+            m_consumer_stalls++;
+            sched_yield();
+        }
+
+        if (!test_block_check(p_block, block * CODEC_BUFFER_SIZE_WORDS))
+        {
+            m_blocks_broken++;
+        }
+
+        popped[block % ARRAY_SIZE(popped)] = p_block;
+
+        if ((block & TEST_YIELD_MASK) == 0)
+        {
+            sched_yield();
+        }
+    }
+
+    m_consumer_done = true;
+
+    return NULL;
+}
+
+static void test_run(uint32_t seed)
+{
+    pthread_t producer;
+    pthread_t consumer;
+
+    TEST_CHECK_EQUAL(NRF_SUCCESS, codec_buffer_init(test_event_handler, NULL));
+
+    m_words_written = 0;
+    m_packets       = 0;
+    m_blocks_broken = 0;
+    m_blocks_reused = 0;
+    m_consumer_done = false;
+
+    TEST_CHECK_EQUAL(0, pthread_create(&consumer, NULL, test_consumer, NULL));
+    TEST_CHECK_EQUAL(0, pthread_create(&producer, NULL, test_producer, (void *)(uintptr_t)seed));
+    TEST_CHECK_EQUAL(0, pthread_join(consumer, NULL));
+    TEST_CHECK_EQUAL(0, pthread_join(producer, NULL));
+
+    TEST_CHECK_EQUAL(0, m_blocks_broken);
+    TEST_CHECK_EQUAL(0, m_blocks_reused);
+    TEST_CHECK(m_words_written >= TEST_BLOCKS * CODEC_BUFFER_SIZE_WORDS);
+}
+
+static void test_stress(void)
+{
+    for (uint32_t run = 0; run < TEST_RUNS; run++)
+    {
+        test_run(run + 1);
+    }
+
+    // Both sides must have caught up with the other many times, or the indexes were never contended
+    TEST_CHECK(m_producer_stalls > TEST_RUNS);
+    TEST_CHECK(m_consumer_stalls > TEST_RUNS);
+}
+
+int main(void)
+{
+    TEST_RUN(test_stress);
+
+    return TEST_EXIT_CODE();
+}
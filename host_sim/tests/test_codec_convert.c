@@ -0,0 +1,155 @@
+/**
+ * @file        test_codec_convert.c
+ * @author      Danius Kalvaitis (danius.kalvaitis@gmail.com)
+ * @brief       Host unit tests of the sample format converters.
+ * @version     0.1
+ * @date        2026-10-17
+ *
+ * @copyright   Copyright (c) Danius Kalvaitis 2026 All rights reserved
+ *
+ */
+
+#include <string.h>
+
+#include "codec_convert.h"
+#include "test.h"
+
+#define TEST_FRAMES 5 /**< Odd, so the mono converter runs its single frame path too. */
+
+/**
+ * @brief Buffer big enough for the input and the output of any converter.
+ */
+typedef union
+{
+    uint32_t words[TEST_FRAMES * CODEC_CONVERT_FRAME_SIZE_MAX / sizeof(uint32_t) + 1];
+    uint16_t halves[TEST_FRAMES * CODEC_CONVERT_FRAME_SIZE_MAX / sizeof(uint16_t)];
+    uint8_t  bytes[TEST_FRAMES * CODEC_CONVERT_FRAME_SIZE_MAX];
+} test_buffer_t;
+
+static void test_s16_stereo(void)
+{
+    codec_convert_t const *p_convert = codec_convert_get(CODEC_FORMAT_S16_STEREO);
+
+    TEST_CHECK(p_convert != NULL);
+    TEST_CHECK(p_convert->handler == NULL);
+    TEST_CHECK_EQUAL(CODEC_CONVERT_FRAME_SIZE, p_convert->frame_size);
+}
+
+static void test_s16_stereo_swapped(void)
+{
+    codec_convert_t const *p_convert = codec_convert_get(CODEC_FORMAT_S16_STEREO_SWAPPED);
+    test_buffer_t          buffer;
+
+    TEST_CHECK_EQUAL(4, p_convert->frame_size);
+
+    for (uint32_t i = 0; i < TEST_FRAMES; i++)
+    {
+        buffer.words[i] = (i << 16) | (0x8000 + i);
+    }
+
+    p_convert->handler(buffer.words, TEST_FRAMES);
+
+    for (uint32_t i = 0; i < TEST_FRAMES; i++)
+    {
+        TEST_CHECK_EQUAL(((0x8000 + i) << 16) | i, buffer.words[i]);
+    }
+}
+
+static void test_s16_mono_frames(size_t frames)
+{
+    codec_convert_t const *p_convert = codec_convert_get(CODEC_FORMAT_S16_MONO);
+    test_buffer_t          buffer;
+
+    TEST_CHECK_EQUAL(2, p_convert->frame_size);
+
+    memset(&buffer, 0xAA, sizeof(buffer));
+
+    for (uint32_t i = 0; i < frames; i++)
+    {
+        buffer.halves[i] = 0x8000 + i;
+    }
+
+    p_convert->handler(buffer.words, frames);
+
+    for (uint32_t i = 0; i < frames; i++)
+    {
+        TEST_CHECK_EQUAL(((0x8000 + i) << 16) | (0x8000 + i), buffer.words[i]);
+    }
+
+    TEST_CHECK_EQUAL(0xAAAAAAAA, buffer.words[frames]); // Nothing written past the output
+}
+
+static void test_s16_mono(void)
+{
+    test_s16_mono_frames(TEST_FRAMES);
+    test_s16_mono_frames(TEST_FRAMES - 1);
+    test_s16_mono_frames(1);
+}
+
+/**
+ * @brief 3 byte samples keep their upper 16 bits, little endian, left first.
+ */
+static void test_s24_stereo(void)
+{
+    codec_convert_t const *p_convert = codec_convert_get(CODEC_FORMAT_S24_STEREO);
+    test_buffer_t          buffer;
+
+    TEST_CHECK_EQUAL(6, p_convert->frame_size);
+
+    for (uint32_t i = 0; i < TEST_FRAMES; i++)
+    {
+        uint8_t *p_frame = &buffer.bytes[i * 6];
+
+        p_frame[0] = 0xFF; // Dropped low bytes
+        p_frame[1] = (uint8_t)i;
+        p_frame[2] = 0x12;
+        p_frame[3] = 0xFF;
+        p_frame[4] = 0x80 + i;
+        p_frame[5] = 0xAB;
+    }
+
+    p_convert->handler(buffer.words, TEST_FRAMES);
+
+    for (uint32_t i = 0; i < TEST_FRAMES; i++)
+    {
+        TEST_CHECK_EQUAL(((0xAB80U + i) << 16) | (0x1200 + i), buffer.words[i]);
+    }
+}
+
+/**
+ * @brief 4 byte samples keep their upper halves.
+ */
+static void test_s32_stereo(void)
+{
+    codec_convert_t const *p_convert = codec_convert_get(CODEC_FORMAT_S32_STEREO);
+    test_buffer_t          buffer;
+
+    TEST_CHECK_EQUAL(8, p_convert->frame_size);
+
+    for (uint32_t i = 0; i < TEST_FRAMES; i++)
+    {
+        buffer.words[2 * i]     = ((0x1200 + i) << 16) | 0xFFFF; // Dropped low halves
+        buffer.words[2 * i + 1] = ((0xAB80 + i) << 16) | 0x00FF;
+    }
+
+    p_convert->handler(buffer.words, TEST_FRAMES);
+
+    for (uint32_t i = 0; i < TEST_FRAMES; i++)
+    {
+        TEST_CHECK_EQUAL(((0xAB80U + i) << 16) | (0x1200 + i), buffer.words[i]);
+    }
+}
+
+static void test_unsupported(void) { TEST_CHECK(codec_convert_get(CODEC_FORMAT_COUNT) == NULL); }
+
+int main(void)
+{
+    TEST_RUN(test_s16_stereo);
+    TEST_RUN(test_s16_stereo_swapped);
+    TEST_RUN(test_s16_mono);
+    TEST_RUN(test_s24_stereo);
+    TEST_RUN(test_s32_stereo);
+    TEST_RUN(test_unsupported);
+
+    return TEST_EXIT_CODE();
+}
@@ -0,0 +1,189 @@
+/**
+ * @file        test_codec_hal.c
+ * @author      Danius Kalvaitis (danius.kalvaitis@gmail.com)
+ * @brief       Host unit tests of the codec register shadow and its burst flush.
+ * @version     0.1
+ * @date        2026-10-17
+ *
+ * @copyright   Copyright (c) Danius Kalvaitis 2026 All rights reserved
+ *
+ * codec_hal.c runs against the simulated TWI manager, which counts transactions and write bursts and keeps the
+ * register file they write. Transactions stay in flight until the test completes them.
+ */
+
+#include "app_scheduler.h"
+#include "app_timer.h"
+#include "codec_hal.h"
+#include "sim.h"
+#include "test.h"
+
+#define TEST_REG_PLL_PROG_A 3 /**< Followed by J, D MSB and D LSB. */
+#define TEST_REG_LEFT_VOL   43
+#define TEST_REG_RIGHT_VOL  44
+
+static dk_twi_mngr_t const m_twi_mngr = {.instance = 0};
+static uint32_t            m_events[CODEC_EVT_TYPE_AUDIO_STREAM_STOPPED + 1];
+
+static void test_evt_handler(codec_evt_type_t event_type) { m_events[event_type]++; }
+
+/**
+ * @brief Finish the transactions in flight and everything they lead to.
+ */
+static void test_twi_complete(void)
+{
+    while (sim_twi_pending_get() > 0)
+    {
+        sim_twi_complete();
+        app_sched_execute();
+    }
+}
+
+/**
+ * @return Transactions and bursts since @p p_from was taken.
+ */
+static sim_twi_stats_t test_twi_stats_since(sim_twi_stats_t const *p_from)
+{
+    sim_twi_stats_t stats;
+
+    sim_twi_stats_get(&stats);
+
+    stats.transactions -= p_from->transactions;
+    stats.bursts -= p_from->bursts;
+    stats.bytes -= p_from->bytes;
+
+    return stats;
+}
+
+/**
+ * @brief PLL J and D as written to the codec.
+ */
+static void test_pll_check(uint8_t j, uint16_t d)
+{
+    TEST_CHECK_EQUAL(j, sim_twi_reg_get(0, TEST_REG_PLL_PROG_A + 1) >> 2);
+    TEST_CHECK_EQUAL(d,
+                     (sim_twi_reg_get(0, TEST_REG_PLL_PROG_A + 2) << 6) |
+                       (sim_twi_reg_get(0, TEST_REG_PLL_PROG_A + 3) >> 2));
+}
+
+/**
+ * @brief Updates made before the register file is read are held in the shadow and flushed once it is.
+ */
+static void test_init(void)
+{
+    sim_twi_stats_t start;
+
+    sim_twi_stats_get(&start);
+
+    TEST_CHECK_EQUAL(NRF_SUCCESS, codec_hal_init(&m_twi_mngr, test_evt_handler));
+    TEST_CHECK_EQUAL(NRF_SUCCESS, codec_hal_volume_set(-256));
+    TEST_CHECK_EQUAL(0, test_twi_stats_since(&start).transactions);
+
+    // Out of reset, the register file is read in one transaction
+    sim_timer_advance(APP_TIMER_TICKS(100));
+    app_sched_execute();
+    TEST_CHECK_EQUAL(1, test_twi_stats_since(&start).transactions);
+    TEST_CHECK_EQUAL(0, m_events[CODEC_EVT_TYPE_READY]);
+
+    test_twi_complete();
+
+    TEST_CHECK_EQUAL(1, m_events[CODEC_EVT_TYPE_READY]);
+    TEST_CHECK_EQUAL(2, test_twi_stats_since(&start).transactions);
+    TEST_CHECK_EQUAL(1, test_twi_stats_since(&start).bursts); // Both volume registers
+    TEST_CHECK_EQUAL(2, sim_twi_reg_get(0, TEST_REG_LEFT_VOL));
+    TEST_CHECK_EQUAL(2, sim_twi_reg_get(0, TEST_REG_RIGHT_VOL));
+}
+
+/**
+ * @brief A rate switch is a single burst of the PLL registers that change, repeating a rate sends nothing.
+ */
+static void test_clock_switch(void)
+{
+    sim_twi_stats_t start;
+    sim_twi_stats_t stats;
+
+    TEST_CHECK_EQUAL(NRF_SUCCESS, codec_hal_clock_set(44100));
+    test_twi_complete();
+    test_pll_check(5, 6448); // 16 MHz MCK
+
+    sim_twi_stats_get(&start);
+
+    TEST_CHECK_EQUAL(NRF_SUCCESS, codec_hal_clock_set(48000));
+    test_twi_complete();
+
+    stats = test_twi_stats_since(&start);
+    TEST_CHECK_EQUAL(1, stats.transactions);
+    TEST_CHECK_EQUAL(1, stats.bursts);
+    TEST_CHECK_EQUAL(4, stats.bytes); // J, D MSB and D LSB after the register address, P and Q are unchanged
+    test_pll_check(6, 1440);
+
+    TEST_CHECK_EQUAL(NRF_SUCCESS, codec_hal_clock_set(44100));
+    test_twi_complete();
+
+    stats = test_twi_stats_since(&start);
+    TEST_CHECK_EQUAL(2, stats.transactions);
+    TEST_CHECK_EQUAL(2, stats.bursts);
+    test_pll_check(5, 6448);
+
+    TEST_CHECK_EQUAL(NRF_SUCCESS, codec_hal_clock_set(44100));
+    test_twi_complete();
+    TEST_CHECK_EQUAL(2, test_twi_stats_since(&start).transactions);
+
+    TEST_CHECK_EQUAL(NRF_ERROR_NOT_SUPPORTED, codec_hal_clock_set(32000));
+}
+
+/**
+ * @brief With both flush slots in flight, further updates collect in the shadow and go out as one flush.
+ */
+static void test_flush_slots(void)
+{
+    sim_twi_stats_t start;
+
+    sim_twi_stats_get(&start);
+
+    TEST_CHECK_EQUAL(NRF_SUCCESS, codec_hal_volume_set(-512));
+    TEST_CHECK_EQUAL(NRF_SUCCESS, codec_hal_mute(true));
+    TEST_CHECK_EQUAL(NRF_SUCCESS, codec_hal_volume_set(-768));
+    TEST_CHECK_EQUAL(NRF_SUCCESS, codec_hal_volume_set(-1024));
+    TEST_CHECK_EQUAL(NRF_SUCCESS, codec_hal_clock_set(48000));
+    TEST_CHECK_EQUAL(2, sim_twi_pending_get());
+
+    test_twi_complete();
+
+    TEST_CHECK_EQUAL(3, test_twi_stats_since(&start).transactions);
+    TEST_CHECK_EQUAL(8, sim_twi_reg_get(0, TEST_REG_LEFT_VOL)); // Last volume wins
+    TEST_CHECK_EQUAL(8, sim_twi_reg_get(0, TEST_REG_RIGHT_VOL));
+    test_pll_check(6, 1440);
+}
+
+/**
+ * @brief Switching to I2S powers the DACs and outputs in the flush, the power status poll then reports ready.
+ */
+static void test_mode_switch(void)
+{
+    TEST_CHECK_EQUAL(NRF_SUCCESS, codec_hal_mode_set(CODEC_MODE_I2S));
+    test_twi_complete();
+
+    sim_timer_advance(APP_TIMER_TICKS(2));
+    app_sched_execute();
+
+    TEST_CHECK_EQUAL(1, m_events[CODEC_EVT_TYPE_I2S_MODE_READY]);
+
+    TEST_CHECK_EQUAL(NRF_SUCCESS, codec_hal_mode_set(CODEC_MODE_BYPASS));
+    test_twi_complete();
+
+    sim_timer_advance(APP_TIMER_TICKS(2));
+    app_sched_execute();
+
+    TEST_CHECK_EQUAL(1, m_events[CODEC_EVT_TYPE_BYPASS_MODE_READY]);
+    TEST_CHECK_EQUAL(0, m_events[CODEC_EVT_TYPE_MODE_TIMEOUT]);
+}
+
+int main(void)
+{
+    TEST_RUN(test_init);
+    TEST_RUN(test_clock_switch);
+    TEST_RUN(test_flush_slots);
+    TEST_RUN(test_mode_switch);
+
+    return TEST_EXIT_CODE();
+}
@@ -0,0 +1,200 @@
+/**
+ * @file        test_codec_resampler.c
+ * @author      Danius Kalvaitis (danius.kalvaitis@gmail.com)
+ * @brief       Host unit tests of the drift compensating resampler.
+ * @version     0.1
+ * @date        2026-10-17
+ *
+ * @copyright   Copyright (c) Danius Kalvaitis 2026 All rights reserved
+ *
+ */
+
+#include <stdbool.h>
+
+#include "app_util.h"
+#include "codec_resampler.h"
+#include "test.h"
+
+#define TEST_FRAMES        44          /**< One 44.1 kHz packet. */
+#define TEST_BLOCKS        2000        /**< Two seconds of packets. */
+#define TEST_TARGET_FRAMES 2048        /**< Fill level the rate controller holds. */
+#define TEST_DELAY_FRAMES  2           /**< Frames the interpolator lags behind at unity step. */
+#define TEST_DC_FRAME      0xFC1803E8U /**< Left 1000, right -1000. */
+
+static uint32_t test_frame(uint32_t index)
+{
+    uint16_t left  = (uint16_t)index;
+    uint16_t right = (uint16_t)(0 - index);
+
+    return left | ((uint32_t)right << 16);
+}
+
+/**
+ * @return Frames written, the block must be accepted.
+ */
+static size_t test_process(uint32_t const *p_in, size_t in_frames, uint32_t *p_out, size_t out_frames_max)
+{
+    size_t out_frames = 0;
+
+    TEST_CHECK_EQUAL(NRF_SUCCESS, codec_resampler_process(p_in, in_frames, p_out, out_frames_max, &out_frames));
+
+    return out_frames;
+}
+
+/**
+ * @brief Without rate correction the output is the input, delayed by the interpolator history.
+ */
+static void test_unity_step(void)
+{
+    uint32_t in[TEST_FRAMES];
+    uint32_t out[TEST_FRAMES + 1];
+    bool     exact = true;
+
+    codec_resampler_reset();
+
+    for (uint32_t block = 0; block < 10; block++)
+    {
+        size_t out_frames;
+
+        for (size_t i = 0; i < TEST_FRAMES; i++)
+        {
+            in[i] = test_frame(1 + block * TEST_FRAMES + i); // Frame 0 would look like the zeroed history
+        }
+
+        out_frames = test_process(in, TEST_FRAMES, out, ARRAY_SIZE(out));
+        TEST_CHECK_EQUAL(TEST_FRAMES, out_frames);
+
+        for (size_t i = 0; i < out_frames; i++)
+        {
+            uint32_t delayed = block * TEST_FRAMES + i;
+
+            exact = exact && (out[i] == ((delayed < TEST_DELAY_FRAMES) ? 0 : test_frame(delayed - 1)));
+        }
+    }
+
+    TEST_CHECK(exact);
+}
+
+/**
+ * @return Output frames of TEST_BLOCKS packets with the fill level held at @p fill_frames.
+ */
+static uint32_t test_frames_out(size_t fill_frames)
+{
+    uint32_t in[TEST_FRAMES] = {0};
+    uint32_t out[TEST_FRAMES + 1];
+    uint32_t frames = 0;
+
+    codec_resampler_reset();
+
+    for (uint32_t block = 0; block < TEST_BLOCKS; block++)
+    {
+        codec_resampler_fill_update(fill_frames, TEST_TARGET_FRAMES);
+        frames += test_process(in, TEST_FRAMES, out, ARRAY_SIZE(out));
+    }
+
+    return frames;
+}
+
+/**
+ * @brief A fill level off target changes the frame count, never by more than 0.5 %.
+ */
+static void test_rate_control(void)
+{
+    uint32_t in_frames = TEST_BLOCKS * TEST_FRAMES;
+    uint32_t limit     = in_frames / 200 + 1;
+    uint32_t full      = test_frames_out(TEST_TARGET_FRAMES + 400);
+    uint32_t empty     = test_frames_out(TEST_TARGET_FRAMES - 400);
+
+    TEST_CHECK_EQUAL(in_frames, test_frames_out(TEST_TARGET_FRAMES));
+
+    TEST_CHECK(full < in_frames);
+    TEST_CHECK(full >= in_frames - limit);
+
+    TEST_CHECK(empty > in_frames);
+    TEST_CHECK(empty <= in_frames + limit);
+}
+
+/**
+ * @brief Constant input stays constant at any fractional position.
+ */
+static void test_dc(void)
+{
+    uint32_t in[TEST_FRAMES];
+    uint32_t out[TEST_FRAMES + 1];
+    bool     exact = true;
+
+    codec_resampler_reset();
+
+    for (size_t i = 0; i < TEST_FRAMES; i++)
+    {
+        in[i] = TEST_DC_FRAME;
+    }
+
+    for (uint32_t block = 0; block < 100; block++)
+    {
+        size_t out_frames;
+
+        codec_resampler_fill_update(TEST_TARGET_FRAMES + 300, TEST_TARGET_FRAMES);
+        out_frames = test_process(in, TEST_FRAMES, out, ARRAY_SIZE(out));
+
+        // The first frames are interpolated against the zeroed history
+        for (size_t i = (block == 0) ? TEST_DELAY_FRAMES + 1 : 0; i < out_frames; i++)
+        {
+            exact = exact && (out[i] == TEST_DC_FRAME);
+        }
+    }
+
+    TEST_CHECK(exact);
+}
+
+static void test_out_frames_max(void)
+{
+    uint32_t in[TEST_FRAMES] = {0};
+    uint32_t out[TEST_FRAMES + 1];
+
+    codec_resampler_reset();
+
+    TEST_CHECK_EQUAL(10, test_process(in, TEST_FRAMES, out, 10));
+
+    // The input left over is skipped, the next block starts in full
+    TEST_CHECK_EQUAL(TEST_FRAMES, test_process(in, TEST_FRAMES, out, ARRAY_SIZE(out)));
+}
+
+/**
+ * @brief An oversized block is refused without touching the history, the next block continues the stream.
+ */
+static void test_in_frames_max(void)
+{
+    uint32_t in[CODEC_RESAMPLER_IN_FRAMES_MAX + 1];
+    uint32_t out[CODEC_RESAMPLER_IN_FRAMES_MAX + 2];
+    size_t   out_frames = 0;
+
+    codec_resampler_reset();
+
+    for (size_t i = 0; i < ARRAY_SIZE(in); i++)
+    {
+        in[i] = test_frame(1 + i);
+    }
+
+    TEST_CHECK_EQUAL(CODEC_RESAMPLER_IN_FRAMES_MAX,
+                     test_process(in, CODEC_RESAMPLER_IN_FRAMES_MAX, out, ARRAY_SIZE(out)));
+
+    TEST_CHECK_EQUAL(NRF_ERROR_INVALID_LENGTH,
+                     codec_resampler_process(in, ARRAY_SIZE(in), out, ARRAY_SIZE(out), &out_frames));
+    TEST_CHECK_EQUAL(0, out_frames);
+
+    in[0] = test_frame(1 + CODEC_RESAMPLER_IN_FRAMES_MAX);
+    TEST_CHECK_EQUAL(1, test_process(in, 1, out, ARRAY_SIZE(out)));
+    TEST_CHECK_EQUAL(test_frame(CODEC_RESAMPLER_IN_FRAMES_MAX - 1), out[0]);
+}
+
+int main(void)
+{
+    TEST_RUN(test_unity_step);
+    TEST_RUN(test_rate_control);
+    TEST_RUN(test_dc);
+    TEST_RUN(test_out_frames_max);
+    TEST_RUN(test_in_frames_max);
+
+    return TEST_EXIT_CODE();
+}
@@ -0,0 +1,150 @@
+/**
+ * @file        test_profile.c
+ * @author      Danius Kalvaitis (danius.kalvaitis@gmail.com)
+ * @brief       Host unit tests of the profiling probe statistics.
+ * @version     0.1
+ * @date        2026-10-17
+ *
+ * @copyright   Copyright (c) Danius Kalvaitis 2026 All rights reserved
+ *
+ */
+
+#include "profile.h"
+#include "test.h"
+
+#define TEST_PROBE PROFILE_PROBE_I2S_HANDLER
+
+static void test_record(uint32_t cycles, uint32_t count)
+{
+    for (uint32_t i = 0; i < count; i++)
+    {
+        profile_record(TEST_PROBE, cycles);
+    }
+}
+
+static void test_empty(void)
+{
+    profile_stats_t stats;
+
+    profile_init();
+    profile_stats_get(TEST_PROBE, &stats);
+
+    TEST_CHECK_EQUAL(0, stats.count);
+    TEST_CHECK_EQUAL(0, stats.min);
+    TEST_CHECK_EQUAL(0, stats.p99);
+}
+
+/**
+ * @brief Values below 4 have a bin each.
+ */
+static void test_small_values(void)
+{
+    profile_stats_t stats;
+
+    profile_reset();
+    test_record(0, 50);
+    test_record(2, 49);
+    test_record(3, 1);
+    profile_stats_get(TEST_PROBE, &stats);
+
+    TEST_CHECK_EQUAL(2, stats.p99);
+    TEST_CHECK_EQUAL(3, stats.max);
+    TEST_CHECK_EQUAL(0, stats.min);
+}
+
+/**
+ * @brief One outlier in a hundred does not move p99, it is the upper edge of the bin holding 100.
+ */
+static void test_outlier(void)
+{
+    profile_stats_t stats;
+
+    profile_reset();
+    test_record(100, 99);
+    test_record(100000, 1);
+    profile_stats_get(TEST_PROBE, &stats);
+
+    TEST_CHECK_EQUAL(100, stats.count);
+    TEST_CHECK_EQUAL(100, stats.min);
+    TEST_CHECK_EQUAL(1099, stats.avg);
+    TEST_CHECK_EQUAL(100000, stats.max);
+    TEST_CHECK_EQUAL(111, stats.p99); // Bin 96..111
+
+    test_record(100000, 1);
+    profile_stats_get(TEST_PROBE, &stats);
+    TEST_CHECK_EQUAL(100000, stats.p99); // Two in 101 are more than one percent
+}
+
+/**
+ * @brief Each octave is split in 4 bins, p99 follows the bin edges.
+ */
+static void test_bin_edges(void)
+{
+    static const uint32_t edges[][2] = {
+      {4, 4},
+      {5, 5},
+      {8, 9},
+      {15, 15},
+      {16, 19},
+      {1000, 1023},
+      {1024, 1279},
+      {65535, 65535},
+    };
+
+    for (size_t i = 0; i < sizeof(edges) / sizeof(edges[0]); i++)
+    {
+        profile_stats_t stats;
+
+        profile_reset();
+        test_record(edges[i][0], 1);
+        test_record(UINT32_MAX, 1); // Max above the edge, so p99 is the edge itself
+        test_record(edges[i][0], 98);
+        profile_stats_get(TEST_PROBE, &stats);
+
+        TEST_CHECK_EQUAL(edges[i][1], stats.p99);
+    }
+}
+
+/**
+ * @brief Everything past 2^17 cycles shares the top bin, its p99 is the max seen.
+ */
+static void test_top_bin(void)
+{
+    profile_stats_t stats;
+
+    profile_reset();
+    test_record(1000000, 100);
+    profile_stats_get(TEST_PROBE, &stats);
+
+    TEST_CHECK_EQUAL(1000000, stats.p99);
+
+    test_record(100, 100);
+    profile_stats_get(TEST_PROBE, &stats);
+    TEST_CHECK_EQUAL(1000000, stats.p99);
+}
+
+static void test_invalid_probe(void)
+{
+    profile_stats_t stats;
+
+    profile_reset();
+    profile_record(PROFILE_PROBE_COUNT, 100);
+
+    for (uint32_t probe = 0; probe < PROFILE_PROBE_COUNT; probe++)
+    {
+        profile_stats_get((profile_probe_t)probe, &stats);
+        TEST_CHECK_EQUAL(0, stats.count);
+    }
+}
+
+int main(void)
+{
+    TEST_RUN(test_empty);
+    TEST_RUN(test_small_values);
+    TEST_RUN(test_outlier);
+    TEST_RUN(test_bin_edges);
+    TEST_RUN(test_top_bin);
+    TEST_RUN(test_invalid_probe);
+
+    return TEST_EXIT_CODE();
+}
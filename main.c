@@ -3,6 +3,7 @@
 #include <stdint.h>
 #include <string.h>
 
+#include "amp.h"
 #include "app_error.h"
 #include "app_scheduler.h"
 #include "app_timer.h"
@@ -24,6 +25,7 @@
 #include "fds.h"
 #include "nordic_common.h"
 #include "nrf.h"
+#include "nrf_atomic.h"
 #include "nrf_ble_gatt.h"
 #include "nrf_bootloader_info.h"
 #include "nrf_delay.h"
@@ -40,8 +42,10 @@
 #include "nrf_svci_async_handler.h"
 #include "nrfx_gpiote.h"
 #include "peer_manager.h"
+#include "profile.h"
 #include "sh1106.h"
 #include "splash.h"
+#include "telemetry.h"
 #include "usb.h"
 
 #define DEAD_BEEF                                                                                                      \
@@ -52,15 +56,29 @@
 #endif
 
 #define SCHED_EVENT_DATA_SIZE 32
-#define SCHED_QUEUE_SIZE      16
 
-#define TWI_MNGR_QUEUE_SIZE   24
+/**
+ * @brief Scheduler queue depth, sized for every source having its events pending at once.
+ *
+ * - 4 single shot app_timer timers and the connection parameters timer, each expires into the queue at most once.
+ * - 2 SoftDevice event polls. One is put per SoftDevice interrupt, the first one run drains all pending events.
+ * - 7 one shot events: boot step, two codec ring power updates, codec ready, both register flush slots, ramp done.
+ * - 1 amplifier fault.
+ * - 8 USB control events. A stream start is a burst of alternate setting, sample rate, mute and per channel volume
+ *   requests, a volume slider keeps sending while a long scheduler handler runs. Any excess is counted and dropped.
+ */
+#define SCHED_QUEUE_USB_EVENTS 8
+#define SCHED_QUEUE_SIZE       (5 + 2 + 7 + 1 + SCHED_QUEUE_USB_EVENTS)
+
+#define TWI_MNGR_QUEUE_SIZE    24
+
+STATIC_ASSERT(sizeof(usb_event_t) <= SCHED_EVENT_DATA_SIZE, "USB events must fit into the scheduler queue");
 
 NRF_BLE_GATT_DEF(m_gatt);           /**< GATT module instance. */
 BLE_ADVERTISING_DEF(m_advertising); /**< Advertising module instance. */
 
 APP_TIMER_DEF(m_amplifier_mute_timer);
-#define AMPLIFIER_MUTE_TICKS APP_TIMER_TICKS(250)
+#define AMPLIFIER_MUTE_TICKS APP_TIMER_TICKS(10)
 
 DK_TWI_MNGR_DEF(m_twi_mngr_codec, TWI_MNGR_QUEUE_SIZE, DK_BSP_TLV320_I2C_INTERFACE);
 
@@ -70,7 +88,53 @@ SH1106_DEF(m_display, &m_spi, DK_BSP_OLED_RST, DK_BSP_OLED_CS, DK_BSP_OLED_DC, 1
 
 static uint16_t m_conn_handle = BLE_CONN_HANDLE_INVALID; /**< Handle of the current connection. */
 
+/**
+ * @brief Boot steps run after the main loop has started, one per scheduler pass.
+ *
+ * USB is started before the main loop, so the host can enumerate the device while the codec is held in reset and the
+ * steps below run.
+ */
+typedef enum
+{
+    BOOT_STEP_DISPLAY,
+    BOOT_STEP_BLE,
+    BOOT_STEP_DONE
+} boot_step_t;
+
 static codec_mode_t m_codec_target_mode = CODEC_MODE_BYPASS;
+static bool         m_usb_connected;
+static boot_step_t  m_boot_step = BOOT_STEP_DISPLAY;
+static uint32_t     m_boot_start;        /**< RTC counter value when app_timer was started. */
+static uint32_t     m_usb_configured_ms; /**< Taken in the USBD interrupt, boot steps may hold up the scheduler. */
+
+static nrf_atomic_u32_t m_usb_events_dropped; /**< USB control events that found the scheduler queue full. */
+
+/**
+ * @brief Select the converter of the USB streaming alternate setting. Called from the USBD interrupt.
+ */
+static ret_code_t usb_format_set(uint8_t subframe_size)
+{
+    switch (subframe_size)
+    {
+        case 2:
+            return codec_set_format(CODEC_FORMAT_S16_STEREO);
+        case 3:
+            return codec_set_format(CODEC_FORMAT_S24_STEREO);
+        case 4:
+            return codec_set_format(CODEC_FORMAT_S32_STEREO);
+        default:
+            return NRF_ERROR_NOT_SUPPORTED;
+    }
+}
+
+static usb_rx_handlers_t const m_usb_rx_handlers = {
+  .buffer_get                = codec_get_rx_buffer,
+  .buffer_release            = codec_release_rx_buffer,
+  .buffer_cancel             = codec_cancel_rx_buffer,
+  .buffer_release_unfinished = codec_release_unfinished_rx_buffer,
+  .feedback_get              = codec_feedback_get,
+  .format_set                = usb_format_set,
+};
 
 /**@brief Function for putting the chip into sleep mode.
  *
@@ -647,51 +711,88 @@ static void log_init(void)
     NRF_LOG_DEFAULT_BACKENDS_INIT();
 }
 
-static void codec_dbg(void *p_event_data, uint16_t event_size) { codec_debug(); }
+static void codec_dbg(void *p_event_data, uint16_t event_size)
+{
+    codec_debug();
+    usb_debug();
+    amp_debug();
+    telemetry_debug();
+    PROFILE_DUMP();
+}
 
 #endif // DEBUG
 
-static void usb_event_handler(usb_event_t *p_event)
+static uint32_t boot_elapsed_ms(void)
+{
+    uint32_t ticks = app_timer_cnt_diff_compute(app_timer_cnt_get(), m_boot_start);
+
+    return (uint32_t)(((uint64_t)ticks * 1000 * (APP_TIMER_CONFIG_RTC_FREQUENCY + 1)) / APP_TIMER_CLOCK_FREQ);
+}
+
+/**
+ * @brief Power the codec ring down once USB is gone and queued audio has played out. Only bypass audio is left then.
+ */
+static void codec_ring_power_update(void *p_event_data, uint16_t event_size)
 {
     ret_code_t err_code;
 
+    if (m_usb_connected)
+    {
+        return;
+    }
+
+    err_code = codec_ring_power_set(false);
+
+    if (err_code == NRF_ERROR_BUSY)
+    {
+        return; // Retried once the audio stream stops
+    }
+
+    APP_ERROR_CHECK(err_code);
+}
+
+/**
+ * @brief Handle USB control events. Runs from the scheduler, these may take time and talk to the codec over TWI.
+ */
+static void usb_control_event_handler(void *p_event_data, uint16_t event_size)
+{
+    ret_code_t         err_code;
+    usb_event_t const *p_event = p_event_data;
+    uint32_t           dropped = nrf_atomic_u32_fetch_store(&m_usb_events_dropped, 0);
+
+    if (dropped > 0)
+    {
+        NRF_LOG_WARNING("%u USB events dropped, scheduler queue full", dropped);
+    }
+
     switch (p_event->evt_type)
     {
         case USB_EVENT_USB_CONNECTED:
-            NRF_LOG_INFO("USB_EVENT_USB_CONNECTED");
-            nrf_gpio_pin_clear(DK_BSP_TPA3220_MUTE);
+            NRF_LOG_INFO("USB_EVENT_USB_CONNECTED %u ms after boot", boot_elapsed_ms());
+            m_usb_connected = true;
+
+            err_code = codec_ring_power_set(true);
+            APP_ERROR_CHECK(err_code);
+
+            amp_mute(true);
             m_codec_target_mode = CODEC_MODE_I2S;
             app_timer_start(m_amplifier_mute_timer, AMPLIFIER_MUTE_TICKS, NULL);
 
+            break;
+        case USB_EVENT_USB_CONFIGURED:
+            NRF_LOG_INFO("USB_EVENT_USB_CONFIGURED %u ms after boot", m_usb_configured_ms);
             break;
         case USB_EVENT_USB_REMOVED:
             NRF_LOG_INFO("USB_EVENT_USB_REMOVED");
-            nrf_gpio_pin_clear(DK_BSP_TPA3220_MUTE);
+            amp_mute(true);
             m_codec_target_mode = CODEC_MODE_BYPASS;
             app_timer_start(m_amplifier_mute_timer, AMPLIFIER_MUTE_TICKS, NULL);
-            break;
-        case USB_EVENT_TYPE_RX_BUFFER_REQUEST:
-            {
-                void *p_buffer = codec_get_rx_buffer(p_event->params.size);
 
-                if (p_buffer != NULL)
-                {
-                    usb_rx_buffer_reply(p_buffer, p_event->params.size);
-                } else
-                {
-                    NRF_LOG_ERROR("Could not allocate audio rx buffer");
-                    APP_ERROR_CHECK(NRF_ERROR_NO_MEM);
-                }
-            }
-            break;
-        case USB_EVENT_TYPE_RX_DONE:
-            err_code = codec_release_rx_buffer(p_event->params.size);
-            APP_ERROR_CHECK(err_code);
+            m_usb_connected = false;
+            codec_ring_power_update(NULL, 0);
             break;
         case USB_EVENT_TYPE_RX_TIMEOUT:
             NRF_LOG_INFO("USB rx timeout");
-            err_code = codec_release_unfinished_rx_buffer();
-            APP_ERROR_CHECK(err_code);
             break;
         case USB_EVENT_TYPE_MUTE_SET:
             {
@@ -702,116 +803,107 @@ static void usb_event_handler(usb_event_t *p_event)
                 APP_ERROR_CHECK(err_code);
             }
             break;
+        case USB_EVENT_TYPE_SAMPLE_RATE_SET:
+            NRF_LOG_INFO("Usb sample rate %u", p_event->params.sample_rate);
+
+            err_code = codec_set_sample_rate(p_event->params.sample_rate);
+
+            if (err_code != NRF_SUCCESS)
+            {
+                NRF_LOG_ERROR("Could not set sample rate");
+            }
+            break;
+        case USB_EVENT_TYPE_VOLUME_SET:
+            NRF_LOG_INFO("Usb volume %d", p_event->params.volume);
+
+            err_code = codec_set_volume(p_event->params.volume);
+
+            if (err_code != NRF_SUCCESS)
+            {
+                NRF_LOG_ERROR("Could not set volume");
+            }
+            break;
         default:
             break;
     }
 }
 
+/**
+ * @brief Handle USB events. Called from the USBD interrupt, or from the scheduler on connect and remove. Audio data
+ *        does not pass through here.
+ */
+static void usb_event_handler(usb_event_t *p_event)
+{
+    if (p_event->evt_type == USB_EVENT_USB_CONFIGURED)
+    {
+        m_usb_configured_ms = boot_elapsed_ms();
+    }
+
+    if (app_sched_event_put(p_event, sizeof(usb_event_t), usb_control_event_handler) != NRF_SUCCESS)
+    {
+        UNUSED_RETURN_VALUE(nrf_atomic_u32_add(&m_usb_events_dropped, 1)); // Reported by the next handled event
+    }
+}
+
 static void codec_event_handler(codec_evt_type_t event_type)
 {
     switch (event_type)
     {
+        case CODEC_EVT_TYPE_READY:
+            NRF_LOG_INFO("Codec ready %u ms after boot", boot_elapsed_ms());
+
+            if (!m_usb_connected)
+            {
+                amp_mute(false); // Codec starts in bypass, USB connect unmutes once I2S mode is ready
+            }
+            break;
         case CODEC_EVT_TYPE_BYPASS_MODE_READY:
             NRF_LOG_INFO("Codec bypass mode ready");
-            nrf_gpio_pin_set(DK_BSP_TPA3220_MUTE);
+            amp_mute(false);
             break;
         case CODEC_EVT_TYPE_I2S_MODE_READY:
             NRF_LOG_INFO("Codec I2S mode ready");
-            nrf_gpio_pin_set(DK_BSP_TPA3220_MUTE);
+            amp_mute(false);
+            break;
+        case CODEC_EVT_TYPE_MODE_TIMEOUT:
+            NRF_LOG_ERROR("Codec mode switch timeout, amplifier stays muted");
             break;
         case CODEC_EVT_TYPE_AUDIO_STREAM_STARTED:
             NRF_LOG_INFO("Codec audio stream started");
             break;
         case CODEC_EVT_TYPE_AUDIO_STREAM_STOPPED:
             NRF_LOG_INFO("Codec audio stream stopped");
+            UNUSED_RETURN_VALUE(app_sched_event_put(NULL, 0, codec_ring_power_update));
             break;
         default:
             break;
     }
 }
 
-void amplifier_mute_timeout(void *p_context)
+static void amp_event_handler(amp_evt_t const *p_evt)
 {
-    ret_code_t err_code = codec_set_mode(m_codec_target_mode);
-    APP_ERROR_CHECK(err_code);
+    switch (p_evt->type)
+    {
+        case AMP_EVT_TYPE_CLIP:
+            codec_clip_set(p_evt->params.clipping);
+            break;
+        case AMP_EVT_TYPE_FAULT:
+            codec_output_hold(true);
+            break;
+        case AMP_EVT_TYPE_RECOVERED:
+            codec_output_hold(false);
+            break;
+        case AMP_EVT_TYPE_RECOVERY_FAILED:
+            NRF_LOG_ERROR("Amplifier recovery failed");
+            break;
+        default:
+            break;
+    }
 }
 
-/**@brief Function for application main entry.
- */
-int main(void)
+static void ble_init(void)
 {
-#ifdef DFU_ENABLED
-    bootloader_async_svci_init(); // Initialize the async SVCI interface to bootloader before any interrupts are
-                                  // enabled.
-#endif
-
     ret_code_t err_code;
-    // bool erase_bonds = false;
-
-#ifdef DEBUG
-    log_init();
-#endif
-
-    NRF_LOG_DEBUG("Log initialised.");
-    NRF_LOG_PROCESS();
-
-    err_code = app_timer_init();
-    APP_ERROR_CHECK(err_code);
-
-    err_code = app_timer_create(&m_amplifier_mute_timer, APP_TIMER_MODE_SINGLE_SHOT, amplifier_mute_timeout);
-    APP_ERROR_CHECK(err_code);
-
-    nrf_gpio_cfg_output(DK_BSP_TPA3220_RST);
-    nrf_gpio_pin_clear(DK_BSP_TPA3220_RST);
-    nrf_gpio_cfg(DK_BSP_TPA3220_MUTE,
-                 NRF_GPIO_PIN_DIR_OUTPUT,
-                 NRF_GPIO_PIN_INPUT_DISCONNECT,
-                 NRF_GPIO_PIN_NOPULL,
-                 NRF_GPIO_PIN_S0D1,
-                 NRF_GPIO_PIN_NOSENSE);
-    nrf_gpio_pin_clear(DK_BSP_TPA3220_MUTE);
-    nrf_gpio_cfg_output(DK_BSP_TPA3220_HEAD);
-    nrf_gpio_pin_clear(DK_BSP_TPA3220_HEAD);
-
-    nrf_gpio_cfg_input(DK_BSP_TPA3220_FAULT, NRF_GPIO_PIN_NOPULL);
-    nrf_gpio_cfg_input(DK_BSP_TPA3220_OTW_CLIP, NRF_GPIO_PIN_NOPULL);
-
-    nrf_gpio_pin_set(DK_BSP_TPA3220_RST);
-
-    // nrf_gpio_pin_set(DK_BSP_TPA3220_RST);
-    // nrf_gpio_pin_set(DK_BSP_TPA3220_MUTE);
-    // while(true)
-    // {
-    // 	nrf_delay_ms(10000);
-    // }
-
-    nrfx_spi_config_t spi_config = NRFX_SPI_DEFAULT_CONFIG;
-    spi_config.mosi_pin          = DK_BSP_OLED_MOSI;
-    spi_config.sck_pin           = DK_BSP_OLED_SCLK;
-    err_code                     = nrfx_spi_init(&m_spi, &spi_config, NULL, NULL);
-    APP_ERROR_CHECK(err_code);
-
-    err_code = nrfx_gpiote_init();
-    APP_ERROR_CHECK(err_code);
-
-    err_code = twi_mngr_init(&m_twi_mngr_codec, DK_BSP_I2C_SCL0, DK_BSP_I2C_SDA0);
-    APP_ERROR_CHECK(err_code);
-
-    err_code = codec_init(&m_twi_mngr_codec, codec_event_handler);
-    APP_ERROR_CHECK(err_code);
-
-    err_code = usb_init(usb_event_handler);
-    APP_ERROR_CHECK(err_code);
-
-    APP_SCHED_INIT(SCHED_EVENT_DATA_SIZE, SCHED_QUEUE_SIZE);
-
-    err_code = nrf_pwr_mgmt_init();
-    APP_ERROR_CHECK(err_code);
-
-#ifdef DEBUG
-    NRF_LOG_FLUSH();
-    nrf_delay_ms(100);
-#endif
 
     ble_stack_init();
 
@@ -837,77 +929,129 @@ int main(void)
 
     services_init();
     conn_params_init();
+}
+
+static void display_init(void)
+{
+    ret_code_t        err_code;
+    nrfx_spi_config_t spi_config = NRFX_SPI_DEFAULT_CONFIG;
+
+    spi_config.mosi_pin = DK_BSP_OLED_MOSI;
+    spi_config.sck_pin  = DK_BSP_OLED_SCLK;
+
+    err_code = nrfx_spi_init(&m_spi, &spi_config, NULL, NULL);
+    APP_ERROR_CHECK(err_code);
 
     err_code = sh1106_init(&m_display);
     APP_ERROR_CHECK(err_code);
 
     sh1106_write_data(&m_display, splash_image, sizeof(splash_image));
+}
+
+/**
+ * @brief Run the next boot step. Scheduled again after each step, so USB and codec events get handled in between.
+ */
+static void boot_step_handler(void *p_event_data, uint16_t event_size)
+{
+    ret_code_t err_code;
+
+    switch (m_boot_step)
+    {
+        case BOOT_STEP_DISPLAY:
+            display_init();
+            break;
+        case BOOT_STEP_BLE:
+            ble_init();
+            break;
+        default:
+            return;
+    }
+
+    NRF_LOG_INFO("Boot step %u done at %u ms", m_boot_step, boot_elapsed_ms());
+
+    m_boot_step++;
+
+    err_code = app_sched_event_put(NULL, 0, boot_step_handler);
+    APP_ERROR_CHECK(err_code);
+}
+
+void amplifier_mute_timeout(void *p_context)
+{
+    ret_code_t err_code = codec_set_mode(m_codec_target_mode);
+    APP_ERROR_CHECK(err_code);
+}
+
+/**@brief Function for application main entry.
+ */
+int main(void)
+{
+#ifdef DFU_ENABLED
+    bootloader_async_svci_init(); // Initialize the async SVCI interface to bootloader before any interrupts are
+                                  // enabled.
+#endif
+
+    ret_code_t err_code;
+    // bool erase_bonds = false;
 
-    NRF_LOG_INFO("Here");
 #ifdef DEBUG
-    NRF_LOG_FLUSH();
+    log_init();
 #endif
-    nrf_gpio_pin_set(DK_BSP_TPA3220_MUTE);
-    nrf_delay_ms(250);
-    // advertising_start(erase_bonds);
 
-    // Enter main loop.
-    for (;;)
-    {
-        while (usb_event_queue_process())
-        {
-            app_sched_execute();
-            NRF_LOG_PROCESS();
-        }
+    NRF_LOG_DEBUG("Log initialised.");
+    NRF_LOG_PROCESS();
 
-        app_sched_execute();
+    APP_SCHED_INIT(SCHED_EVENT_DATA_SIZE, SCHED_QUEUE_SIZE); // USB and SoftDevice events are scheduled from the start
 
-        if (NRF_LOG_PROCESS() == false)
-        {
-            nrf_pwr_mgmt_run();
-        }
-    }
+    profile_cycle_counter_init();
+    telemetry_init();
+    PROFILE_INIT();
 
-    err_code = sd_power_dcdc0_mode_set(NRF_POWER_DCDC_ENABLE);
+    err_code = app_timer_init();
     APP_ERROR_CHECK(err_code);
 
-    peer_manager_init();
+    m_boot_start = app_timer_cnt_get();
 
-    err_code = dk_ble_gap_init();
+    err_code = app_timer_create(&m_amplifier_mute_timer, APP_TIMER_MODE_SINGLE_SHOT, amplifier_mute_timeout);
     APP_ERROR_CHECK(err_code);
 
-    gatt_init();
+    err_code = nrfx_gpiote_init();
+    APP_ERROR_CHECK(err_code);
 
-    err_code = dk_ble_advertising_init(&m_advertising, on_adv_evt);
+    err_code = amp_init(amp_event_handler);
     APP_ERROR_CHECK(err_code);
 
-    services_init();
-    conn_params_init();
+    err_code = twi_mngr_init(&m_twi_mngr_codec, DK_BSP_I2C_SCL0, DK_BSP_I2C_SDA0);
+    APP_ERROR_CHECK(err_code);
 
-    err_code = sh1106_init(&m_display);
+    // Holds the codec in reset and returns, the codec is configured from a timer
+    err_code = codec_init(&m_twi_mngr_codec, codec_event_handler);
     APP_ERROR_CHECK(err_code);
 
-    sh1106_write_data(&m_display, splash_image, sizeof(splash_image));
+    err_code = usb_init(usb_event_handler, &m_usb_rx_handlers);
+    APP_ERROR_CHECK(err_code);
+
+    // Ring stays off until USB connects, a connect event already queued powers it back on
+    err_code = app_sched_event_put(NULL, 0, codec_ring_power_update);
+    APP_ERROR_CHECK(err_code);
+
+    err_code = nrf_pwr_mgmt_init();
+    APP_ERROR_CHECK(err_code);
+
+    // Display and BLE are brought up from the main loop
+    err_code = app_sched_event_put(NULL, 0, boot_step_handler);
+    APP_ERROR_CHECK(err_code);
 
-    NRF_LOG_INFO("Here");
-#ifdef DEBUG
-    NRF_LOG_FLUSH();
-#endif
-    nrf_gpio_pin_set(DK_BSP_TPA3220_MUTE);
-    nrf_delay_ms(250);
     // advertising_start(erase_bonds);
 
     // Enter main loop.
     for (;;)
     {
-        while (usb_event_queue_process())
-        {
-            app_sched_execute();
-            NRF_LOG_PROCESS();
-        }
-
         app_sched_execute();
 
+#ifdef DEBUG
+        telemetry_rtt_process();
+#endif
+
         if (NRF_LOG_PROCESS() == false)
         {
             nrf_pwr_mgmt_run();
@@ -0,0 +1,259 @@
+#!/usr/bin/env python3
+"""
+Per module RAM and flash breakdown from a GNU ld map file.
+
+Usage: mem_report.py <map file> [--audio-budget BYTES] [--top N] [--ram-na-per-kb NA]
+
+Every input section placed in FLASH or RAM is charged to the object it came from. .data is charged to both. Objects
+matching AUDIO_MODULES form the audio group, the script exits with an error if its RAM use is over the budget.
+
+The bank model maps linker regions onto nRF52840 RAM sections. Sections holding nothing but GATED_SECTIONS are powered
+off while audio is idle, the saving is estimated from the System ON sleep current with full RAM retention (2.35 uA)
+and without (0.97 uA), about 5.4 nA per KB.
+"""
+
+import argparse
+import os
+import re
+import sys
+
+FLASH_START = 0x00000000
+FLASH_END   = 0x00100000
+RAM_START   = 0x20000000
+RAM_END     = 0x20040000
+
+# Objects holding audio buffers. The SDK build flattens object paths, so these match file names.
+AUDIO_MODULES = (
+    "codec",
+    "/usb.c.o",
+    "app_usbd_audio",
+)
+
+# Groups shown in the summary, first match wins.
+GROUPS = (
+    ("audio", AUDIO_MODULES),
+    ("log", ("nrf_log", "SEGGER_RTT")),
+    ("usbd", ("app_usbd", "nrfx_usbd", "nrf_drv_usbd")),
+    ("ble", ("ble_", "nrf_sdh", "peer_manager", "nrf_ble")),
+    ("libc", ("libc_nano", "libc.a", "libgcc", "libm", "libnosys")),
+    ("dsp", ("libarm_cortexM4lf_math",)),
+)
+
+# Output sections powered off while audio is idle
+GATED_SECTIONS = (".codec_ring",)
+
+RAM_SMALL_END     = 0x20010000 # RAM0..RAM7, two 4 KB sections each
+RAM_SMALL_SECTION = 0x1000
+RAM_LARGE_SECTION = 0x8000     # RAM8, six 32 KB sections
+
+SECTION_RE = re.compile(r"^ (\S+)\s+0x([0-9a-fA-F]+)\s+0x([0-9a-fA-F]+)\s+(\S.*)$")
+WRAPPED_RE = re.compile(r"^\s+0x([0-9a-fA-F]+)\s+0x([0-9a-fA-F]+)\s+(\S.*)$")
+OUTPUT_RE  = re.compile(r"^(\.\S+)\s+0x([0-9a-fA-F]+)\s+0x([0-9a-fA-F]+)")
+MEMORY_RE  = re.compile(r"^(\w+)\s+0x([0-9a-fA-F]+)\s+0x([0-9a-fA-F]+)")
+
+
+def region_get(address):
+    if FLASH_START <= address < FLASH_END:
+        return "flash"
+
+    if RAM_START <= address < RAM_END:
+        return "ram"
+
+    return None
+
+
+def ram_sections():
+    """Yield (name, start, size) of every nRF52840 RAM section."""
+    for address in range(RAM_START, RAM_SMALL_END, RAM_SMALL_SECTION):
+        offset = address - RAM_START
+        yield ("RAM%u.S%u" % (offset // 0x2000, (offset % 0x2000) // RAM_SMALL_SECTION), address, RAM_SMALL_SECTION)
+
+    for address in range(RAM_SMALL_END, RAM_END, RAM_LARGE_SECTION):
+        yield ("RAM8.S%u" % ((address - RAM_SMALL_END) // RAM_LARGE_SECTION), address, RAM_LARGE_SECTION)
+
+
+def module_name(path):
+    archive = re.match(r"(.*\.a)\((.*)\)$", path)
+
+    if archive:
+        return "%s(%s)" % (os.path.basename(archive.group(1)), archive.group(2))
+
+    return path
+
+
+def group_name(path):
+    for name, patterns in GROUPS:
+        if any(pattern in path for pattern in patterns):
+            return name
+
+    return "other"
+
+
+def map_parse(path):
+    """Return memory regions, output sections and a list of (output section, input section, address, size, object)."""
+    regions = {}
+    outputs = []
+    entries = []
+    output  = None
+    pending = None
+    stage   = None
+
+    with open(path, "r", errors="replace") as map_file:
+        for line in map_file:
+            line = line.rstrip("\n")
+
+            if line.startswith("Memory Configuration"):
+                stage = "memory"
+                continue
+
+            if line.startswith("Linker script and memory map"):
+                stage = "map"
+                continue
+
+            if stage == "memory":
+                match = MEMORY_RE.match(line)
+
+                if match and match.group(1) != "Name":
+                    regions[match.group(1)] = (int(match.group(2), 16), int(match.group(3), 16))
+                continue
+
+            if stage != "map":
+                continue
+
+            match = OUTPUT_RE.match(line)
+
+            if match:
+                output  = match.group(1)
+                pending = None
+                outputs.append((output, int(match.group(2), 16), int(match.group(3), 16)))
+                continue
+
+            if pending is not None: # Long input section names wrap to the next line
+                match = WRAPPED_RE.match(line)
+                pending_name = pending
+                pending      = None
+
+                if match:
+                    entries.append((output, pending_name, int(match.group(1), 16), int(match.group(2), 16),
+                                    match.group(3).strip()))
+                    continue
+
+            match = SECTION_RE.match(line)
+
+            if match:
+                if match.group(1) != "*fill*":
+                    entries.append((output, match.group(1), int(match.group(2), 16), int(match.group(3), 16),
+                                    match.group(4).strip()))
+                continue
+
+            if re.match(r"^ \.\S+$", line) or re.match(r"^ COMMON$", line):
+                pending = line.strip()
+
+    return regions, outputs, entries
+
+
+def bank_report(regions, outputs, na_per_kb):
+    """Print RAM section occupancy and the modelled saving of powering gated sections off."""
+    gated_kb = 0
+
+    # Anything in the SoftDevice area or the RAM region may be in use, heap and stack are not in the map
+    used = [("softdevice", RAM_START, regions["RAM"][0] - RAM_START), ("RAM", regions["RAM"][0], regions["RAM"][1])]
+    used += [(name, address, size) for name, address, size in outputs if size and region_get(address) == "ram"]
+
+    print("")
+    print("RAM sections")
+
+    for name, start, size in ram_sections():
+        occupants = sorted({owner for owner, address, length in used if address < start + size and
+                            address + length > start})
+
+        if not occupants:
+            state = "unused"
+        elif all(owner in GATED_SECTIONS for owner in occupants):
+            state = "gated"
+            gated_kb += size // 1024
+        else:
+            state = "on"
+
+        if state != "on":
+            print("  %-8s 0x%08x %3u KB  %-6s %s" % (name, start, size // 1024, state, " ".join(occupants)))
+
+    print("Gated while idle %u KB, saves about %.2f uA" % (gated_kb, gated_kb * na_per_kb / 1000.0))
+
+
+def report(map_path, audio_budget, top, na_per_kb):
+    regions, outputs, entries = map_parse(map_path)
+    modules                   = {}
+    groups                    = {}
+    sections                  = {}
+
+    for output, _, address, size, obj in entries:
+        if size == 0 or output is None:
+            continue
+
+        region = region_get(address)
+
+        if region is None:
+            continue
+
+        charges = [region]
+
+        if output == ".data":
+            charges.append("flash") # Initial values are copied from flash
+
+        name = module_name(obj)
+
+        for charge in charges:
+            modules.setdefault(name, {"flash": 0, "ram": 0})[charge] += size
+            groups.setdefault(group_name(obj), {"flash": 0, "ram": 0})[charge] += size
+
+        if region == "ram":
+            sections[output] = sections.get(output, 0) + size
+
+    if "RAM" in regions:
+        print("SoftDevice       flash %7u  ram %7u" % (regions.get("FLASH", (0, 0))[0], regions["RAM"][0] - RAM_START))
+
+    for name in sorted(groups, key=lambda group: -groups[group]["ram"]):
+        print("%-16s flash %7u  ram %7u" % (name, groups[name]["flash"], groups[name]["ram"]))
+
+    print("")
+    print("RAM by output section")
+
+    for name in sorted(sections, key=lambda section: -sections[section]):
+        print("  %-24s %7u" % (name, sections[name]))
+
+    print("")
+    print("Top %u modules by RAM" % top)
+
+    for name in sorted(modules, key=lambda module: -modules[module]["ram"])[:top]:
+        print("  %-60s flash %7u  ram %7u" % (name[-60:], modules[name]["flash"], modules[name]["ram"]))
+
+    if "RAM" in regions:
+        bank_report(regions, outputs, na_per_kb)
+
+    audio_ram = groups.get("audio", {"ram": 0})["ram"]
+
+    if audio_budget is not None:
+        print("")
+        print("Audio RAM %u of %u byte budget" % (audio_ram, audio_budget))
+
+        if audio_ram > audio_budget:
+            print("error: audio buffers are over budget by %u bytes" % (audio_ram - audio_budget), file=sys.stderr)
+            return 1
+
+    return 0
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__, formatter_class=argparse.RawDescriptionHelpFormatter)
+    parser.add_argument("map", help="GNU ld map file")
+    parser.add_argument("--audio-budget", type=int, default=None, help="fail if audio RAM exceeds this many bytes")
+    parser.add_argument("--top", type=int, default=20, help="modules to list")
+    parser.add_argument("--ram-na-per-kb", type=float, default=5.4, help="powered RAM current in nA per KB")
+    args = parser.parse_args()
+
+    return report(args.map, args.audio_budget, args.top, args.ram_na_per_kb)
+
+
+if __name__ == "__main__":
+    sys.exit(main())